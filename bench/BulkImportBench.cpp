@@ -0,0 +1,89 @@
+#include <DatabaseManager.hpp>
+#include <Models.hpp>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Compares the per-row addEmployee / addPerformanceReview loop against the batched bulk import API.
+// usage: bulk_import_bench [rows] [batchSize]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<PerfMgmt::Employee> makeEmployees(int count) {
+    std::vector<PerfMgmt::Employee> employees;
+    employees.reserve(count);
+    for (int id = 1; id <= count; ++id) {
+        std::optional<int> reportsTo = id == 1 ? std::nullopt : std::optional<int>((id - 2) / 8 + 1);
+        employees.emplace_back(id, 20250000 + id, "Employee " + std::to_string(id), "2020-01-01",
+                               id % 8 == 1 ? PerfMgmt::Role::MANAGER : PerfMgmt::Role::SPECIALIST, true, reportsTo);
+    }
+    return employees;
+}
+
+std::vector<PerfMgmt::PerformanceReview> makeReviews(int count) {
+    std::vector<PerfMgmt::PerformanceReview> reviews;
+    reviews.reserve(count);
+    for (int id = 1; id <= count; ++id) {
+        float rating = static_cast<float>(id % 10 + 1);
+        reviews.emplace_back(id, id, (id - 2) / 8 + 1, "2025-04-27", rating, rating, rating, rating, rating, rating,
+                             rating, rating, rating, rating, rating, "bench");
+    }
+    return reviews;
+}
+
+std::string freshDatabase(const std::string& name) {
+    std::filesystem::remove(name);
+    std::filesystem::remove(name + "-journal");
+    return name;
+}
+
+void report(const char* label, std::size_t rows, Clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%-28s %8zu rows %10.3f s %12.0f rows/s\n", label, rows, seconds, rows / seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rows = argc > 1 ? std::stoi(argv[1]) : 20000;
+    std::size_t batchSize = argc > 2 ? std::stoul(argv[2]) : PerfMgmt::DEFAULT_IMPORT_BATCH_SIZE;
+
+    auto employees = makeEmployees(rows);
+    auto reviews = makeReviews(rows);
+
+    {
+        PerfMgmt::DatabaseManager db(freshDatabase("bulk_import_loop.db"));
+        auto start = Clock::now();
+        for (const auto& employee : employees) {
+            db.addEmployee(employee);
+        }
+        report("addEmployee loop", employees.size(), Clock::now() - start);
+
+        start = Clock::now();
+        for (const auto& review : reviews) {
+            db.addPerformanceReview(review);
+        }
+        report("addPerformanceReview loop", reviews.size(), Clock::now() - start);
+    }
+    {
+        PerfMgmt::DatabaseManager db(freshDatabase("bulk_import_batched.db"));
+        auto start = Clock::now();
+        auto result = db.addEmployees(employees, batchSize);
+        report("addEmployees", result.inserted, Clock::now() - start);
+
+        start = Clock::now();
+        auto reviewResult = db.addPerformanceReviews(reviews, batchSize);
+        report("addPerformanceReviews", reviewResult.inserted, Clock::now() - start);
+
+        if (!result.errors.empty() || !reviewResult.errors.empty()) {
+            std::cerr << "rejected rows: " << result.errors.size() + reviewResult.errors.size() << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
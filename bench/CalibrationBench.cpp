@@ -0,0 +1,113 @@
+#include "SyntheticOrg.hpp"
+#include <CalibrationEngine.hpp>
+#include <KpiColumnStore.hpp>
+#include <RowArena.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Time of CalibrationEngine::compute on a synthetic org (bench/SyntheticOrg.hpp) decoded in memory, from
+// 1 thread up to maxThreads (the hardware threads by default), with the speedup over 1 thread. Every run's
+// org-wide and per-role rankings are checked against the single-threaded ones.
+// usage: calibration_bench [employees] [reviewsPerEmployee] [repetitions] [maxThreads]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// the org decoded into arenas, as DatabaseManager::scanAllEmployees / scanAllPerformanceReviews would
+void populate(const PerfMgmt::bench::SyntheticOrg& org, PerfMgmt::EmployeeArena& employees,
+              PerfMgmt::ReviewArena& reviews) {
+    employees.reserve(org.employees.size());
+    for (const PerfMgmt::Employee& employee : org.employees) {
+        PerfMgmt::EmployeeRow& row = employees.append();
+        row.employeeId = employee.employeeId;
+        row.personnelCode = employee.personnelCode;
+        row.reportsTo = employee.reportsTo;
+        row.name = employees.store(employee.name);
+        row.hireDay = PerfMgmt::toDayNumber(employee.hireDate).value_or(PerfMgmt::NO_DAY);
+        row.role = employee.role;
+        row.isActive = employee.isActive;
+    }
+    reviews.reserve(org.reviews.size());
+    for (const PerfMgmt::PerformanceReview& review : org.reviews) {
+        PerfMgmt::ReviewRow& row = reviews.append();
+        row.reviewId = review.reviewId;
+        row.employeeId = review.employeeId;
+        row.reviewerId = review.reviewerId;
+        row.reviewDay = PerfMgmt::toDayNumber(review.reviewDate).value_or(PerfMgmt::NO_DAY);
+        row.overallRating = review.overallRating;
+        for (std::size_t kpi = 0; kpi < PerfMgmt::KPI_COUNT; ++kpi) {
+            row.kpis[kpi] = PerfMgmt::kpiValue(review, static_cast<PerfMgmt::Kpi>(kpi));
+        }
+        if (review.comments) {
+            row.comments = reviews.intern(*review.comments);
+        }
+    }
+}
+
+bool sameRankings(const PerfMgmt::CalibrationEngine& a, const PerfMgmt::CalibrationEngine& b) {
+    for (std::size_t kpi = 0; kpi < PerfMgmt::KPI_COUNT; ++kpi) {
+        auto metric = static_cast<PerfMgmt::Kpi>(kpi);
+        if (a.ranking(metric, PerfMgmt::CalibrationScope::ORGANIZATION) !=
+            b.ranking(metric, PerfMgmt::CalibrationScope::ORGANIZATION)) {
+            return false;
+        }
+    }
+    for (std::size_t role = 0; role < PerfMgmt::ROLE_COUNT; ++role) {
+        auto scopeRole = static_cast<PerfMgmt::Role>(role);
+        if (a.overallRanking(PerfMgmt::CalibrationScope::ROLE, scopeRole) !=
+            b.overallRanking(PerfMgmt::CalibrationScope::ROLE, scopeRole)) {
+            return false;
+        }
+    }
+    return a.overallRanking(PerfMgmt::CalibrationScope::ORGANIZATION) ==
+           b.overallRanking(PerfMgmt::CalibrationScope::ORGANIZATION);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t employeeCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t reviewsPerEmployee = argc > 2 ? std::stoul(argv[2]) : 10;
+    int repetitions = argc > 3 ? std::stoi(argv[3]) : 5;
+    std::size_t maxThreads = argc > 4 ? std::stoul(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+
+    PerfMgmt::EmployeeArena employees;
+    PerfMgmt::ReviewArena reviews;
+    populate(PerfMgmt::bench::makeSyntheticOrg(employeeCount, PerfMgmt::bench::SYNTHETIC_ORG_DEPTH, reviewsPerEmployee),
+             employees, reviews);
+
+    PerfMgmt::CalibrationConfig config;
+    config.threads = 1;
+    PerfMgmt::CalibrationEngine reference(config);
+    reference.compute(employees, reviews);
+    std::printf("%zu reviews, %zu employees, %zu ranked\n", reviews.size(), employees.size(),
+                reference.rankedEmployees());
+
+    std::printf("%8s %12s %10s %10s\n", "threads", "best ms", "speedup", "rankings");
+    double singleThreaded = 0.0;
+    for (std::size_t threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        config.threads = threads;
+        PerfMgmt::CalibrationEngine engine(config);
+        double best = 0.0;
+        for (int repetition = 0; repetition < repetitions; ++repetition) {
+            auto start = Clock::now();
+            engine.compute(employees, reviews);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            best = repetition == 0 ? ms : std::min(best, ms);
+        }
+        if (threads == 1) {
+            singleThreaded = best;
+        }
+        std::printf("%8zu %12.1f %9.2fx %10s\n", threads, best, singleThreaded / best,
+                    sameRankings(engine, reference) ? "same" : "DIFFER");
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+    return 0;
+}
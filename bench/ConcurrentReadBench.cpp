@@ -0,0 +1,86 @@
+#include <DatabaseManager.hpp>
+#include <Models.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Multi-threaded getEmployee throughput: every thread sharing the single writer connection
+// against the pool mode with one WAL reader connection per thread.
+// usage: concurrent_read_bench [employees] [lookupsPerThread] [maxThreads]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string DB_NAME = "concurrent_read_bench.db";
+
+void populate(int employeeCount) {
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::filesystem::remove(DB_NAME + suffix);
+    }
+    PerfMgmt::DatabaseManager db(DB_NAME);
+    std::vector<PerfMgmt::Employee> employees;
+    employees.reserve(employeeCount);
+    for (int id = 1; id <= employeeCount; ++id) {
+        std::optional<int> reportsTo = id == 1 ? std::nullopt : std::optional<int>((id - 2) / 8 + 1);
+        employees.emplace_back(id, 20250000 + id, "Employee " + std::to_string(id), "2020-01-01",
+                               PerfMgmt::Role::SPECIALIST, true, reportsTo);
+    }
+    db.addEmployees(employees);
+}
+
+double run(PerfMgmt::DatabaseManager& db, int threadCount, int lookupsPerThread, int employeeCount) {
+    std::atomic<long> found{0};
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(t + 1);
+            std::uniform_int_distribution<int> ids(1, employeeCount);
+            long local = 0;
+            for (int i = 0; i < lookupsPerThread; ++i) {
+                local += db.getEmployee(ids(rng)).has_value();
+            }
+            found += local;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return found.load() / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int employeeCount = argc > 1 ? std::stoi(argv[1]) : 50000;
+    int lookupsPerThread = argc > 2 ? std::stoi(argv[2]) : 50000;
+    int maxThreads = argc > 3 ? std::stoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+
+    populate(employeeCount);
+
+    std::printf("%8s %18s %18s\n", "threads", "single lookups/s", "pooled lookups/s");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double single;
+        {
+            PerfMgmt::DatabaseManager db(DB_NAME);
+            single = run(db, threads, lookupsPerThread, employeeCount);
+        }
+        double pooled;
+        {
+            PerfMgmt::PoolConfig config;
+            config.readerCount = static_cast<std::size_t>(threads);
+            config.walMode = true;
+            PerfMgmt::DatabaseManager db(DB_NAME, config);
+            pooled = run(db, threads, lookupsPerThread, employeeCount);
+        }
+        std::printf("%8d %18.0f %18.0f\n", threads, single, pooled);
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <JsonStreamDecoder.hpp>
+#include <Models.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Decodes an employee list payload the way fetchAllEmployees used to (whole body, nlohmann DOM, from_json into a
+// temporary, copy into the vector) and with the streaming JsonRowDecoder, fed in receive-buffer sized chunks.
+// Reports time and peak heap use of each path.
+// usage: json_decode_bench [employees] [chunkSize] [repetitions]
+
+namespace {
+
+// heap accounting through the replaced global operator new / delete below
+std::atomic<std::size_t> liveBytes{0};
+std::atomic<std::size_t> peakBytes{0};
+// keeps the payload alignment of the blocks handed out
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* trackedAllocate(std::size_t size) {
+    auto* block = static_cast<unsigned char*>(std::malloc(size + HEADER_SIZE));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    std::size_t live = liveBytes.fetch_add(size) + size;
+    std::size_t peak = peakBytes.load();
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {
+    }
+    return block + HEADER_SIZE;
+}
+
+void trackedRelease(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(pointer) - HEADER_SIZE;
+    liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+using Clock = std::chrono::steady_clock;
+
+struct Run {
+    double seconds{0};
+    std::size_t peak{0};
+    std::size_t rows{0};
+};
+
+std::string makePayload(int count) {
+    json employees = json::array();
+    for (int id = 1; id <= count; ++id) {
+        std::optional<int> reportsTo = id == 1 ? std::nullopt : std::optional<int>((id - 2) / 8 + 1);
+        employees.push_back(PerfMgmt::Employee(id, 20250000 + id, "Employee " + std::to_string(id),
+                                               "2020-01-01T09:00:00Z",
+                                               id % 8 == 1 ? PerfMgmt::Role::MANAGER : PerfMgmt::Role::SPECIALIST,
+                                               true, reportsTo));
+    }
+    return employees.dump();
+}
+
+// previous fetchAllEmployees body: buffer, DOM, temporary, copy
+Run domDecode(const std::string& payload, std::size_t chunkSize) {
+    std::size_t baseline = liveBytes.load();
+    peakBytes = baseline;
+    auto start = Clock::now();
+    std::vector<PerfMgmt::Employee> resutlVec;
+    {
+        std::string body;
+        for (std::size_t pos = 0; pos < payload.size(); pos += chunkSize) {
+            body.append(payload.data() + pos, std::min(chunkSize, payload.size() - pos));
+        }
+        json j = json::parse(body);
+        for (const auto& jsonItem : j) {
+            PerfMgmt::Employee empTemp;
+            from_json(jsonItem, empTemp);
+            resutlVec.emplace_back(empTemp);
+        }
+    }
+    Run run{std::chrono::duration<double>(Clock::now() - start).count(), peakBytes.load() - baseline,
+            resutlVec.size()};
+    return run;
+}
+
+Run streamDecode(const std::string& payload, std::size_t chunkSize) {
+    std::size_t baseline = liveBytes.load();
+    peakBytes = baseline;
+    auto start = Clock::now();
+    std::vector<PerfMgmt::Employee> rows;
+    PerfMgmt::JsonRowDecoder<PerfMgmt::Employee> decoder(rows);
+    for (std::size_t pos = 0; pos < payload.size(); pos += chunkSize) {
+        decoder.feed(payload.data() + pos, std::min(chunkSize, payload.size() - pos));
+    }
+    if (!decoder.finish()) {
+        std::fprintf(stderr, "decode failed: %s\n", decoder.error().c_str());
+        std::exit(1);
+    }
+    Run run{std::chrono::duration<double>(Clock::now() - start).count(), peakBytes.load() - baseline, rows.size()};
+    return run;
+}
+
+void report(const char* label, const Run& run, std::size_t payloadBytes) {
+    std::printf("%-22s %8zu rows %9.3f s %10.0f rows/s %8.1f MB/s  peak heap %8.1f MB\n", label, run.rows,
+                run.seconds, run.rows / run.seconds, payloadBytes / run.seconds / 1e6, run.peak / 1e6);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return trackedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return trackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedRelease(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    trackedRelease(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    trackedRelease(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    trackedRelease(pointer);
+}
+
+int main(int argc, char** argv) {
+    int employees = argc > 1 ? std::stoi(argv[1]) : 100000;
+    // cpp-httplib hands the content receiver at most CPPHTTPLIB_RECV_BUFSIZ (4 KiB) per call
+    std::size_t chunkSize = argc > 2 ? std::stoul(argv[2]) : 4096;
+    int repetitions = argc > 3 ? std::stoi(argv[3]) : 3;
+
+    std::string payload = makePayload(employees);
+    std::printf("payload %.1f MB, %d employees, %zu byte chunks\n", payload.size() / 1e6, employees, chunkSize);
+
+    Run dom;
+    Run stream;
+    for (int i = 0; i < repetitions; ++i) {
+        Run domRun = domDecode(payload, chunkSize);
+        Run streamRun = streamDecode(payload, chunkSize);
+        if (i == 0 || domRun.seconds < dom.seconds) {
+            dom = domRun;
+        }
+        if (i == 0 || streamRun.seconds < stream.seconds) {
+            stream = streamRun;
+        }
+    }
+    report("nlohmann DOM", dom, payload.size());
+    report("JsonRowDecoder", stream, payload.size());
+    return dom.rows == stream.rows ? 0 : 1;
+}
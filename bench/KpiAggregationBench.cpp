@@ -0,0 +1,101 @@
+#include <KpiColumnStore.hpp>
+#include <Models.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Mean/min/max/stddev/histogram of every KPI: naive loop over std::vector<PerformanceReview>
+// against the vectorized kernels on KpiColumnStore, plus per-reviewer rollups.
+// usage: kpi_aggregation_bench [reviews] [reviewers] [repetitions]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+PerfMgmt::KpiStats naiveStats(const std::vector<PerfMgmt::PerformanceReview>& reviews, PerfMgmt::Kpi kpi) {
+    PerfMgmt::KpiStats stats;
+    double sum = 0.0;
+    double squares = 0.0;
+    stats.min = 10.0f;
+    stats.max = 0.0f;
+    for (const auto& review : reviews) {
+        float value = PerfMgmt::kpiValue(review, kpi);
+        sum += value;
+        squares += static_cast<double>(value) * value;
+        stats.min = std::min(stats.min, value);
+        stats.max = std::max(stats.max, value);
+        ++stats.histogram[std::clamp(static_cast<int>(value + 0.5f), 1, 10) - 1];
+    }
+    stats.count = reviews.size();
+    double mean = sum / reviews.size();
+    stats.mean = static_cast<float>(mean);
+    stats.stddev = static_cast<float>(std::sqrt(std::max(0.0, squares / reviews.size() - mean * mean)));
+    return stats;
+}
+
+double seconds(Clock::duration elapsed) {
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int reviewCount = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int reviewerCount = argc > 2 ? std::stoi(argv[2]) : 1000;
+    int repetitions = argc > 3 ? std::stoi(argv[3]) : 5;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> rating(1.0f, 10.0f);
+    std::uniform_int_distribution<int> reviewer(1, reviewerCount);
+    std::vector<PerfMgmt::PerformanceReview> reviews;
+    reviews.reserve(reviewCount);
+    for (int id = 1; id <= reviewCount; ++id) {
+        reviews.emplace_back(id, id, reviewer(rng), "2025-04-27", rating(rng), rating(rng), rating(rng), rating(rng),
+                             rating(rng), rating(rng), rating(rng), rating(rng), rating(rng), rating(rng),
+                             rating(rng), "bench comment that keeps the struct realistic");
+    }
+
+    PerfMgmt::KpiColumnStore store;
+    store.reserve(reviews.size());
+    for (const auto& review : reviews) {
+        store.append(review);
+    }
+
+    double checksum = 0.0;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (std::size_t kpi = 0; kpi < PerfMgmt::KPI_COUNT; ++kpi) {
+            checksum += naiveStats(reviews, static_cast<PerfMgmt::Kpi>(kpi)).mean;
+        }
+    }
+    double naive = seconds(Clock::now() - start) / repetitions;
+
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (std::size_t kpi = 0; kpi < PerfMgmt::KPI_COUNT; ++kpi) {
+            checksum += store.aggregate(static_cast<PerfMgmt::Kpi>(kpi)).mean;
+        }
+    }
+    double columnar = seconds(Clock::now() - start) / repetitions;
+
+    store.clusterByReviewer();
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (std::size_t kpi = 0; kpi < PerfMgmt::KPI_COUNT; ++kpi) {
+            checksum += store.rollup(static_cast<PerfMgmt::Kpi>(kpi)).size();
+        }
+    }
+    double rollup = seconds(Clock::now() - start) / repetitions;
+
+    std::printf("kernels: %s, %d reviews, all 10 KPIs per pass\n", PerfMgmt::kernels::instructionSet(), reviewCount);
+    std::printf("%-32s %10.3f ms\n", "naive AoS loop", naive * 1e3);
+    std::printf("%-32s %10.3f ms (%.1fx)\n", "column store", columnar * 1e3, naive / columnar);
+    std::printf("%-32s %10.3f ms (%zu groups)\n", "column store per-reviewer rollup", rollup * 1e3,
+                store.groups().size());
+    std::printf("checksum %.3f\n", checksum);
+    return 0;
+}
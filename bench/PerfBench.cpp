@@ -0,0 +1,420 @@
+#include "SyntheticOrg.hpp"
+#include <DatabaseManager.hpp>
+#include <JsonStreamDecoder.hpp>
+#include <KpiColumnStore.hpp>
+#include <Models.hpp>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <random>
+#include <sqlite3.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Google Benchmark suite over the DatabaseManager and JSON hot paths on synthetic orgs.
+// Track results across releases with the JSON reporter:
+//   perf_bench --benchmark_out=perf_bench.json --benchmark_out_format=json
+// or build the perf_bench_json target, which does the same in the build directory.
+
+namespace {
+
+// reporting depth of every generated org
+constexpr std::size_t ORG_DEPTH = PerfMgmt::bench::SYNTHETIC_ORG_DEPTH;
+// org sizes the read benchmarks are run against
+constexpr int SMALL_ORG = 1000;
+constexpr int LARGE_ORG = 50000;
+
+std::string databasePath(const std::string& name) {
+    auto path = (std::filesystem::temp_directory_path() / ("perf_bench_" + name + ".db")).string();
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::filesystem::remove(path + suffix);
+    }
+    return path;
+}
+
+// one populated database per org size, shared by all read benchmarks
+struct PopulatedOrg {
+    PerfMgmt::bench::SyntheticOrg org;
+    std::unique_ptr<PerfMgmt::DatabaseManager> db;
+};
+
+PopulatedOrg& populatedOrg(int employees) {
+    static std::map<int, PopulatedOrg> orgs;
+    auto found = orgs.find(employees);
+    if (found != orgs.end()) {
+        return found->second;
+    }
+    PopulatedOrg& entry = orgs[employees];
+    entry.org = PerfMgmt::bench::makeSyntheticOrg(employees, ORG_DEPTH, 2);
+    entry.db = std::make_unique<PerfMgmt::DatabaseManager>(databasePath("read_" + std::to_string(employees)));
+    entry.db->addEmployees(entry.org.employees);
+    entry.db->addPerformanceReviews(entry.org.reviews);
+    return entry;
+}
+
+// fresh database per benchmark run for the write paths
+class EmptyDatabase : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State&) override {
+        db = std::make_unique<PerfMgmt::DatabaseManager>(databasePath("write"));
+    }
+    void TearDown(const benchmark::State&) override { db.reset(); }
+
+protected:
+    std::unique_ptr<PerfMgmt::DatabaseManager> db;
+};
+
+// ---- writes ----
+
+BENCHMARK_DEFINE_F(EmptyDatabase, AddEmployee)(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(1, 1);
+    PerfMgmt::Employee employee = org.employees.front();
+    int id = 0;
+    for (auto _ : state) {
+        employee.employeeId = ++id;
+        benchmark::DoNotOptimize(db->addEmployee(employee));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(EmptyDatabase, AddEmployee);
+
+BENCHMARK_DEFINE_F(EmptyDatabase, AddEmployeesBulk)(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(static_cast<std::size_t>(state.range(0)), ORG_DEPTH);
+    int offset = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (auto& employee : org.employees) {
+            employee.employeeId += offset;
+        }
+        offset = static_cast<int>(org.employees.size());
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(db->addEmployees(org.employees));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(EmptyDatabase, AddEmployeesBulk)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(EmptyDatabase, AddPerformanceReview)(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(2, 2);
+    PerfMgmt::PerformanceReview review = org.reviews.front();
+    // let sqlite assign the ids
+    review.reviewId = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->addPerformanceReview(review));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(EmptyDatabase, AddPerformanceReview);
+
+BENCHMARK_DEFINE_F(EmptyDatabase, AddPerformanceReviewsBulk)(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(static_cast<std::size_t>(state.range(0)) + 1, ORG_DEPTH);
+    for (auto& review : org.reviews) {
+        review.reviewId = 0;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->addPerformanceReviews(org.reviews));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(EmptyDatabase, AddPerformanceReviewsBulk)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// ---- reads ----
+
+void BM_GetEmployee(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> ids(1, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(populated.db->getEmployee(ids(rng)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetEmployee)->Arg(SMALL_ORG)->Arg(LARGE_ORG);
+
+void BM_GetAllEmployees(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(populated.db->getAllEmployees());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetAllEmployees)->Arg(SMALL_ORG)->Arg(LARGE_ORG)->Unit(benchmark::kMillisecond);
+
+void BM_StreamAllEmployees(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::size_t rows = 0;
+        populated.db->forEachEmployee([&rows](const PerfMgmt::Employee&) { ++rows; });
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StreamAllEmployees)->Arg(SMALL_ORG)->Arg(LARGE_ORG)->Unit(benchmark::kMillisecond);
+
+void BM_ScanAllEmployeesArena(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    PerfMgmt::EmployeeArena arena;
+    for (auto _ : state) {
+        populated.db->scanAllEmployees(arena);
+        benchmark::DoNotOptimize(arena.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScanAllEmployeesArena)->Arg(SMALL_ORG)->Arg(LARGE_ORG)->Unit(benchmark::kMillisecond);
+
+void BM_GetEmployeesReportingToHead(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    const auto& managers = populated.org.managerIds;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<std::size_t> pick(0, managers.size() - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(populated.db->getEmployeesReportingToHead(managers[pick(rng)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["fanout"] = static_cast<double>(populated.org.fanout);
+}
+BENCHMARK(BM_GetEmployeesReportingToHead)->Arg(SMALL_ORG)->Arg(LARGE_ORG);
+
+void BM_GetPerformanceReview(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> ids(1, static_cast<int>(populated.org.reviews.size()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(populated.db->getPerformanceReview(ids(rng)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetPerformanceReview)->Arg(SMALL_ORG)->Arg(LARGE_ORG);
+
+void BM_GetPerformanceForEmployee(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> ids(2, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(populated.db->getPerformanceForEmployee(ids(rng)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetPerformanceForEmployee)->Arg(SMALL_ORG)->Arg(LARGE_ORG);
+
+// a team screen of state.range(0) random members of the large org: each member and their latest review
+std::vector<int> randomTeam(std::mt19937& rng, std::size_t size) {
+    std::uniform_int_distribution<int> ids(2, LARGE_ORG);
+    std::vector<int> team(size);
+    std::generate(team.begin(), team.end(), [&] { return ids(rng); });
+    return team;
+}
+
+void BM_TeamScreenPerMember(benchmark::State& state) {
+    auto& populated = populatedOrg(LARGE_ORG);
+    std::mt19937 rng(1);
+    for (auto _ : state) {
+        for (int id : randomTeam(rng, static_cast<std::size_t>(state.range(0)))) {
+            benchmark::DoNotOptimize(populated.db->getEmployee(id));
+            benchmark::DoNotOptimize(populated.db->getPerformanceForEmployee(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TeamScreenPerMember)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+void BM_TeamScreenBatched(benchmark::State& state) {
+    auto& populated = populatedOrg(LARGE_ORG);
+    std::mt19937 rng(1);
+    for (auto _ : state) {
+        auto team = randomTeam(rng, static_cast<std::size_t>(state.range(0)));
+        benchmark::DoNotOptimize(populated.db->getEmployees(team));
+        benchmark::DoNotOptimize(populated.db->getLatestReviewsForEmployees(team));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TeamScreenBatched)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+// ---- derived views ----
+
+// an in-memory copy of the large org's employees brought up to date after state.range(0) employee updates,
+// by rescanning the table against reading back only the rows named by the change feed
+void updateEmployees(PopulatedOrg& populated, std::mt19937& rng, std::size_t count) {
+    std::uniform_int_distribution<std::size_t> index(0, populated.org.employees.size() - 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        populated.db->updateEmployee(populated.org.employees[index(rng)]);
+    }
+}
+
+void BM_EmployeeMirrorRescan(benchmark::State& state) {
+    auto& populated = populatedOrg(LARGE_ORG);
+    std::mt19937 rng(1);
+    PerfMgmt::EmployeeArena mirror;
+    for (auto _ : state) {
+        updateEmployees(populated, rng, static_cast<std::size_t>(state.range(0)));
+        populated.db->scanAllEmployees(mirror);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EmployeeMirrorRescan)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+void BM_EmployeeMirrorChangeFeed(benchmark::State& state) {
+    auto& populated = populatedOrg(LARGE_ORG);
+    if (!populated.db->changeFeed()) {
+        populated.db->enableChangeFeed();
+    }
+    std::mt19937 rng(1);
+    std::unordered_map<int, PerfMgmt::Employee> mirror;
+    populated.db->forEachEmployee([&](const PerfMgmt::Employee& employee) { mirror[employee.employeeId] = employee; });
+    auto subscription = populated.db->changeFeed()->subscribe();
+    std::vector<PerfMgmt::ChangeEvent> events;
+    std::vector<int> changed;
+    for (auto _ : state) {
+        updateEmployees(populated, rng, static_cast<std::size_t>(state.range(0)));
+        events.clear();
+        changed.clear();
+        subscription.poll(events);
+        for (const auto& event : events) {
+            changed.push_back(event.employeeId);
+        }
+        auto rows = populated.db->getEmployees(changed);
+        for (const auto& row : rows.value_or(std::vector<std::optional<PerfMgmt::Employee>>{})) {
+            if (row) {
+                mirror[row->employeeId] = *row;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EmployeeMirrorChangeFeed)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+// surname plus the first digits of the id, the way a directory lookup is typed
+void BM_SearchEmployeeName(benchmark::State& state) {
+    auto& populated = populatedOrg(static_cast<int>(state.range(0)));
+    if (populated.db->employeeNameIndex().size() == 0) {
+        populated.db->enableSearchIndex();
+    }
+    std::vector<std::string> queries;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<std::size_t> pick(0, populated.org.employees.size() - 1);
+    for (int i = 0; i < 256; ++i) {
+        const std::string& name = populated.org.employees[pick(rng)].name;
+        auto firstSpace = name.find(' ');
+        queries.push_back(name.substr(firstSpace + 1, name.size() - firstSpace - 2));
+    }
+    std::size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(populated.db->employeeNameIndex().search(queries[next++ % queries.size()], 10));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SearchEmployeeName)->Arg(SMALL_ORG)->Arg(LARGE_ORG)->Unit(benchmark::kMicrosecond);
+
+// ---- JSON ----
+
+void BM_EmployeeToJson(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(2, 2);
+    const auto& employee = org.employees.back();
+    for (auto _ : state) {
+        json j = employee;
+        benchmark::DoNotOptimize(j);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EmployeeToJson);
+
+void BM_EmployeeFromJson(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(2, 2);
+    json j = org.employees.back();
+    for (auto _ : state) {
+        PerfMgmt::Employee employee;
+        from_json(j, employee);
+        benchmark::DoNotOptimize(employee);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EmployeeFromJson);
+
+void BM_ReviewToJson(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(2, 2);
+    const auto& review = org.reviews.front();
+    for (auto _ : state) {
+        json j = review;
+        benchmark::DoNotOptimize(j);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReviewToJson);
+
+void BM_ReviewFromJson(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(2, 2);
+    json j = org.reviews.front();
+    for (auto _ : state) {
+        PerfMgmt::PerformanceReview review;
+        from_json(j, review);
+        benchmark::DoNotOptimize(review);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReviewFromJson);
+
+// list payload as served by GET /api/employees
+std::string employeeListPayload(int employees) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(static_cast<std::size_t>(employees), ORG_DEPTH);
+    return json(org.employees).dump();
+}
+
+void BM_DecodeEmployeeListDom(benchmark::State& state) {
+    std::string payload = employeeListPayload(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::vector<PerfMgmt::Employee> employees;
+        for (const auto& item : json::parse(payload)) {
+            PerfMgmt::Employee employee;
+            from_json(item, employee);
+            employees.push_back(std::move(employee));
+        }
+        benchmark::DoNotOptimize(employees);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(payload.size()));
+}
+BENCHMARK(BM_DecodeEmployeeListDom)->Arg(SMALL_ORG)->Arg(LARGE_ORG)->Unit(benchmark::kMillisecond);
+
+void BM_DecodeEmployeeListStream(benchmark::State& state) {
+    std::string payload = employeeListPayload(static_cast<int>(state.range(0)));
+    // receive-buffer sized pieces, as handed out by the httplib content receiver
+    constexpr std::size_t chunkSize = 4096;
+    for (auto _ : state) {
+        std::vector<PerfMgmt::Employee> employees;
+        PerfMgmt::JsonRowDecoder<PerfMgmt::Employee> decoder(employees);
+        for (std::size_t pos = 0; pos < payload.size(); pos += chunkSize) {
+            decoder.feed(payload.data() + pos, std::min(chunkSize, payload.size() - pos));
+        }
+        benchmark::DoNotOptimize(decoder.finish());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(payload.size()));
+}
+BENCHMARK(BM_DecodeEmployeeListStream)->Arg(SMALL_ORG)->Arg(LARGE_ORG)->Unit(benchmark::kMillisecond);
+
+void BM_EncodeEmployeeList(benchmark::State& state) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(static_cast<std::size_t>(state.range(0)), ORG_DEPTH);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json(org.employees).dump());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncodeEmployeeList)->Arg(SMALL_ORG)->Arg(LARGE_ORG)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    // recorded in the JSON context so results from different builds can be told apart
+    benchmark::AddCustomContext("sqlite_version", sqlite3_libversion());
+    benchmark::AddCustomContext("kpi_instruction_set", PerfMgmt::kernels::instructionSet());
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
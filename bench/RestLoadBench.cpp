@@ -0,0 +1,160 @@
+#include "SyntheticOrg.hpp"
+#include <DatabaseManager.hpp>
+#include <Models.hpp>
+#include <RestServer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <httplib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Local load generator for the embedded REST server: N keep-alive connections issue a mixed workload of employee
+// lookups, per-employee review lists and review submissions for a fixed duration against an in-process server
+// on a free port, then report requests/sec and p50/p99 latency per endpoint. The database holds a synthetic org
+// (bench/SyntheticOrg.hpp).
+// usage: rest_load_bench [employees] [connections] [seconds]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string DB_NAME = "rest_load_bench.db";
+
+enum Endpoint { GET_EMPLOYEE, LIST_REVIEWS, POST_REVIEW, ENDPOINT_COUNT };
+const char* const ENDPOINT_NAMES[ENDPOINT_COUNT] = {"GET /api/employees/:id", "GET /api/reviews?employeeId=",
+                                                    "POST /api/reviews"};
+
+// latencies in microseconds and failed requests of one connection, per endpoint
+struct Samples {
+    std::vector<long> latencies[ENDPOINT_COUNT];
+    long errors[ENDPOINT_COUNT]{};
+};
+
+// two reviews per employee; the org's reviews also pick the employees the requests are about
+PerfMgmt::bench::SyntheticOrg populate(std::size_t employeeCount) {
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::filesystem::remove(DB_NAME + suffix);
+    }
+    auto org = PerfMgmt::bench::makeSyntheticOrg(employeeCount, PerfMgmt::bench::SYNTHETIC_ORG_DEPTH, 2);
+    PerfMgmt::DatabaseManager db(DB_NAME);
+    db.InitializeDatabase();
+    db.addEmployees(org.employees);
+    db.addPerformanceReviews(org.reviews);
+    return org;
+}
+
+// another review like review, for sqlite to give the next id
+std::string reviewBody(const PerfMgmt::PerformanceReview& review) {
+    PerfMgmt::PerformanceReview submitted = review;
+    submitted.reviewId = 0;
+    return json(submitted).dump();
+}
+
+// 8 in 10 requests are lookups, 1 a review list and 1 a submission
+Samples drive(int port, const PerfMgmt::bench::SyntheticOrg& org, unsigned seed, Clock::time_point deadline) {
+    Samples samples;
+    httplib::Client client("127.0.0.1", port);
+    client.set_keep_alive(true);
+    for (unsigned i = seed; Clock::now() < deadline; ++i) {
+        const PerfMgmt::PerformanceReview& review = org.reviews[(i * 2654435761u) % org.reviews.size()];
+        int employeeId = review.employeeId;
+        Endpoint endpoint = i % 10 == 0 ? POST_REVIEW : i % 10 == 1 ? LIST_REVIEWS : GET_EMPLOYEE;
+        auto start = Clock::now();
+        httplib::Result result;
+        switch (endpoint) {
+        case GET_EMPLOYEE:
+            result = client.Get("/api/employees/" + std::to_string(employeeId));
+            break;
+        case LIST_REVIEWS:
+            result = client.Get("/api/reviews?employeeId=" + std::to_string(employeeId));
+            break;
+        default:
+            result = client.Post("/api/reviews", reviewBody(review), "application/json");
+            break;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        if (!result || result->status >= 300) {
+            ++samples.errors[endpoint];
+            continue;
+        }
+        samples.latencies[endpoint].push_back(elapsed);
+    }
+    return samples;
+}
+
+// exact percentile of latencies, reordering them
+long percentile(std::vector<long>& latencies, double p) {
+    if (latencies.empty()) {
+        return 0;
+    }
+    auto nth = latencies.begin() + static_cast<std::ptrdiff_t>(p * (latencies.size() - 1));
+    std::nth_element(latencies.begin(), nth, latencies.end());
+    return *nth;
+}
+
+void report(const char* name, std::vector<long>& latencies, long errors, double seconds) {
+    std::printf("%-30s %10zu %8ld %12.0f %10ld %10ld\n", name, latencies.size(), errors, latencies.size() / seconds,
+                percentile(latencies, 0.50), percentile(latencies, 0.99));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t employeeCount = argc > 1 ? std::stoul(argv[1]) : 10000;
+    int connections = argc > 2 ? std::stoi(argv[2]) : 16;
+    int durationSeconds = argc > 3 ? std::stoi(argv[3]) : 10;
+
+    auto org = populate(employeeCount);
+
+    PerfMgmt::RestServerConfig config;
+    config.port = 0;
+    PerfMgmt::PoolConfig poolConfig;
+    poolConfig.readerCount = config.workerCount;
+    poolConfig.walMode = true;
+    PerfMgmt::DatabaseManager db(DB_NAME, poolConfig);
+    db.enableWriteBehind();
+    PerfMgmt::RestServer server(db, config);
+    if (!server.bind()) {
+        return 1;
+    }
+    std::thread serving([&server] { server.listen(); });
+    server.waitUntilReady();
+
+    std::vector<Samples> perConnection(connections);
+    std::vector<std::thread> clients;
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::seconds(durationSeconds);
+    for (int c = 0; c < connections; ++c) {
+        clients.emplace_back([&, c] {
+            perConnection[c] = drive(server.port(), org, static_cast<unsigned>(c) * 7919u, deadline);
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    server.stop();
+    serving.join();
+
+    std::printf("%d connections, %zu server workers, %.1f s\n", connections, config.workerCount, seconds);
+    std::printf("%-30s %10s %8s %12s %10s %10s\n", "endpoint", "requests", "errors", "requests/s", "p50 us",
+                "p99 us");
+    std::vector<long> all;
+    long allErrors = 0;
+    for (int e = 0; e < ENDPOINT_COUNT; ++e) {
+        std::vector<long> latencies;
+        long errors = 0;
+        for (auto& samples : perConnection) {
+            latencies.insert(latencies.end(), samples.latencies[e].begin(), samples.latencies[e].end());
+            errors += samples.errors[e];
+        }
+        all.insert(all.end(), latencies.begin(), latencies.end());
+        allErrors += errors;
+        report(ENDPOINT_NAMES[e], latencies, errors, seconds);
+    }
+    report("total", all, allErrors, seconds);
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "SyntheticOrg.hpp"
+#include <DatabaseManager.hpp>
+#include <Models.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Review storage before and after archiving the closed years: size of the hot database file, time to list the
+// current quarter and the current year page by page through getReviewsInDateRange, and one employee's whole
+// review history, which reads every partition, on a synthetic org (bench/SyntheticOrg.hpp). Also prints how long
+// archiveReviewsBefore took.
+// usage: review_archive_bench [years] [reviewsPerYear] [repetitions]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string DB_NAME = "review_archive_bench.db";
+constexpr std::size_t EMPLOYEE_COUNT = 1000;
+// the open year; every year before it is closed
+constexpr int CURRENT_YEAR = 2025;
+
+void removeDatabase() {
+    for (const auto& entry : std::filesystem::directory_iterator(".")) {
+        if (entry.path().filename().string().rfind(DB_NAME, 0) == 0) {
+            std::filesystem::remove(entry.path());
+        }
+    }
+}
+
+// the org's employees, and reviewsPerYear reviews a year cycling through the org's reviews, redated into that year
+void populate(PerfMgmt::DatabaseManager& db, int years, int reviewsPerYear) {
+    auto org = PerfMgmt::bench::makeSyntheticOrg(EMPLOYEE_COUNT, PerfMgmt::bench::SYNTHETIC_ORG_DEPTH);
+    db.addEmployees(org.employees);
+
+    std::mt19937 random(7);
+    std::vector<PerfMgmt::PerformanceReview> reviews;
+    std::size_t next{0};
+    for (int year = CURRENT_YEAR - years + 1; year <= CURRENT_YEAR; ++year) {
+        reviews.clear();
+        for (int i = 0; i < reviewsPerYear; ++i) {
+            char date[16];
+            std::snprintf(date, sizeof(date), "%04d-%02d-%02d", year, 1 + static_cast<int>(random() % 12),
+                          1 + static_cast<int>(random() % 28));
+            PerfMgmt::PerformanceReview& review = reviews.emplace_back(org.reviews[next++ % org.reviews.size()]);
+            review.reviewId = 0;
+            review.reviewDate = date;
+        }
+        db.addPerformanceReviews(reviews);
+    }
+}
+
+// every page of [from, to); returns the number of reviews
+std::size_t listRange(PerfMgmt::DatabaseManager& db, const std::string& from, const std::string& to) {
+    std::size_t count{0};
+    std::optional<PerfMgmt::ReviewCursor> after;
+    do {
+        auto page = db.getReviewsInDateRange(from, to, after, PerfMgmt::MAX_REVIEW_PAGE_SIZE);
+        if (!page) {
+            break;
+        }
+        count += page->reviews.size();
+        after = std::move(page->next);
+    } while (after);
+    return count;
+}
+
+std::size_t listEmployee(PerfMgmt::DatabaseManager& db, int employeeId) {
+    std::size_t count{0};
+    std::optional<PerfMgmt::ReviewCursor> after;
+    do {
+        auto page = db.getReviewsForEmployee(employeeId, after);
+        if (!page) {
+            break;
+        }
+        count += page->reviews.size();
+        after = std::move(page->next);
+    } while (after);
+    return count;
+}
+
+// best of repetitions, in milliseconds
+template <typename Run>
+double best(int repetitions, Run&& run) {
+    double fastest = 0.0;
+    for (int repetition = 0; repetition < repetitions; ++repetition) {
+        auto start = Clock::now();
+        run();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        fastest = repetition == 0 ? ms : std::min(fastest, ms);
+    }
+    return fastest;
+}
+
+void report(const char* label, PerfMgmt::DatabaseManager& db, int repetitions) {
+    const std::string year = std::to_string(CURRENT_YEAR);
+    std::size_t quarterRows{0};
+    std::size_t yearRows{0};
+    std::size_t historyRows{0};
+    double quarter = best(repetitions, [&] { quarterRows = listRange(db, year + "-10-01", year + "-12-31"); });
+    double wholeYear = best(repetitions, [&] { yearRows = listRange(db, year + "-01-01", year + "-12-31"); });
+    double history = best(repetitions, [&] {
+        historyRows = 0;
+        for (int employeeId = 2; employeeId < 102; ++employeeId) {
+            historyRows += listEmployee(db, employeeId);
+        }
+    });
+    std::printf("%-8s %10.1f MB %8.2f ms (%6zu) %8.2f ms (%7zu) %8.2f ms (%6zu)\n", label,
+                static_cast<double>(std::filesystem::file_size(DB_NAME)) / (1024.0 * 1024.0), quarter, quarterRows,
+                wholeYear, yearRows, history, historyRows);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int years = argc > 1 ? std::stoi(argv[1]) : 8;
+    int reviewsPerYear = argc > 2 ? std::stoi(argv[2]) : 100000;
+    int repetitions = argc > 3 ? std::stoi(argv[3]) : 5;
+
+    removeDatabase();
+    PerfMgmt::DatabaseManager db(DB_NAME);
+    populate(db, years, reviewsPerYear);
+    std::printf("%d years of %d reviews, %zu employees\n", years, reviewsPerYear, EMPLOYEE_COUNT);
+    std::printf("%-8s %13s %20s %20s %19s\n", "", "hot file", "current quarter", "current year",
+                "100 histories");
+    report("single", db, repetitions);
+
+    auto start = Clock::now();
+    bool archived = db.archiveReviewsBefore(CURRENT_YEAR);
+    double archiveMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    report("archived", db, repetitions);
+    std::printf("archiveReviewsBefore(%d) %s in %.0f ms, %zu archive files\n", CURRENT_YEAR,
+                archived ? "succeeded" : "FAILED", archiveMs, db.reviewArchives().size());
+    return archived ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#ifndef SYNTHETICORG_HPP
+#define SYNTHETICORG_HPP
+
+#include <Models.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace PerfMgmt::bench {
+
+// reporting depth every benchmark generates its org with, so they all measure the same shape
+constexpr std::size_t SYNTHETIC_ORG_DEPTH = 6;
+
+// A generated organisation: employees in breadth-first order (ids 1..n, 1 is the root)
+// and reviews written by each employee's manager.
+struct SyntheticOrg {
+    std::vector<Employee> employees;
+    std::vector<PerformanceReview> reviews;
+    // children per manager needed to fit the employees into the requested depth
+    std::size_t fanout{1};
+    // ids with at least one direct report
+    std::vector<int> managerIds;
+};
+
+// Reporting tree of at most depth levels, filled level by level with the smallest fanout that fits
+// employeeCount. Every non-root employee gets reviewsPerEmployee reviews from their manager.
+// The same seed always produces the same org with a given compiler.
+inline SyntheticOrg makeSyntheticOrg(std::size_t employeeCount, std::size_t depth, std::size_t reviewsPerEmployee = 1,
+                                     std::uint32_t seed = 42) {
+    static const std::array<const char*, 8> firstNames = {"Ada",     "Grace",   "Alan",   "Edsger",
+                                                          "Niklaus", "Barbara", "Donald", "Frances"};
+    static const std::array<const char*, 8> lastNames = {"Lovelace", "Hopper", "Turing", "Dijkstra",
+                                                         "Wirth",    "Liskov", "Knuth",  "Allen"};
+    SyntheticOrg org;
+    if (employeeCount == 0) {
+        return org;
+    }
+    if (depth == 0) {
+        depth = 1;
+    }
+
+    // smallest fanout f with 1 + f + ... + f^(depth - 1) >= employeeCount
+    std::size_t fanout = 1;
+    for (;; ++fanout) {
+        std::size_t capacity = 0;
+        std::size_t level = 1;
+        for (std::size_t d = 0; d < depth && capacity < employeeCount; ++d) {
+            capacity += level;
+            level *= fanout;
+        }
+        if (capacity >= employeeCount || fanout >= employeeCount) {
+            break;
+        }
+    }
+    org.fanout = fanout;
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::size_t> nameIndex(0, firstNames.size() - 1);
+    std::uniform_int_distribution<int> year(2010, 2024);
+    std::uniform_int_distribution<int> month(1, 12);
+    std::uniform_int_distribution<int> day(1, 28);
+    std::uniform_real_distribution<float> rating(1.0f, 10.0f);
+    auto date = [&](int fromYear) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", std::max(fromYear, year(rng)), month(rng), day(rng));
+        return std::string(buffer);
+    };
+
+    org.employees.reserve(employeeCount);
+    for (std::size_t index = 0; index < employeeCount; ++index) {
+        int id = static_cast<int>(index) + 1;
+        // breadth-first numbering of a complete fanout-ary tree
+        std::optional<int> reportsTo = index == 0 ? std::nullopt : std::optional<int>((index - 1) / fanout + 1);
+        bool hasReports = index * fanout + 1 < employeeCount;
+        Role role = index == 0 ? Role::BOSS
+                    : hasReports ? Role::MANAGER
+                    : (id % 3 == 0 ? Role::TECHNICIAN : Role::SPECIALIST);
+        if (hasReports) {
+            org.managerIds.push_back(id);
+        }
+        std::string name = std::string(firstNames[nameIndex(rng)]) + " " + lastNames[nameIndex(rng)] + " " +
+                           std::to_string(id);
+        org.employees.emplace_back(id, 20250000 + id, std::move(name), date(2010), role, id % 17 != 0, reportsTo);
+    }
+
+    org.reviews.reserve((employeeCount - 1) * reviewsPerEmployee);
+    int reviewId = 1;
+    for (const auto& employee : org.employees) {
+        if (!employee.reportsTo) {
+            continue;
+        }
+        for (std::size_t r = 0; r < reviewsPerEmployee; ++r) {
+            org.reviews.emplace_back(reviewId++, employee.employeeId, *employee.reportsTo, date(2020), rating(rng),
+                                     rating(rng), rating(rng), rating(rng), rating(rng), rating(rng), rating(rng),
+                                     rating(rng), rating(rng), rating(rng), rating(rng), "synthetic review");
+        }
+    }
+    return org;
+}
+
+} // namespace PerfMgmt::bench
+
+#endif // SYNTHETICORG_HPP
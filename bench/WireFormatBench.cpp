@@ -0,0 +1,181 @@
+#include "SyntheticOrg.hpp"
+#include <JsonStreamDecoder.hpp>
+#include <Models.hpp>
+#include <WireFormat.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+
+// Bytes on the wire and client decode time of an employee list and a review list, as the server sends them
+// (with the sync "version" key) in JSON, MessagePack and CBOR, each plain and gzipped when built with zlib.
+// JSON is decoded by the streaming JsonRowDecoder and the binary formats by BinaryRowDecoder, fed in the
+// 4 KiB pieces cpp-httplib hands out; gzipped bodies are inflated piece by piece in front of the decoder, as
+// httplib does. The rows are a synthetic org (bench/SyntheticOrg.hpp). Decode time is the best of the repetitions.
+// usage: wire_format_bench [employees] [reviewsPerEmployee] [repetitions]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using PerfMgmt::WireFormat;
+
+// cpp-httplib hands the content receiver at most CPPHTTPLIB_RECV_BUFSIZ (4 KiB) per call
+constexpr std::size_t CHUNK_SIZE = 4096;
+
+struct Body {
+    const char* label;
+    WireFormat format;
+    bool gzipped;
+    std::string bytes;
+};
+
+// rows as the server lists them, each with its sync "version"
+template <typename Row>
+json withVersions(const std::vector<Row>& rows) {
+    json list = json::array();
+    std::int64_t version{0};
+    for (const Row& row : rows) {
+        json item = row;
+        item["version"] = ++version;
+        list.push_back(std::move(item));
+    }
+    return list;
+}
+
+std::string encode(const json& rows, WireFormat format) {
+    if (format == WireFormat::JSON) {
+        return rows.dump();
+    }
+    std::vector<std::uint8_t> bytes = format == WireFormat::CBOR ? json::to_cbor(rows) : json::to_msgpack(rows);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+// gzip at zlib's default level, the settings cpp-httplib and Python's gzip module use
+std::string gzip(const std::string& data) {
+    z_stream stream{};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+#endif
+
+// feed body to decoder in receive-buffer pieces, inflating them first when it is gzipped
+template <typename Decoder>
+bool feedBody(const Body& body, Decoder& decoder) {
+    if (!body.gzipped) {
+        for (std::size_t pos = 0; pos < body.bytes.size(); pos += CHUNK_SIZE) {
+            if (!decoder.feed(body.bytes.data() + pos, std::min(CHUNK_SIZE, body.bytes.size() - pos))) {
+                return false;
+            }
+        }
+        return true;
+    }
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    z_stream stream{};
+    inflateInit2(&stream, 15 + 32);
+    char out[16384];
+    bool ok = true;
+    for (std::size_t pos = 0; pos < body.bytes.size() && ok; pos += CHUNK_SIZE) {
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.bytes.data() + pos));
+        stream.avail_in = static_cast<uInt>(std::min(CHUNK_SIZE, body.bytes.size() - pos));
+        int status{Z_OK};
+        // a full output buffer may leave more output behind even once the input is used up
+        do {
+            stream.next_out = reinterpret_cast<Bytef*>(out);
+            stream.avail_out = sizeof(out);
+            status = inflate(&stream, Z_NO_FLUSH);
+            std::size_t produced = sizeof(out) - stream.avail_out;
+            ok = (status == Z_OK || status == Z_STREAM_END || status == Z_BUF_ERROR) &&
+                 (produced == 0 || decoder.feed(out, produced));
+        } while (ok && status == Z_OK && (stream.avail_in > 0 || stream.avail_out == 0));
+    }
+    inflateEnd(&stream);
+    return ok;
+#else
+    return false;
+#endif
+}
+
+// seconds to decode body into rows; exits if the rows do not come back
+template <typename Row>
+double decodeSeconds(const Body& body, std::size_t expectedRows) {
+    std::vector<Row> rows;
+    std::int64_t watermark{0};
+    auto versions = [&watermark](std::string_view key, const PerfMgmt::JsonScalar& value) {
+        if (key == "version") {
+            watermark = std::max(watermark, value.asInt64().value_or(watermark));
+        }
+    };
+    auto start = Clock::now();
+    bool ok{false};
+    if (body.format == WireFormat::JSON) {
+        PerfMgmt::JsonRowDecoder<Row> decoder(rows, versions);
+        ok = feedBody(body, decoder) && decoder.finish();
+    } else {
+        PerfMgmt::BinaryRowDecoder<Row> decoder(rows, body.format, versions);
+        ok = feedBody(body, decoder) && decoder.finish();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (!ok || rows.size() != expectedRows || watermark != static_cast<std::int64_t>(expectedRows)) {
+        std::fprintf(stderr, "%s: decode failed\n", body.label);
+        std::exit(1);
+    }
+    return seconds;
+}
+
+template <typename Row>
+void measure(const char* title, const json& rows, int repetitions) {
+    std::vector<Body> bodies;
+    for (auto [label, format] : {std::pair{"JSON", WireFormat::JSON}, std::pair{"MessagePack", WireFormat::MSGPACK},
+                                 std::pair{"CBOR", WireFormat::CBOR}}) {
+        bodies.push_back({label, format, false, encode(rows, format)});
+    }
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    for (auto [label, format] : {std::pair{"JSON + gzip", WireFormat::JSON},
+                                 std::pair{"MessagePack + gzip", WireFormat::MSGPACK},
+                                 std::pair{"CBOR + gzip", WireFormat::CBOR}}) {
+        bodies.push_back({label, format, true, gzip(encode(rows, format))});
+    }
+#endif
+    std::printf("%s, %zu rows\n", title, rows.size());
+    double jsonBytes = static_cast<double>(bodies.front().bytes.size());
+    for (const Body& body : bodies) {
+        double best{0};
+        for (int i = 0; i < repetitions; ++i) {
+            double seconds = decodeSeconds<Row>(body, rows.size());
+            best = i == 0 ? seconds : std::min(best, seconds);
+        }
+        std::printf("  %-20s %10.2f MB on the wire (%5.1f%% of JSON) %9.1f ms decode %10.0f rows/s\n", body.label,
+                    body.bytes.size() / 1e6, 100.0 * body.bytes.size() / jsonBytes, best * 1e3, rows.size() / best);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t employees = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t reviewsPerEmployee = argc > 2 ? std::stoul(argv[2]) : 2;
+    int repetitions = argc > 3 ? std::max(1, std::stoi(argv[3])) : 3;
+
+#ifndef CPPHTTPLIB_ZLIB_SUPPORT
+    std::printf("built without zlib, gzip bodies are not measured\n");
+#endif
+    auto org = PerfMgmt::bench::makeSyntheticOrg(employees, PerfMgmt::bench::SYNTHETIC_ORG_DEPTH, reviewsPerEmployee);
+    measure<PerfMgmt::Employee>("employees", withVersions(org.employees), repetitions);
+    measure<PerfMgmt::PerformanceReview>("reviews", withVersions(org.reviews), repetitions);
+    return 0;
+}
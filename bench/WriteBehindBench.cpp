@@ -0,0 +1,104 @@
+#include "SyntheticOrg.hpp"
+#include <DatabaseManager.hpp>
+#include <Metrics.hpp>
+#include <Models.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Review submissions/sec from N threads, each waiting until its review is durable: one implicit transaction per
+// addPerformanceReview against the write-behind queue's group commits, on a synthetic org
+// (bench/SyntheticOrg.hpp). Also prints the mean group size.
+// usage: write_behind_bench [reviewsPerThread] [maxThreads] [maxBatchSize]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string DB_NAME = "write_behind_bench.db";
+constexpr std::size_t EMPLOYEE_COUNT = 1000;
+
+// the org's employees go into the database, its reviews are what the threads submit
+PerfMgmt::bench::SyntheticOrg populate() {
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::filesystem::remove(DB_NAME + suffix);
+    }
+    auto org = PerfMgmt::bench::makeSyntheticOrg(EMPLOYEE_COUNT, PerfMgmt::bench::SYNTHETIC_ORG_DEPTH);
+    PerfMgmt::DatabaseManager db(DB_NAME);
+    db.addEmployees(org.employees);
+    // submitted as new reviews, sqlite assigns the ids
+    for (auto& review : org.reviews) {
+        review.reviewId = 0;
+    }
+    return org;
+}
+
+// submissions per second; submit(review) must only return once the review is durable
+template <typename Submit>
+double run(const std::vector<PerfMgmt::PerformanceReview>& reviews, int threadCount, int reviewsPerThread,
+           Submit&& submit) {
+    std::atomic<long> written{0};
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            long local = 0;
+            for (int i = 0; i < reviewsPerThread; ++i) {
+                local += submit(reviews[static_cast<std::size_t>(t * reviewsPerThread + i) % reviews.size()]);
+            }
+            written += local;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return written.load() / seconds;
+}
+
+PerfMgmt::PoolConfig poolConfig() {
+    PerfMgmt::PoolConfig config;
+    config.walMode = true;
+    return config;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int reviewsPerThread = argc > 1 ? std::stoi(argv[1]) : 500;
+    int maxThreads = argc > 2 ? std::stoi(argv[2]) : 64;
+    std::size_t maxBatchSize = argc > 3 ? std::stoul(argv[3]) : 256;
+
+    auto org = populate();
+    PerfMgmt::Metrics::setEnabled(true);
+    auto& groups = PerfMgmt::Metrics::instance().operation("db", "commitWriteGroup");
+
+    std::printf("%8s %16s %16s %12s\n", "threads", "direct writes/s", "grouped writes/s", "mean group");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double direct;
+        {
+            PerfMgmt::DatabaseManager db(DB_NAME, poolConfig());
+            direct = run(org.reviews, threads, reviewsPerThread,
+                         [&db](const PerfMgmt::PerformanceReview& review) { return db.addPerformanceReview(review); });
+        }
+        double grouped;
+        PerfMgmt::Metrics::instance().reset();
+        {
+            PerfMgmt::DatabaseManager db(DB_NAME, poolConfig());
+            PerfMgmt::WriteBehindConfig config;
+            config.maxBatchSize = maxBatchSize;
+            db.enableWriteBehind(config);
+            grouped = run(org.reviews, threads, reviewsPerThread, [&db](const PerfMgmt::PerformanceReview& review) {
+                return db.submitPerformanceReview(review).get().ok();
+            });
+        }
+        auto groupCount = groups.latency.snapshot().count;
+        double meanGroup = groupCount == 0 ? 0.0 : static_cast<double>(threads) * reviewsPerThread / groupCount;
+        std::printf("%8d %16.0f %16.0f %12.1f\n", threads, direct, grouped, meanGroup);
+    }
+    return 0;
+}
@@ -8,6 +8,8 @@ CREATE TABLE IF NOT EXISTS employees (
               hire_date TEXT,
               personnel_code INT,
               is_active INT DEFAULT 1,
+              local_version INTEGER NOT NULL DEFAULT 1,
+              synced_version INTEGER NOT NULL DEFAULT 0,
               FOREIGN KEY (reports_to) REFERENCES employees(employee_id)
               );
 
@@ -36,15 +38,53 @@ CREATE TABLE IF NOT EXISTS performance_reviews (
         leadership_rating REAL CHECK(leadership_rating BETWEEN 1 AND 10),
         initiative_rating REAL CHECK(initiative_rating BETWEEN 1 AND 10),
 
+        -- Change tracking for sync, the row is dirty while local_version > synced_version
+        local_version INTEGER NOT NULL DEFAULT 1,
+        synced_version INTEGER NOT NULL DEFAULT 0,
+
         FOREIGN KEY (employee_id) REFERENCES employees(employee_id),
         FOREIGN KEY (reviewer_id) REFERENCES employees(employee_id)
 );
 
 CREATE INDEX IF NOT EXISTS idx_employee_name ON employees(name);
 CREATE INDEX IF NOT EXISTS idx_employee_role ON employees(role);
-CREATE INDEX IF NOT EXISTS idx_review_employee_id ON 
-performance_reviews(employee_id);
-CREATE INDEX IF NOT EXISTS idx_review_reviewer_id ON
-performance_reviews(reviewer_id);
+CREATE INDEX IF NOT EXISTS idx_employee_reports_to ON employees(reports_to);
+-- review_id is the rowid every index entry ends with, so these serve the
+-- (review_date, review_id) keyset pages of the review lists
+CREATE INDEX IF NOT EXISTS idx_review_employee_date ON
+performance_reviews(employee_id, review_date);
+CREATE INDEX IF NOT EXISTS idx_review_reviewer_date ON
+performance_reviews(reviewer_id, review_date);
 CREATE INDEX IF NOT EXISTS idx_review_date ON
-performance_reviews(review_date);
\ No newline at end of file
+performance_reviews(review_date);
+
+-- Pull watermarks of the sync engine
+CREATE TABLE IF NOT EXISTS sync_state (
+        name TEXT PRIMARY KEY,
+        value INTEGER NOT NULL
+);
+
+-- Local edits bump local_version; updates that also move synced_version come from the sync engine
+CREATE TRIGGER IF NOT EXISTS trg_employee_local_edit AFTER UPDATE OF name, role,
+reports_to, hire_date, personnel_code, is_active ON employees
+WHEN NEW.synced_version = OLD.synced_version
+BEGIN
+        UPDATE employees SET local_version = OLD.local_version + 1
+        WHERE employee_id = NEW.employee_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_review_local_edit AFTER UPDATE OF employee_id,
+reviewer_id, review_date, overall_rating, comments, punctuality_rating,
+quality_of_work_rating, teamwork_rating, communication_rating,
+problem_solving_rating, creativity_rating, technical_skills_rating,
+adaptability_rating, leadership_rating, initiative_rating ON performance_reviews
+WHEN NEW.synced_version = OLD.synced_version
+BEGIN
+        UPDATE performance_reviews SET local_version = OLD.local_version + 1
+        WHERE review_id = NEW.review_id;
+END;
+
+CREATE INDEX IF NOT EXISTS idx_employee_dirty ON employees(employee_id)
+WHERE local_version > synced_version;
+CREATE INDEX IF NOT EXISTS idx_review_dirty ON performance_reviews(review_id)
+WHERE local_version > synced_version;
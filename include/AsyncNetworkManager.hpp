@@ -0,0 +1,91 @@
+#ifndef ASYNCNETWORKMANAGER_HPP
+#define ASYNCNETWORKMANAGER_HPP
+
+#include <Models.hpp>
+#include <NetworkManager.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace PerfMgmt {
+
+struct AsyncNetworkConfig {
+    // worker threads, each owning one keep-alive connection to the server
+    std::size_t workerCount{4};
+    // requests queued or running at once; submitting beyond this blocks the caller
+    std::size_t maxInFlight{64};
+    // total tries per request, transient failures only (no response, 429, 5xx); requests that create a row on
+    // the server (POST) are only repeated when the connection failed before the request was sent
+    int maxAttempts{3};
+    // wait before the first retry, doubled on every further attempt
+    std::chrono::milliseconds initialBackoff{100};
+    // body format of row list fetches, see NetworkManager::setWireFormat
+    WireFormat wireFormat{WireFormat::JSON};
+};
+
+// Non-blocking front end for NetworkManager.
+// Calls are queued and served by a fixed pool of workers so round trips overlap
+// instead of being paid one after the other; every call returns a future.
+class AsyncNetworkManager {
+public:
+    explicit AsyncNetworkManager(const std::string& serverBaseUrl, const AsyncNetworkConfig& config = {});
+    AsyncNetworkManager(const AsyncNetworkManager& other) = delete;
+    AsyncNetworkManager& operator=(const AsyncNetworkManager& other) = delete;
+    // finishes every queued request, then joins the workers
+    ~AsyncNetworkManager();
+
+    // ----- Employee API Calls -----
+    std::future<std::optional<Employee>> fetchSingleEmployee(int employeeId);
+    std::future<std::optional<int>> sendNewEmployee(const Employee& employee);
+    std::future<bool> sendUpdatedEmployee(int serverEmployeeId, const Employee& employee);
+
+    // ----- Performance Review API Calls -----
+    std::future<std::optional<std::vector<PerformanceReview>>> fetchReviewsForEmployee(int serverEmployeeId);
+    std::future<std::optional<int>> sendNewReview(int serverEmployeeId, const PerformanceReview& review);
+    std::future<bool> updateReview(int serverReviewId, const PerformanceReview& review);
+
+    // requests queued or running right now
+    std::size_t inFlight() const;
+    // blocks until every submitted request has completed
+    void waitIdle();
+
+private:
+    using Task = std::function<void(NetworkManager&)>;
+
+    // whether a call can be repeated after the server may already have acted on it
+    enum class Retry {
+        IDEMPOTENT,    // GET, PUT: a repeat leaves the server as one call would
+        UNSENT_ONLY    // POST: a repeat could create the row twice
+    };
+
+    // wraps a blocking NetworkManager call into a retried task and queues it
+    template <typename Result>
+    std::future<Result> submit(std::function<Result(NetworkManager&)> call, Retry retry = Retry::IDEMPOTENT);
+    void enqueue(Task task);
+    void workerLoop(std::size_t index);
+    bool isTransient(const NetworkManager& client, Retry retry) const;
+
+    AsyncNetworkConfig config;
+    std::vector<std::unique_ptr<NetworkManager>> clients;
+    std::vector<std::thread> workers;
+
+    mutable std::mutex queueMutex;
+    std::condition_variable taskReady;
+    std::condition_variable slotFree;
+    std::deque<Task> tasks;
+    std::size_t pending{0};
+    bool stopping{false};
+};
+
+} // namespace PerfMgmt
+
+#endif // ASYNCNETWORKMANAGER_HPP
@@ -0,0 +1,107 @@
+#ifndef CALIBRATIONENGINE_HPP
+#define CALIBRATIONENGINE_HPP
+
+#include <KpiColumnStore.hpp>
+#include <Models.hpp>
+#include <RowArena.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace PerfMgmt {
+
+struct CalibrationConfig {
+    // worker threads for accumulating, sorting and ranking; 1 runs everything on the calling thread
+    std::size_t threads{std::max(1u, std::thread::hardware_concurrency())};
+    // only reviews dated in [fromDay, toDay) count; NO_DAY leaves that end open
+    DayNumber fromDay{NO_DAY};
+    DayNumber toDay{NO_DAY};
+    // leave inactive employees out of every ranking
+    bool activeOnly{true};
+};
+
+// who an employee is ranked against
+enum class CalibrationScope { ORGANIZATION, ROLE };
+
+// where one employee stands on one metric within one scope
+struct Standing {
+    // mean of the metric over the employee's reviews
+    float score{0.0f};
+    // 1 for the best score; tied scores share the best rank of the tie
+    std::uint32_t rank{0};
+    // share of the scope scoring lower, ties counted half, in percent
+    float percentile{0.0f};
+    // (score - scope mean) / scope population standard deviation, 0 when every score is equal
+    float zScore{0.0f};
+};
+
+// Calibration ranks of the whole organization: every employee's rank, percentile and z-score on overallRating
+// and on each KPI, against the organization and against the employees of the same role.
+//
+// compute() takes both tables as decoded by one scanAllEmployees / scanAllPerformanceReviews pass. Each metric
+// is an employee's mean over their reviews. The employees are split into one contiguous id range per worker and
+// the reviews bucketed by range with a parallel counting sort, so every worker sums the reviews of its own
+// employees without locks or per-thread copies. Each metric's scores are then sorted
+// best first by a parallel merge sort, and a stable partition of the sorted scores by role gives every role's
+// ranking without sorting again. All phases run on config.threads workers taking tasks off a shared counter.
+//
+//     CalibrationEngine calibration;
+//     if (db.calibrate(calibration)) { auto standing = calibration.overallStanding(id, CalibrationScope::ROLE); }
+class CalibrationEngine {
+public:
+    explicit CalibrationEngine(const CalibrationConfig& config = {});
+
+    // replaces the previous results
+    void compute(const EmployeeArena& employees, const ReviewArena& reviews);
+    void clear();
+
+    // nullopt if employeeId was not ranked on the metric: unknown, inactive or without a review that counts
+    std::optional<Standing> standing(int employeeId, Kpi kpi, CalibrationScope scope) const;
+    std::optional<Standing> overallStanding(int employeeId, CalibrationScope scope) const;
+    // employee ids ranked on the metric, best first; role is only read for CalibrationScope::ROLE
+    std::vector<int> ranking(Kpi kpi, CalibrationScope scope, Role role = Role::SPECIALIST) const;
+    std::vector<int> overallRanking(CalibrationScope scope, Role role = Role::SPECIALIST) const;
+
+    // employees with at least one review that counts, and those reviews
+    std::size_t rankedEmployees() const;
+    std::size_t countedReviews() const;
+
+private:
+    // the KPIs in Kpi order, then overallRating
+    static constexpr std::size_t METRIC_COUNT = KPI_COUNT + 1;
+    static constexpr std::size_t OVERALL = KPI_COUNT;
+
+    // one employee's score on one metric, as the sort sees it
+    struct Entry {
+        float score;
+        std::uint32_t employee; // index into employeeIds
+    };
+
+    // ranks, percentiles and z-scores of one scope's entries, sorted best first, into standings by employee index
+    static void rank(const Entry* entries, std::size_t count, std::vector<Standing>& standings);
+    std::optional<Standing> find(int employeeId, std::size_t metric, CalibrationScope scope) const;
+    std::vector<int> ids(std::size_t metric, CalibrationScope scope, Role role) const;
+
+    CalibrationConfig config;
+    // ranked candidates in ascending id order, with their roles
+    std::vector<int> employeeIds;
+    std::vector<Role> roles;
+    // per metric: the entries of the whole organization best first, and the same entries stably partitioned
+    // by role, role r starting at roleStart[r]
+    std::array<std::vector<Entry>, METRIC_COUNT> organization;
+    std::array<std::vector<Entry>, METRIC_COUNT> byRole;
+    std::array<std::array<std::size_t, ROLE_COUNT + 1>, METRIC_COUNT> roleStart{};
+    // per metric, per employee index; rank 0 marks an employee not ranked on the metric
+    std::array<std::vector<Standing>, METRIC_COUNT> organizationStandings;
+    std::array<std::vector<Standing>, METRIC_COUNT> roleStandings;
+    std::size_t ranked{0};
+    std::size_t reviewsCounted{0};
+};
+
+} // namespace PerfMgmt
+
+#endif // CALIBRATIONENGINE_HPP
@@ -0,0 +1,110 @@
+#ifndef CHANGEFEED_HPP
+#define CHANGEFEED_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace PerfMgmt {
+
+// ring slots of the change feed by default
+constexpr std::size_t DEFAULT_CHANGE_FEED_CAPACITY = 4096;
+
+enum class ChangeKind : std::uint8_t {
+    EMPLOYEE_INSERTED,
+    // also an employee upserted by a sync pull, or renumbered to its server id (the old id then reads back empty)
+    EMPLOYEE_UPDATED,
+    EMPLOYEE_DEACTIVATED,
+    REVIEW_ADDED,
+    // also a review upserted by a sync pull
+    REVIEW_UPDATED,
+    REVIEW_DELETED,
+};
+
+// One committed mutation. Events only name the row: a consumer that needs the new values reads them back,
+// e.g. with one getEmployees call for a whole poll.
+struct ChangeEvent {
+    // 1 for the first event of the feed, then +1 per event in commit order
+    std::uint64_t sequence{0};
+    ChangeKind kind{ChangeKind::EMPLOYEE_INSERTED};
+    int employeeId{0}; // 0 for REVIEW_DELETED, the row is gone
+    int reviewId{0};   // 0 for employee events
+};
+
+class ChangeSubscription;
+
+// Broadcast ring of change events: one producer at a time, any number of subscribers that never block it.
+//
+// Every slot is a seqlock. publish() marks the slot busy with an odd stamp, writes the event and then stamps
+// it 2 * sequence; a reader copies the slot and keeps the copy only if the stamp was 2 * sequence before and
+// after. Nothing is ever locked or allocated once the ring exists, and subscribers do not write shared state,
+// so any number of them can poll concurrently without slowing the producer or each other.
+// The ring keeps the last capacity events; a subscriber that falls further behind skips to the oldest one
+// still held and is told how many it missed, so it knows to rescan instead.
+class ChangeFeed {
+public:
+    // capacity is rounded up to a power of two
+    explicit ChangeFeed(std::size_t capacity = DEFAULT_CHANGE_FEED_CAPACITY);
+    ChangeFeed(const ChangeFeed& other) = delete;
+    ChangeFeed& operator=(const ChangeFeed& other) = delete;
+
+    // producer only, callers serialize; returns the event's sequence
+    std::uint64_t publish(ChangeKind kind, int employeeId, int reviewId = 0);
+
+    // a cursor at the next event to be published
+    ChangeSubscription subscribe() const;
+    // a cursor at sequence, e.g. one past the last event a consumer handled before it went away
+    ChangeSubscription subscribeFrom(std::uint64_t sequence) const;
+
+    // sequence of the newest event, 0 while none was published
+    std::uint64_t lastSequence() const;
+    std::size_t capacity() const;
+
+private:
+    friend class ChangeSubscription;
+
+    // the stamp is 2 * sequence once the slot holds that event, odd while it is being rewritten
+    struct Slot {
+        std::atomic<std::uint64_t> stamp{0};
+        std::atomic<ChangeKind> kind{ChangeKind::EMPLOYEE_INSERTED};
+        std::atomic<int> employeeId{0};
+        std::atomic<int> reviewId{0};
+    };
+
+    enum class ReadStatus { READY, NOT_YET, OVERWRITTEN };
+    // copy the event with the given sequence out of its slot
+    ReadStatus read(std::uint64_t sequence, ChangeEvent& event) const;
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    std::atomic<std::uint64_t> published{0};
+};
+
+// One consumer's position in a ChangeFeed. Not shared between threads; every thread polls its own.
+class ChangeSubscription {
+public:
+    // the next event, nullopt once caught up
+    std::optional<ChangeEvent> next();
+    // append up to maxEvents events to events, returns how many were appended
+    std::size_t poll(std::vector<ChangeEvent>& events, std::size_t maxEvents = SIZE_MAX);
+
+    // sequence of the next event this subscription hands out; store it to resume with subscribeFrom
+    std::uint64_t nextSequence() const;
+    // events overwritten before they were read, over the subscription's lifetime
+    std::uint64_t missed() const;
+
+private:
+    friend class ChangeFeed;
+    ChangeSubscription(const ChangeFeed& feed, std::uint64_t sequence);
+
+    const ChangeFeed* feed;
+    std::uint64_t sequence;
+    std::uint64_t skipped{0};
+};
+
+} // namespace PerfMgmt
+
+#endif // CHANGEFEED_HPP
@@ -0,0 +1,132 @@
+#ifndef CONNECTIONPOOL_HPP
+#define CONNECTIONPOOL_HPP
+
+#include <StatementCache.hpp>
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sqlite_modern_cpp.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace PerfMgmt {
+
+struct PoolConfig {
+    // read-only connections; 0 means reads share the writer connection
+    std::size_t readerCount{0};
+    // switch the database to write-ahead logging so readers never block the writer
+    bool walMode{false};
+    // how long a connection waits on a locked database before SQLITE_BUSY is raised
+    std::chrono::milliseconds busyTimeout{5000};
+};
+
+// one sqlite connection together with its prepared statements
+struct PooledConnection {
+    PooledConnection(const std::string& dbAddress, const sqlite::sqlite_config& config);
+    PooledConnection(const PooledConnection& other) = delete;
+    PooledConnection& operator=(const PooledConnection& other) = delete;
+
+    sqlite::database db;
+    StatementCache statements;
+    // generation of the connection setup last run on this connection
+    std::uint64_t setupGeneration{0};
+    // schema names of the databases the connection setup attached
+    std::vector<std::string> attached;
+    // reader connections: the thread holding the connection and its leases on it; guarded by the readers mutex
+    std::thread::id owner;
+    std::size_t leaseCount{0};
+};
+
+// per-connection state beyond the schema, e.g. attached databases and temp views; runs on a leased connection
+using ConnectionSetup = std::function<void(PooledConnection&)>;
+
+// One writer and N reader connections on the same database file.
+// The writer is handed out exclusively so writes stay ordered, readers are
+// handed out to one thread at a time and returned when the lease goes away.
+//
+// A thread never waits for a second connection while it holds one: acquiring a reader while the thread
+// already leases one (e.g. a query from inside a cursor's scan) hands out the same connection again, and a
+// thread holding the writer reads on the writer. Otherwise a reader-count of scans reading from their own
+// visitors, or a writer waiting for a reader held by a thread that waits for the writer, would deadlock.
+// Leases therefore stay on the thread that acquired them.
+class ConnectionPool {
+public:
+    // RAII handle on a pooled connection
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) = delete;
+        Lease(const Lease& other) = delete;
+        ~Lease();
+
+        PooledConnection& operator*() const;
+        PooledConnection* operator->() const;
+
+    private:
+        friend class ConnectionPool;
+        Lease(ConnectionPool* pool, PooledConnection* connection, std::unique_lock<std::recursive_mutex> writerLock);
+
+        ConnectionPool* pool;
+        PooledConnection* connection;
+        // held for writer leases (and reader leases that fall back to the writer)
+        std::unique_lock<std::recursive_mutex> writerLock;
+    };
+
+    ConnectionPool(const std::string& dbAddress, const PoolConfig& config);
+    ConnectionPool(const ConnectionPool& other) = delete;
+    ConnectionPool& operator=(const ConnectionPool& other) = delete;
+
+    // opens the reader connections, called once the writer has created the schema
+    void openReaders();
+
+    // blocks until a reader connection is free, unless the calling thread already holds a connection
+    Lease acquireReader();
+    // blocks until the writer connection is free
+    Lease acquireWriter();
+
+    std::size_t readerCount() const;
+
+    // replace the connection setup: every connection runs it before its next lease, connections opened later
+    // run it before their first. Do not call while this thread iterates a cursor on a pooled connection.
+    void setConnectionSetup(ConnectionSetup setup);
+
+    // statement cache counters summed over all connections
+    std::size_t statementCacheHits() const;
+    std::size_t statementCacheMisses() const;
+
+private:
+    void release(PooledConnection* connection);
+    void releaseWriter();
+    void configure(PooledConnection& connection, bool isWriter);
+    // run the current connection setup on a freshly leased connection that has not seen it yet
+    void applySetup(PooledConnection& connection);
+
+    std::string dbAddress;
+    PoolConfig config;
+
+    std::unique_ptr<PooledConnection> writer;
+    // recursive so a thread iterating a cursor on the shared writer can still issue queries
+    std::recursive_mutex writerMutex;
+    // thread holding writerMutex and its writer leases; depth is only touched by that thread
+    std::atomic<std::thread::id> writerOwner{};
+    std::size_t writerDepth{0};
+
+    std::vector<std::unique_ptr<PooledConnection>> readers;
+    std::vector<PooledConnection*> idleReaders;
+    std::mutex readersMutex;
+    std::condition_variable readerAvailable;
+
+    std::shared_ptr<const ConnectionSetup> setup;
+    std::atomic<std::uint64_t> setupGeneration{0};
+    std::mutex setupMutex;
+};
+
+} // namespace PerfMgmt
+
+#endif // CONNECTIONPOOL_HPP
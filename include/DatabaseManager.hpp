@@ -1,18 +1,101 @@
 #ifndef DATABASEMANAGER_HPP
 #define DATABASEMANAGER_HPP
 
+#include <CalibrationEngine.hpp>
+#include <ChangeFeed.hpp>
+#include <ConnectionPool.hpp>
+#include <EmployeeCursor.hpp>
+#include <KpiColumnStore.hpp>
+#include <LruCache.hpp>
 #include <Models.hpp>
+#include <OrgChartIndex.hpp>
+#include <RowArena.hpp>
+#include <RowMapping.hpp>
+#include <SearchIndex.hpp>
+#include <Snapshot.hpp>
+#include <TeamAnalytics.hpp>
+#include <WriteBehindQueue.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <sqlite_modern_cpp.h>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace PerfMgmt {
 
+// rows committed per transaction by the bulk import entry points
+constexpr std::size_t DEFAULT_IMPORT_BATCH_SIZE = 1000;
+
+// Outcome of a bulk import: number of committed rows and the input rows that were rejected
+struct BulkImportResult {
+    struct RowError {
+        std::size_t index{}; // position of the rejected row in the input
+        int code{-1};        // sqlite result code, -1 for validation failures
+        std::string message;
+    };
+    std::size_t inserted{0};
+    std::vector<RowError> errors;
+};
+
+// review list pages: pageSize 0 means DEFAULT_REVIEW_PAGE_SIZE, larger sizes are capped at MAX_REVIEW_PAGE_SIZE
+constexpr std::size_t DEFAULT_REVIEW_PAGE_SIZE = 100;
+constexpr std::size_t MAX_REVIEW_PAGE_SIZE = 1000;
+
+// Keyset position in a review list ordered by (review_date, review_id): the key of the last row handed out.
+// A page query seeks straight past it through the index, so page n costs the same as page 1.
+// The default ("", 0) sorts before every row since review_date is NOT NULL.
+struct ReviewCursor {
+    std::string reviewDate;
+    int reviewId{0};
+};
+
+// one bounded page of a review list; next is empty on the last page
+struct ReviewPage {
+    std::vector<PerformanceReview> reviews;
+    std::optional<ReviewCursor> next;
+};
+
+// One closed year of reviews, moved out of the hot performance_reviews table into its own read-only file
+struct ReviewArchive {
+    int year{0};
+    std::string path;
+    std::size_t reviewCount{0};
+};
+
+// a row together with its local change version, as handed to the sync engine
+template <typename Row>
+struct VersionedRow {
+    Row row;
+    std::int64_t version{0};
+    // never pushed: the row still has its local id and has to be created on the server
+    bool isNew{false};
+};
+
+// local version of a row that the server has acknowledged
+struct SyncedVersion {
+    int id{0};
+    std::int64_t version{0};
+};
+
+// id the server assigned to a row created offline, with the local version that was posted
+struct AssignedId {
+    int localId{0};
+    int serverId{0};
+    std::int64_t version{0};
+};
+
 class DatabaseManager {
 public:
     DatabaseManager(DatabaseManager& other) = delete;
     DatabaseManager(DatabaseManager&& other) = delete;
     explicit DatabaseManager(const std::string& dbAddress);
+    // pool mode: poolConfig.readerCount read-only connections next to the writer
+    DatabaseManager(const std::string& dbAddress, const PoolConfig& poolConfig);
     ~DatabaseManager() = default;
 
     bool InitializeDatabase();
@@ -34,42 +117,276 @@ public:
     // 6. deactivateEmployee
     bool deactivateEmployee(int employeeId);
 
+    // 7. addEmployees : one prepared statement, committed every batchSize rows
+    BulkImportResult addEmployees(const std::vector<Employee>& employees,
+                                  std::size_t batchSize = DEFAULT_IMPORT_BATCH_SIZE);
+
+    // 8. streamAllEmployees : constant-memory scan usable with range-for
+    // the cursor holds a pooled connection until it is destroyed
+    EmployeeCursor streamAllEmployees();
+    // 9. forEachEmployee : visitor(const Employee&), returning false stops the scan
+    // returns false if the scan failed. The scan holds its connection while the visitor runs: reads the visitor
+    // makes on its own thread reuse that connection, but it must not wait for other threads that read through
+    // this manager, they may be waiting for the connection the scan holds
+    template <typename Visitor>
+    bool forEachEmployee(Visitor&& visitor);
+    // 10. scanAllEmployees : every employee in employee_id order decoded into arena, which is cleared first;
+    // strings are interned and dates kept as day numbers, so the whole table costs a few heap allocations
+    bool scanAllEmployees(EmployeeArena& arena);
+    // 11. getEmployees : every requested employee in one query instead of one getEmployee call per id.
+    // Slot i answers employeeIds[i], empty if that employee does not exist; nullopt if the query failed
+    std::optional<std::vector<std::optional<Employee>>> getEmployees(const std::vector<int>& employeeIds);
+
+    // ---- Reporting lines ----
+
+    // 1. enableOrgChartIndex : load the in-memory hierarchy, afterwards kept current by the employee mutators
+    bool enableOrgChartIndex();
+    // 2. orgChartIndex : direct reports, subtrees, chains to the root and depths without touching sqlite
+    // empty until enableOrgChartIndex() succeeded
+    const OrgChartIndex& orgChartIndex() const;
+    // 3. enableTeamAnalytics : load per-subtree, per-quarter review rollups (enables the org chart index too),
+    // afterwards kept current by the review mutators
+    bool enableTeamAnalytics();
+    // 4. teamAnalytics : subtree / employee KPI means and deviations per quarter without touching sqlite
+    // empty until enableTeamAnalytics() succeeded
+    const TeamAnalytics& teamAnalytics() const;
+
+    // ---- Search ----
+
+    // 1. enableSearchIndex : load the trigram indexes over employee names and review comments,
+    // afterwards kept current by the mutators
+    bool enableSearchIndex();
+    // 2. employeeNameIndex / reviewCommentIndex : ranked, typo-tolerant substring and prefix search by id
+    // empty until enableSearchIndex() succeeded
+    const SearchIndex& employeeNameIndex() const;
+    const SearchIndex& reviewCommentIndex() const;
+
     // ---- Performance Review Management ----
 
     // 1. addPerformanceReivew
     bool addPerformanceReview(const PerformanceReview& review);
     // 2. getPerformanceReview by id
     std::optional<PerformanceReview> getPerformanceReview(const int& reviewId);
-    // 3. getReviewForEmployee
+    // 3. getReviewForEmployee : the employee's latest review (by review date, then id), archived years included
     std::optional<PerformanceReview> getPerformanceForEmployee(const int& employeeId);
-    // 4. getReviewByReviewer
+    // 4. getReviewByReviewer : every review written by reviewerId, oldest first
     std::optional<std::vector<PerformanceReview>> getReviewByReviewer(int reviewerId);
-    // 5. updatePerformanceReview
-    bool updatePerformanceReview(int reviewId);
-    // 6. deletePerformanceReivew
+    // 5. updatePerformanceReview : overwrite the review with review.reviewId, false if it does not exist
+    bool updatePerformanceReview(const PerformanceReview& review);
+    // 6. deletePerformanceReivew : false if the review does not exist
     bool deletePerformanceReview(int reviewId);
+    // 7. addPerformanceReviews : one prepared statement, committed every batchSize rows
+    BulkImportResult addPerformanceReviews(const std::vector<PerformanceReview>& reviews,
+                                           std::size_t batchSize = DEFAULT_IMPORT_BATCH_SIZE);
+    // 8. loadKpiColumnStore : every review's KPI ratings in columnar form for dashboard aggregates
+    std::optional<KpiColumnStore> loadKpiColumnStore();
+    // 9. paginated review lists ordered by (review_date, review_id); pass the previous page's next to continue
+    // getReviewsForEmployee / getReviewsByReviewer : reviews of / written by one employee
+    std::optional<ReviewPage> getReviewsForEmployee(int employeeId, const std::optional<ReviewCursor>& after = {},
+                                                    std::size_t pageSize = DEFAULT_REVIEW_PAGE_SIZE);
+    std::optional<ReviewPage> getReviewsByReviewer(int reviewerId, const std::optional<ReviewCursor>& after = {},
+                                                   std::size_t pageSize = DEFAULT_REVIEW_PAGE_SIZE);
+    // getReviewsInDateRange : reviews dated in [fromDate, toDate), compared as ISO date strings
+    std::optional<ReviewPage> getReviewsInDateRange(const std::string& fromDate, const std::string& toDate,
+                                                    const std::optional<ReviewCursor>& after = {},
+                                                    std::size_t pageSize = DEFAULT_REVIEW_PAGE_SIZE);
+    // 10. scanAllPerformanceReviews : every review in review_id order decoded into arena, as scanAllEmployees
+    bool scanAllPerformanceReviews(ReviewArena& arena);
+    // 11. submitPerformanceReview / submitPerformanceReviewUpdate / submitPerformanceReviewDeletion :
+    // queue the write on the write-behind writer; the future resolves once it is durable, or failed.
+    // Without enableWriteBehind the write is committed on the calling thread and the future is ready.
+    std::future<WriteResult> submitPerformanceReview(const PerformanceReview& review);
+    std::future<WriteResult> submitPerformanceReviewUpdate(const PerformanceReview& review);
+    std::future<WriteResult> submitPerformanceReviewDeletion(int reviewId);
+    // 12. calibrate : every employee's rank, percentile and z-score on overallRating and each KPI, org-wide
+    // and within their role, computed by engine from one scan of each table; false if a scan failed
+    bool calibrate(CalibrationEngine& engine);
+    // 13. getLatestReviewsForEmployees : the most recent review (latest review_date, then review_id) of every
+    // requested employee in one query. Slot i answers employeeIds[i], empty if that employee has no review
+    std::optional<std::vector<std::optional<PerformanceReview>>>
+    getLatestReviewsForEmployees(const std::vector<int>& employeeIds);
+
+    // ---- Sync bookkeeping ----
+    // Every row carries local_version / synced_version; local edits bump local_version through a trigger,
+    // so a row is dirty while local_version > synced_version.
+
+    // 1. getDirtyEmployees / getDirtyPerformanceReviews : up to limit unpushed rows with an id above afterId.
+    // Rows whose reports_to, employeeId or reviewerId names an employee never pushed are held back until that
+    // employee has its server id
+    std::optional<std::vector<VersionedRow<Employee>>> getDirtyEmployees(int afterEmployeeId, std::size_t limit);
+    std::optional<std::vector<VersionedRow<PerformanceReview>>> getDirtyPerformanceReviews(int afterReviewId,
+                                                                                          std::size_t limit);
+    // 2. markEmployeesSynced / markPerformanceReviewsSynced : record pushed versions in one transaction,
+    // a row edited again since it was read stays dirty
+    bool markEmployeesSynced(const std::vector<SyncedVersion>& versions);
+    bool markPerformanceReviewsSynced(const std::vector<SyncedVersion>& versions);
+    // 3. applyRemoteEmployees / applyRemotePerformanceReviews : upsert rows pulled from the server as synced,
+    // rows with unpushed local edits are left alone; inserted counts the rows actually written. A row created
+    // offline that sits on a pulled id is moved to a fresh local id first
+    BulkImportResult applyRemoteEmployees(const std::vector<Employee>& employees);
+    BulkImportResult applyRemotePerformanceReviews(const std::vector<PerformanceReview>& reviews);
+    // 4. named pull watermarks, 0 until first set
+    std::int64_t syncWatermark(const std::string& name);
+    bool setSyncWatermark(const std::string& name, std::int64_t value);
+    // 5. adoptServerEmployeeIds / adoptServerReviewIds : renumber rows created offline to the ids their POST was
+    // given and record the pushed versions, in one transaction. Rows referencing a renumbered employee follow
+    // it and turn dirty, so the corrected references are pushed too
+    bool adoptServerEmployeeIds(const std::vector<AssignedId>& assigned);
+    bool adoptServerReviewIds(const std::vector<AssignedId>& assigned);
+
+    // ---- Review archive ----
+    // Reviews of closed years live in one compacted file per year next to the database, attached read-only to
+    // every connection. Review reads see the hot table and the archives as one; date-bounded review lists only
+    // touch the partitions whose year overlaps the range. Archived reviews can no longer be updated, deleted or
+    // synced, so archive a year only once it is closed and pushed. SQLite attaches at most 10 databases per
+    // connection (SQLITE_MAX_ATTACHED) and archiving needs one of them, so at most 9 years can be archived
+    // unless sqlite is built with a higher limit.
+
+    // 1. archiveReviewsBefore : move every review dated before January 1st of year into its year's archive,
+    // creating or extending it, then VACUUM the hot file; false if any step failed, in which case no review has
+    // left the hot table. Holds the writer throughout; a read running while the archives switch over may see a
+    // moved review twice.
+    bool archiveReviewsBefore(int year);
+    // 2. reviewArchives : the archived years, oldest first
+    std::vector<ReviewArchive> reviewArchives() const;
+
+    // ---- Snapshots ----
+
+    // 1. writeSnapshot : every employee and review, read in one transaction, as a binary snapshot file
+    bool writeSnapshot(const std::string& path);
+    // 2. importSnapshot : bulk insert the rows of a snapshot, e.g. to seed a node from a shipped dataset
+    BulkImportResult importSnapshot(const Snapshot& snapshot);
+
+    // ---- Write-behind ----
+
+    // 1. enableWriteBehind : start a writer thread that commits the submit* review writes in group transactions
+    // bounded by config.maxBatchSize / maxBatchDelay. Call before sharing the manager between threads.
+    void enableWriteBehind(const WriteBehindConfig& config = {});
+    // 2. flushWriteBehind : block until every write submitted so far has been committed or failed
+    void flushWriteBehind();
+    // 3. writeBehindBacklog : writes submitted and not yet committed, 0 while disabled
+    std::size_t writeBehindBacklog() const;
+
+    // ---- Read cache ----
+
+    // 1. enableReadCache : bounded LRU caches in front of getEmployee / getEmployees and getPerformanceReview,
+    // invalidated by the mutators; capacity 0 disables them. Call before sharing the manager between threads.
+    void enableReadCache(std::size_t employeeCapacity, std::size_t reviewCapacity);
+    // 2. hit/miss counters, all zero while the cache is disabled
+    LruCacheStats employeeCacheStats() const;
+    LruCacheStats reviewCacheStats() const;
+
+    // ---- Change feed ----
+
+    // 1. enableChangeFeed : publish a ChangeEvent for every committed employee and review mutation, in commit
+    // order, into a ring of capacity events. Call before sharing the manager between threads.
+    void enableChangeFeed(std::size_t capacity = DEFAULT_CHANGE_FEED_CAPACITY);
+    // 2. changeFeed : subscribe here to keep a derived view current without rescanning the tables;
+    // nullptr while disabled
+    const ChangeFeed* changeFeed() const;
+
+    // ---- Diagnostics ----
+
+    // prepared statement cache counters
+    std::size_t statementCacheHits() const;
+    std::size_t statementCacheMisses() const;
 
 private:
-    sqlite::database db;
-    // lambda getter which is fed into db << operator and populates employee(s)
-    std::function<void(int, std::string, std::string, int, std::string, int, bool)>
-    getMultipleEmployeeCollector(std::vector<Employee>& employees, bool& isFound) const;
+    // writer connection plus optional read-only connections, each with its own statement cache
+    ConnectionPool pool;
+    std::string dbAddress;
+
+    // archived years, attached to every connection through the pool's connection setup
+    std::vector<ReviewArchive> archives;
+    mutable std::mutex archivesMutex;
+    // read the archived years from the database and attach them; every connection attaches them on its next lease
+    bool loadReviewArchives();
+    void attachReviewArchives(std::vector<ReviewArchive> archived);
+
+    // read-through caches, nullptr while disabled
+    std::unique_ptr<LruCache<int, Employee>> employeeCache;
+    std::unique_ptr<LruCache<int, PerformanceReview>> reviewCache;
+
+    // reporting hierarchy, only maintained once enabled; mutated while holding the writer
+    OrgChartIndex orgChart;
+    std::atomic<bool> orgChartEnabled{false};
+    // reload orgChart from the employees table
+    bool rebuildOrgChart();
+
+    // search indexes, only maintained once enabled; mutated while holding the writer
+    SearchIndex employeeNames;
+    SearchIndex reviewComments;
+    std::atomic<bool> searchEnabled{false};
+    // reload employeeNames / reviewComments from their tables
+    bool rebuildEmployeeNameIndex();
+    bool rebuildReviewCommentIndex();
+
+    // review rollups over orgChart, only maintained once enabled; mutated while holding the writer
+    TeamAnalytics teamRollups{orgChart};
+    std::atomic<bool> teamAnalyticsEnabled{false};
+    // reload teamRollups from the performance_reviews table
+    bool rebuildTeamAnalytics();
 
-    // lambda getter which is fed into db << operator and populates employee
-    std::function<void(int, std::string, int, std::string, std::string, int, bool)>
-    getSingleEmployeeCollector(Employee& employee, bool& isFound) const;
+    // hand a write to the write-behind queue, or commit it as a group of one while that is disabled
+    std::future<WriteResult> submitWrite(WriteKind kind, const PerformanceReview& review);
+    // commit a write-behind group in one transaction and resolve its promises; a failing write only fails itself
+    void commitWriteGroup(std::vector<PendingWrite>& group);
+    // bring the read cache, the in-memory indexes and the change feed in line with a written / deleted review,
+    // holding the writer
+    void reviewWritten(const PerformanceReview& review, ChangeKind kind);
+    void reviewDeleted(int reviewId);
+    void employeeWritten(const Employee& employee, ChangeKind kind);
 
-    // lambda getter which is fed into db << operator and populates performanceReview
-    std::function<void(int, int, int, std::string, float, std::string, float, float, float, float, float, float, float,
-                       float, float, float)>
-    getPerformanceReviewCollector(PerformanceReview& review, bool& isFound) const;
-    // map database entry to Employee datastructure
+    // shared driver of the review list pages; filter is bound to the placeholder in front of the keyset.
+    // query is the statement text, or a route that picks it for the connection the page is read from
+    template <typename Query, typename Filter>
+    std::optional<ReviewPage> getReviewPage(const char* tag, const Query& query, const Filter& filter,
+                                            const ReviewCursor& after, std::size_t pageSize);
 
-    // map performance review to PerformanceReview data structure
+    // shared driver of markEmployeesSynced / markPerformanceReviewsSynced
+    bool markSynced(const char* tag, const std::string& sql, const std::vector<SyncedVersion>& versions);
+
+    // shared driver of the id renumbering in adoptServer*Ids and applyRemote*: runs step in one transaction on
+    // the writer, then reloads the rows it reports as changed
+    template <typename Step>
+    bool renumberRows(const char* tag, Step&& step);
+    // bring the caches, indexes and change feed in line with the rows now holding these ids, holding the writer;
+    // an id no row holds any more is dropped
+    void reloadRows(PooledConnection& connection, std::vector<int> employeeIds, std::vector<int> reviewIds);
+
+    // shared driver of addEmployees / addPerformanceReviews / applyRemote*
+    // committed is called with every written row as stored, once its batch committed, still holding the writer
+    // sql takes the row's mapped columns in RowMapping order, bound with bindRow
+    template <typename Row, typename Validator, typename Committed>
+    BulkImportResult bulkInsert(const char* tag, const std::string& sql, const std::vector<Row>& rows,
+                                std::size_t batchSize, Validator&& validate, Committed&& committed);
+
+    // committed mutations for subscribers, nullptr while disabled; published while holding the writer, which
+    // keeps a single producer and commit order
+    std::unique_ptr<ChangeFeed> changeEvents;
+    void publishChange(ChangeKind kind, int employeeId, int reviewId = 0);
+
+    // write-behind queue, nullptr while disabled; last, so it drains while everything it writes to still exists
+    std::unique_ptr<WriteBehindQueue> writeBehind;
 
 protected:
 };
 
+template <typename Visitor>
+bool DatabaseManager::forEachEmployee(Visitor&& visitor) {
+    auto cursor = streamAllEmployees();
+    while (cursor.next()) {
+        if constexpr (std::is_same_v<decltype(visitor(cursor.current())), bool>) {
+            if (!visitor(cursor.current())) {
+                break;
+            }
+        } else {
+            visitor(cursor.current());
+        }
+    }
+    return cursor.ok();
+}
+
 } // namespace PerfMgmt
 
 #endif // DATABASEMANAGER_HPP
\ No newline at end of file
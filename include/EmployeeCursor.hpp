@@ -0,0 +1,69 @@
+#ifndef EMPLOYEECURSOR_HPP
+#define EMPLOYEECURSOR_HPP
+
+#include <ConnectionPool.hpp>
+#include <Models.hpp>
+#include <cstddef>
+#include <iterator>
+#include <sqlite3.h>
+#include <string>
+
+namespace PerfMgmt {
+
+// Forward-only scan over the employees table. Rows are decoded one at a time
+// into a single reused Employee, so memory stays constant whatever the table
+// size. The cursor keeps its pooled connection until it is destroyed.
+//
+//     for (const Employee& employee : db.streamAllEmployees()) { ... break; }
+class EmployeeCursor {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Employee;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Employee*;
+        using reference = const Employee&;
+
+        reference operator*() const;
+        pointer operator->() const;
+        iterator& operator++();
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+
+    private:
+        friend class EmployeeCursor;
+        explicit iterator(EmployeeCursor* cursor);
+        // nullptr once the cursor is exhausted
+        EmployeeCursor* cursor;
+    };
+
+    EmployeeCursor(ConnectionPool::Lease connection, const std::string& sql);
+    EmployeeCursor(EmployeeCursor&& other) noexcept;
+    EmployeeCursor(const EmployeeCursor& other) = delete;
+    EmployeeCursor& operator=(const EmployeeCursor& other) = delete;
+    ~EmployeeCursor();
+
+    // step to the next row, false at the end of the table or on error
+    bool next();
+    // row the cursor currently points at, overwritten by next()
+    const Employee& current() const;
+    // false if preparing or stepping the statement failed
+    bool ok() const;
+
+    // single pass: begin() fetches the first row
+    iterator begin();
+    iterator end();
+
+private:
+    void readRow();
+
+    ConnectionPool::Lease connection;
+    sqlite3_stmt* stmt{nullptr};
+    Employee row;
+    bool isOk{true};
+};
+
+} // namespace PerfMgmt
+
+#endif // EMPLOYEECURSOR_HPP
@@ -0,0 +1,243 @@
+#ifndef JSONSTREAMDECODER_HPP
+#define JSONSTREAMDECODER_HPP
+
+#include <Models.hpp>
+#include <RowMapping.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace PerfMgmt {
+
+// A leaf value of a JSON document. text views the decoder's scratch buffer and
+// is only valid until the handler returns.
+struct JsonScalar {
+    enum class Type {
+        String,
+        Number,
+        Boolean,
+        Null
+    };
+    Type type{Type::Null};
+    // unescaped contents for strings, the literal for numbers
+    std::string_view text;
+    bool boolean{false};
+
+    bool isNull() const { return type == Type::Null; }
+    std::optional<int> asInt() const;
+    std::optional<std::int64_t> asInt64() const;
+    std::optional<float> asFloat() const;
+    std::optional<bool> asBool() const;
+    std::optional<std::string_view> asString() const;
+};
+
+// Push parser for a top-level JSON array of objects, fed in chunks of any size.
+// Only object fields with scalar values are reported, nested arrays and objects are skipped.
+// Nothing but the current key and value is buffered, so memory does not grow with the payload.
+class JsonArrayStreamParser {
+public:
+    JsonArrayStreamParser() = default;
+    virtual ~JsonArrayStreamParser() = default;
+
+    // consume the next chunk; false once the input is malformed or a handler rejected it
+    bool feed(const char* data, std::size_t length);
+    // true if the whole array was consumed without errors
+    bool finish();
+    bool failed() const;
+    const std::string& error() const;
+
+protected:
+    virtual void onRecordBegin() = 0;
+    // returning false aborts the parse
+    virtual bool onField(std::string_view key, const JsonScalar& value) = 0;
+    virtual bool onRecordEnd() = 0;
+    void fail(const std::string& message);
+
+private:
+    enum class State {
+        BeforeArray,
+        BeforeFirstRecord,
+        BeforeRecord,
+        AfterRecord,
+        BeforeFirstKey,
+        BeforeKey,
+        InKey,
+        AfterKey,
+        BeforeValue,
+        InString,
+        InLiteral,
+        AfterValue,
+        InNested,
+        Done,
+        Failed
+    };
+
+    // consume string characters into target until the closing quote, returns the position after it or end
+    const char* readString(const char* pos, const char* end, std::string& target, bool& closed);
+    bool appendEscape(char c, std::string& target);
+    bool emitLiteral();
+    bool emitField(const JsonScalar& value);
+
+    State state{State::BeforeArray};
+    std::string key;
+    std::string scratch;
+    std::string errorMessage;
+    // escape handling carried across chunk boundaries
+    bool inEscape{false};
+    int unicodeDigits{-1};
+    std::uint32_t unicodeValue{0};
+    std::uint32_t highSurrogate{0};
+    // nested value being skipped
+    int nestedDepth{0};
+    bool nestedInString{false};
+    bool nestedEscape{false};
+    std::size_t offset{0};
+};
+
+enum class JsonFieldResult {
+    Stored,
+    Unknown,
+    Invalid
+};
+
+namespace mapping {
+// JSON scalar -> field, false if the value has the wrong type
+inline bool readScalar(const JsonScalar& value, int& target) {
+    auto parsed = value.asInt();
+    target = parsed.value_or(target);
+    return parsed.has_value();
+}
+inline bool readScalar(const JsonScalar& value, float& target) {
+    auto parsed = value.asFloat();
+    target = parsed.value_or(target);
+    return parsed.has_value();
+}
+inline bool readScalar(const JsonScalar& value, bool& target) {
+    auto parsed = value.asBool();
+    target = parsed.value_or(target);
+    return parsed.has_value();
+}
+inline bool readScalar(const JsonScalar& value, std::string& target) {
+    auto text = value.asString();
+    if (text) {
+        target.assign(text->data(), text->size());
+    }
+    return text.has_value();
+}
+inline bool readScalar(const JsonScalar& value, Role& target) {
+    auto text = value.asString();
+    auto role = text ? stringToRole(*text) : std::nullopt;
+    target = role.value_or(target);
+    return role.has_value();
+}
+template <typename T>
+bool readScalar(const JsonScalar& value, std::optional<T>& target) {
+    if (value.isNull()) {
+        target.reset();
+        return true;
+    }
+    return readScalar(value, target ? *target : target.emplace());
+}
+} // namespace mapping
+
+// Field mapping of a row type for JsonRowDecoder, generated from RowMapping<Row>. assign() stores one field and
+// marks its bit in seen; a record is accepted once every bit of required is set, the same keys from_json needs.
+template <typename Row>
+struct JsonRowFields {
+    static constexpr unsigned requiredFields() {
+        unsigned bits = 0;
+        mapping::forEachField<Row>([&bits](const auto& field, auto index) {
+            using T = typename std::decay_t<decltype(field)>::Type;
+            if (!mapping::IsOptional<T>::value && !(field.flags & JSON_DEFAULTED)) {
+                bits |= 1u << index();
+            }
+        });
+        return bits;
+    }
+
+    static constexpr unsigned required = requiredFields();
+
+    static JsonFieldResult assign(Row& row, std::string_view key, const JsonScalar& value, unsigned& seen) {
+        static_assert(fieldCount<Row> <= 32, "one bit of seen per field");
+        JsonFieldResult result = JsonFieldResult::Unknown;
+        mapping::forEachField<Row>([&](const auto& field, auto index) {
+            if (result != JsonFieldResult::Unknown || key != field.jsonKey) {
+                return;
+            }
+            using T = typename std::decay_t<decltype(field)>::Type;
+            auto& target = row.*field.member;
+            bool stored{false};
+            if constexpr (!mapping::IsOptional<T>::value) {
+                if ((field.flags & JSON_DEFAULTED) && value.isNull()) {
+                    target = T{};
+                    stored = true;
+                } else {
+                    stored = mapping::readScalar(value, target);
+                }
+            } else {
+                stored = mapping::readScalar(value, target);
+            }
+            if (stored) {
+                seen |= 1u << index();
+            }
+            result = stored ? JsonFieldResult::Stored : JsonFieldResult::Invalid;
+        });
+        return result;
+    }
+};
+
+// Decodes a JSON array of rows straight into rows.emplace_back(), without building a DOM
+// and without temporary row copies.
+template <typename Row>
+class JsonRowDecoder : public JsonArrayStreamParser {
+public:
+    // called for keys the row type does not know, e.g. the sync version
+    using ExtraFieldHandler = std::function<void(std::string_view key, const JsonScalar& value)>;
+
+    explicit JsonRowDecoder(std::vector<Row>& rows, ExtraFieldHandler extra = nullptr)
+        : rows(rows), extra(std::move(extra)) {}
+
+protected:
+    void onRecordBegin() override {
+        rows.emplace_back();
+        seen = 0;
+    }
+
+    bool onField(std::string_view key, const JsonScalar& value) override {
+        switch (JsonRowFields<Row>::assign(rows.back(), key, value, seen)) {
+        case JsonFieldResult::Invalid:
+            fail("invalid value for \"" + std::string(key) + "\"");
+            return false;
+        case JsonFieldResult::Unknown:
+            if (extra) {
+                extra(key, value);
+            }
+            break;
+        case JsonFieldResult::Stored:
+            break;
+        }
+        return true;
+    }
+
+    bool onRecordEnd() override {
+        if ((seen & JsonRowFields<Row>::required) != JsonRowFields<Row>::required) {
+            fail("record " + std::to_string(rows.size() - 1) + " is missing required fields");
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector<Row>& rows;
+    ExtraFieldHandler extra;
+    unsigned seen{0};
+};
+
+} // namespace PerfMgmt
+
+#endif // JSONSTREAMDECODER_HPP
@@ -0,0 +1,200 @@
+#ifndef KPICOLUMNSTORE_HPP
+#define KPICOLUMNSTORE_HPP
+
+#include <Models.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace PerfMgmt {
+
+enum class Kpi {
+    PUNCTUALITY,
+    QUALITY_OF_WORK,
+    COMMUNICATION,
+    TEAMWORK,
+    TECHNICAL_SKILLS,
+    PROBLEM_SOLVING,
+    CREATIVITY,
+    ADAPTABILITY,
+    LEADERSHIP,
+    INITIATIVE
+};
+
+constexpr std::size_t KPI_COUNT = 10;
+
+inline std::string kpiToString(Kpi kpi) {
+    switch (kpi) {
+    case Kpi::PUNCTUALITY:
+        return "punctuality";
+    case Kpi::QUALITY_OF_WORK:
+        return "qualityOfWork";
+    case Kpi::COMMUNICATION:
+        return "communication";
+    case Kpi::TEAMWORK:
+        return "teamwork";
+    case Kpi::TECHNICAL_SKILLS:
+        return "technicalSkills";
+    case Kpi::PROBLEM_SOLVING:
+        return "problemSolving";
+    case Kpi::CREATIVITY:
+        return "creativity";
+    case Kpi::ADAPTABILITY:
+        return "adaptability";
+    case Kpi::LEADERSHIP:
+        return "leadership";
+    case Kpi::INITIATIVE:
+        return "initiative";
+    default:
+        return "unknown";
+    }
+}
+
+// value of one KPI in an array-of-structs review
+inline float kpiValue(const PerformanceReview& review, Kpi kpi) {
+    switch (kpi) {
+    case Kpi::PUNCTUALITY:
+        return review.punctualityRating;
+    case Kpi::QUALITY_OF_WORK:
+        return review.qualityOfWorkRating;
+    case Kpi::COMMUNICATION:
+        return review.communicationRating;
+    case Kpi::TEAMWORK:
+        return review.teamworkRating;
+    case Kpi::TECHNICAL_SKILLS:
+        return review.technicalSkillsRating;
+    case Kpi::PROBLEM_SOLVING:
+        return review.problemSolvingRating;
+    case Kpi::CREATIVITY:
+        return review.creativityRating;
+    case Kpi::ADAPTABILITY:
+        return review.adaptabilityRating;
+    case Kpi::LEADERSHIP:
+        return review.leadershipRating;
+    case Kpi::INITIATIVE:
+        return review.initiativeRating;
+    default:
+        return 0.0f;
+    }
+}
+
+// allocator handing out storage aligned for full-width vector loads
+template <typename T, std::size_t Alignment = 32>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {
+    }
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* pointer, std::size_t) {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const {
+        return false;
+    }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Summary of one KPI over a set of reviews
+struct KpiStats {
+    std::size_t count{0};
+    float mean{0.0f};
+    float min{0.0f};
+    float max{0.0f};
+    float stddev{0.0f}; // population standard deviation
+    // histogram[k] counts ratings that round to k + 1
+    std::array<std::uint32_t, 10> histogram{};
+};
+
+namespace kernels {
+
+// running totals of a rating column
+struct Moments {
+    std::size_t count{0};
+    double sum{0.0};
+    double sumOfSquares{0.0};
+    float min{0.0f};
+    float max{0.0f};
+};
+
+// name of the instruction set the kernels were compiled for: "avx2", "sse2" or "scalar"
+const char* instructionSet();
+
+// vectorized kernels, the scalar fallback is used when neither SSE2 nor AVX2 is available
+Moments moments(const float* values, std::size_t count);
+void histogram(const float* values, std::size_t count, std::array<std::uint32_t, 10>& bins);
+
+// plain loops, kept as reference for the vectorized versions
+Moments momentsScalar(const float* values, std::size_t count);
+void histogramScalar(const float* values, std::size_t count, std::array<std::uint32_t, 10>& bins);
+
+KpiStats toStats(const Moments& moments, const std::array<std::uint32_t, 10>& bins);
+
+} // namespace kernels
+
+// Struct-of-arrays copy of the reviews: every KPI lives in its own aligned float
+// column so aggregations stream through contiguous memory.
+class KpiColumnStore {
+public:
+    // contiguous range of rows sharing one key after clusterBy()
+    struct Group {
+        int key{};
+        std::size_t first{};
+        std::size_t last{};
+    };
+
+    void reserve(std::size_t count);
+    void append(const PerformanceReview& review);
+    void append(int employeeId, int reviewerId, const std::array<float, KPI_COUNT>& ratings);
+    void clear();
+    std::size_t size() const;
+
+    const float* column(Kpi kpi) const;
+    const AlignedVector<int>& employeeIds() const;
+    const AlignedVector<int>& reviewerIds() const;
+
+    // statistics of one KPI over all rows, or over the rows [first, last)
+    KpiStats aggregate(Kpi kpi) const;
+    KpiStats aggregate(Kpi kpi, std::size_t first, std::size_t last) const;
+
+    // reorder the rows so that rows with the same key (e.g. team or reviewer) are
+    // contiguous in every column; keyOf receives (employeeId, reviewerId)
+    void clusterBy(const std::function<int(int, int)>& keyOf);
+    void clusterByReviewer();
+    // groups found by the last clusterBy(), ordered by key
+    const std::vector<Group>& groups() const;
+
+    // one KpiStats per group of the last clusterBy(), in group order
+    std::vector<KpiStats> rollup(Kpi kpi) const;
+
+private:
+    std::array<AlignedVector<float>, KPI_COUNT> columns;
+    AlignedVector<int> employees;
+    AlignedVector<int> reviewers;
+    std::vector<Group> clusters;
+};
+
+} // namespace PerfMgmt
+
+#endif // KPICOLUMNSTORE_HPP
@@ -0,0 +1,145 @@
+#ifndef LRUCACHE_HPP
+#define LRUCACHE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace PerfMgmt {
+
+struct LruCacheStats {
+    std::size_t hits{0};
+    std::size_t misses{0};
+    std::size_t size{0};
+    std::size_t capacity{0};
+
+    double hitRate() const {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+};
+
+// Bounded least-recently-used cache, split into independently locked shards so
+// concurrent readers of different keys rarely contend.
+//
+// Read-through callers take a version() before loading a value and pass it to
+// put(); an erase() of the same shard in between makes the put() a no-op, so a
+// reader racing with a writer can never re-insert a stale value.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    explicit LruCache(std::size_t capacity, std::size_t shardCount = 8) : totalCapacity(capacity) {
+        shardCount = std::max<std::size_t>(1, std::min(shardCount, capacity));
+        for (std::size_t i = 0; i < shardCount; ++i) {
+            // spread the capacity, the first shards take the remainder
+            shards.push_back(std::make_unique<Shard>(capacity / shardCount + (i < capacity % shardCount ? 1 : 0)));
+        }
+    }
+    LruCache(const LruCache& other) = delete;
+    LruCache& operator=(const LruCache& other) = delete;
+
+    std::optional<Value> get(const Key& key) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            missCount.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return it->second->second;
+    }
+
+    // invalidation counter of the shard holding key
+    std::uint64_t version(const Key& key) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.version;
+    }
+
+    // insert or refresh key unless the shard was invalidated after expectedVersion
+    void put(const Key& key, Value value, std::uint64_t expectedVersion) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.version != expectedVersion || shard.capacity == 0) {
+            return;
+        }
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            it->second->second = std::move(value);
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            return;
+        }
+        if (shard.entries.size() == shard.capacity) {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+        }
+        shard.entries.emplace_front(key, std::move(value));
+        shard.index.emplace(key, shard.entries.begin());
+    }
+
+    void erase(const Key& key) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ++shard.version;
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+    }
+
+    void clear() {
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            ++shard->version;
+            shard->entries.clear();
+            shard->index.clear();
+        }
+    }
+
+    LruCacheStats stats() const {
+        LruCacheStats result;
+        result.hits = hitCount.load(std::memory_order_relaxed);
+        result.misses = missCount.load(std::memory_order_relaxed);
+        result.capacity = totalCapacity;
+        for (const auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            result.size += shard->entries.size();
+        }
+        return result;
+    }
+
+private:
+    struct Shard {
+        explicit Shard(std::size_t capacity) : capacity(capacity) {
+        }
+        std::mutex mutex;
+        std::size_t capacity;
+        std::uint64_t version{0};
+        std::list<std::pair<Key, Value>> entries; // most recently used first
+        std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index;
+    };
+
+    Shard& shardOf(const Key& key) {
+        return *shards[Hash{}(key) % shards.size()];
+    }
+
+    std::size_t totalCapacity;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<std::size_t> hitCount{0};
+    std::atomic<std::size_t> missCount{0};
+};
+
+} // namespace PerfMgmt
+
+#endif // LRUCACHE_HPP
@@ -0,0 +1,132 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace PerfMgmt {
+
+// Monotonic counter, only counts while metrics are enabled
+class Counter {
+public:
+    void add(std::uint64_t amount = 1);
+    std::uint64_t value() const { return count.load(std::memory_order_relaxed); }
+    void reset() { count.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> count{0};
+};
+
+// Latency distribution in power-of-two microsecond buckets, recorded without locks.
+// Bucket i counts durations below 2^i us, the last bucket everything longer.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t BUCKET_COUNT = 24;
+
+    struct Snapshot {
+        std::array<std::uint64_t, BUCKET_COUNT> buckets{};
+        std::uint64_t count{0};
+        std::uint64_t sumNanoseconds{0};
+        // upper bound of the bucket holding the q-quantile, in seconds
+        double quantile(double q) const;
+    };
+
+    void record(std::chrono::nanoseconds elapsed);
+    Snapshot snapshot() const;
+    void reset();
+    // inclusive upper bound of bucket index in seconds, infinity for the last one
+    static double upperBoundSeconds(std::size_t index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sumNanoseconds{0};
+};
+
+// latency and failures of one named operation
+struct OperationMetrics {
+    LatencyHistogram latency;
+    Counter errors;
+};
+
+// Process-wide metrics of the database and network layers.
+// Disabled by default (or enabled by PERFMGMT_METRICS=1 in the environment); while disabled every
+// recording call is a single relaxed load.
+class Metrics {
+public:
+    static Metrics& instance();
+
+    static bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enable) { enabledFlag.store(enable, std::memory_order_relaxed); }
+
+    // registered on first use; the reference stays valid for the life of the process
+    OperationMetrics& operation(const std::string& subsystem, const std::string& name);
+
+    // ---- database ----
+    Counter dbRowsRead;
+    Counter dbRowsWritten;
+    // statements that failed with SQLITE_BUSY after the busy timeout ran out
+    Counter dbBusyErrors;
+    // waits of the busy handler on a locked database
+    Counter dbBusyRetries;
+
+    // ---- network ----
+    Counter httpBytesSent;
+    Counter httpBytesReceived;
+    // requests repeated after a transient failure
+    Counter httpRetries;
+    // count a response by status class; 0 means the request got no response
+    void recordHttpStatus(int status);
+
+    // exposition formats
+    std::string toPrometheus() const;
+    std::string toJson() const;
+    // zero every counter and histogram, registrations are kept
+    void reset();
+
+private:
+    Metrics();
+
+    static std::atomic<bool> enabledFlag;
+
+    // index status / 100, 0 for no response
+    std::array<Counter, 6> httpResponses;
+    mutable std::mutex operationsMutex;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<OperationMetrics>> operations;
+};
+
+// Times one call and records it into an operation when it goes out of scope.
+// Takes no clock reading while metrics are disabled.
+class OperationTimer {
+public:
+    explicit OperationTimer(OperationMetrics& operation);
+    OperationTimer(const OperationTimer& other) = delete;
+    OperationTimer& operator=(const OperationTimer& other) = delete;
+    ~OperationTimer();
+
+    // count the call as failed
+    void fail() { failed = true; }
+
+private:
+    OperationMetrics* operation;
+    std::chrono::steady_clock::time_point start;
+    bool failed{false};
+};
+
+inline void Counter::add(std::uint64_t amount) {
+    if (Metrics::enabled()) {
+        count.fetch_add(amount, std::memory_order_relaxed);
+    }
+}
+
+} // namespace PerfMgmt
+
+#endif // METRICS_HPP
@@ -1,10 +1,12 @@
 #ifndef MODELS_HPP
 #define MODELS_HPP
+#include <cstddef>
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 using json = nlohmann::json;
 namespace PerfMgmt {
@@ -16,6 +18,8 @@ enum class Role {
     TECHNICIAN
 };
 
+constexpr std::size_t ROLE_COUNT = 4;
+
 inline std::string roleToString(Role role) {
     switch (role) {
     case Role::MANAGER:
@@ -43,7 +47,7 @@ inline std::ostream& operator<<(std::ostream& os, Role role) {
 }
 
 // Helper function to convert string to Role enum
-inline std::optional<Role> stringToRole(const std::string& roleStr) {
+inline std::optional<Role> stringToRole(std::string_view roleStr) {
     if (roleStr == "Manager") {
         return Role::MANAGER;
     } else if (roleStr == "Boss") {
@@ -166,6 +170,9 @@ struct PerformanceReview {
     float initiativeRating{0.0};
     std::optional<std::string> comments;
 
+    friend void to_json(json& j, const PerformanceReview& review);
+    friend void from_json(const json& j, PerformanceReview& review);
+
     // default constructor
     PerformanceReview() {
     }
@@ -0,0 +1,85 @@
+#ifndef MPSCQUEUE_HPP
+#define MPSCQUEUE_HPP
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace PerfMgmt {
+
+// Unbounded multi-producer, single-consumer FIFO queue (Vyukov's intrusive node queue).
+//
+// push() is one atomic exchange plus one store and never waits on other producers or the consumer, so any
+// number of threads can enqueue without a lock. pop() must only ever be called from one thread at a time.
+// A producer that was preempted between its exchange and its store briefly hides the items queued after it:
+// pop() then reports the queue as empty and the consumer simply tries again later.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head(&stub), tail(&stub) {}
+    MpscQueue(const MpscQueue& other) = delete;
+    MpscQueue& operator=(const MpscQueue& other) = delete;
+    ~MpscQueue() {
+        while (pop()) {
+        }
+    }
+
+    void push(T value) {
+        Node* node = new Node{std::move(value)};
+        Node* previous = head.exchange(node, std::memory_order_seq_cst);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // consumer only; nullopt if nothing is (visibly) queued
+    std::optional<T> pop() {
+        Node* first = tail;
+        Node* next = first->next.load(std::memory_order_acquire);
+        if (first == &stub) {
+            if (!next) {
+                return std::nullopt;
+            }
+            // step over the stub, it only keeps the list non-empty
+            tail = next;
+            first = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (!next) {
+            // first is the last node; unless a push is under way, requeue the stub behind it to detach it
+            if (first != head.load(std::memory_order_acquire)) {
+                return std::nullopt;
+            }
+            stub.next.store(nullptr, std::memory_order_relaxed);
+            Node* previous = head.exchange(&stub, std::memory_order_seq_cst);
+            previous->next.store(&stub, std::memory_order_release);
+            next = first->next.load(std::memory_order_acquire);
+            if (!next) {
+                return std::nullopt;
+            }
+        }
+        tail = next;
+        std::optional<T> value(std::move(*first->value));
+        delete first;
+        return value;
+    }
+
+    // consumer only; false as soon as a push has swung head, even if its item is not visible to pop() yet
+    bool empty() const {
+        return tail == &stub && !stub.next.load(std::memory_order_acquire) &&
+               head.load(std::memory_order_seq_cst) == &stub;
+    }
+
+private:
+    struct Node {
+        std::optional<T> value;
+        std::atomic<Node*> next{nullptr};
+    };
+
+    Node stub;
+    // producers swing head to their node; the consumer owns tail
+    std::atomic<Node*> head;
+    Node* tail;
+};
+
+} // namespace PerfMgmt
+
+#endif // MPSCQUEUE_HPP
@@ -1,18 +1,41 @@
 #ifndef NETWORKMANAGERHPP
 #define NETWORKMANAGERHPP
+#include <JsonStreamDecoder.hpp>
 #include <Models.hpp>
+#include <WireFormat.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using json = nlohmann::json;
 
 namespace PerfMgmt {
 
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+// httplib was built with zlib and can take gzip bodies
+constexpr bool HTTP_COMPRESSION_AVAILABLE = true;
+#else
+constexpr bool HTTP_COMPRESSION_AVAILABLE = false;
+#endif
+
+// rows the server changed after a watermark, and the highest server version among them
+template <typename Row>
+struct ChangeSet {
+    std::vector<Row> rows;
+    std::int64_t watermark{0};
+};
+
 class NetworkManager {
 public:
+    // ids per multi-fetch request, the most the server answers at once
+    static constexpr std::size_t MULTI_FETCH_IDS = 500;
+
     // httpllib::Client does not have default constructor
     NetworkManager() = delete;
     // Constructor, takes the server base URL of server API
@@ -29,6 +52,10 @@ public:
     // Fetch a single employee by server Id
     std::optional<Employee> fetchSingleEmployee(int employeeId);
 
+    // Fetch several employees in one request per MULTI_FETCH_IDS ids (GET /api/employees?ids=) instead of one
+    // per employee; slot i answers employeeIds[i], empty if the server has no such employee
+    std::optional<std::vector<std::optional<Employee>>> fetchEmployees(const std::vector<int>& employeeIds);
+
     // send a new employee to the server
     // returns the server assigned Id if successful
     std::optional<int> sendNewEmployee(const Employee& employee);
@@ -36,32 +63,79 @@ public:
     // Update an existing employee on the server
     bool sendUpdatedEmployee(int serverEmployeeId, const Employee& employee);
 
+    // Fetch employees changed on the server after version since (GET /api/employees?since=)
+    std::optional<ChangeSet<Employee>> fetchEmployeesSince(std::int64_t since);
+
     // ----- Review API Calls -----
 
     // Fetch reviews for a specific employee from the server
     std::optional<std::vector<PerformanceReview>> fetchReviewsForEmployee(int serverEmployeeId);
 
+    // Fetch the latest review of several employees the same way (GET /api/reviews?latestFor=); slot i answers
+    // serverEmployeeIds[i], empty if that employee has no review on the server
+    std::optional<std::vector<std::optional<PerformanceReview>>>
+    fetchLatestReviewsForEmployees(const std::vector<int>& serverEmployeeIds);
+
     // send a new review to the server
     std::optional<int> sendNewReview(int serverEmployeeId, const PerformanceReview& review);
 
     // update an existing review to the server
     bool updateReview(int serverReviewId, const PerformanceReview& review);
+
+    // Fetch reviews changed on the server after version since (GET /api/reviews?since=)
+    std::optional<ChangeSet<PerformanceReview>> fetchReviewsSince(std::int64_t since);
+
+    // ----- Transfer encoding -----
+
+    // Body format asked for on row list fetches. The server may still answer JSON, e.g. when it has no encoder
+    // for the format; the answer is read by its Content-Type either way.
+    void setWireFormat(WireFormat format);
+    WireFormat wireFormat() const;
+    // Ask for gzip bodies on every GET, on by default when HTTP_COMPRESSION_AVAILABLE.
+    // Returns whether compression is on, which it never is without zlib.
+    bool setCompression(bool enabled);
+
+    // HTTP status of the last request, 0 if it never got a response
+    int lastStatusCode() const;
+    // true if the last request failed before any of it reached the server, so even a POST can be repeated
+    bool lastRequestUnsent() const;
     ~NetworkManager() {};
 
 private:
     std::string baseUrl;
     httplib::Client httpClient;
+    int lastStatus{0};
+    httplib::Error lastError{httplib::Error::Success};
+    WireFormat listFormat{WireFormat::JSON};
+    bool compression{HTTP_COMPRESSION_AVAILABLE};
+
+    // GET an array of rows and decode it, a JSON one while it streams in; extra receives keys Row does not map
+    template <typename Row>
+    std::optional<std::vector<Row>> fetchRows(const std::string& path, const char* tag,
+                                              std::function<void(std::string_view, const JsonScalar&)> extra = nullptr);
+    // GET query + comma separated ids in batches of MULTI_FETCH_IDS and spread the rows back over ids, keyOf(row)
+    // being the id a row answers
+    template <typename Row, typename KeyOf>
+    std::optional<std::vector<std::optional<Row>>> fetchByIds(const std::string& query, const std::vector<int>& ids,
+                                                              const char* tag, KeyOf keyOf);
+    // extra-field handler raising watermark to the highest "version" seen
+    static std::function<void(std::string_view, const JsonScalar&)> versionTracker(std::int64_t& watermark);
 
     // Helper function to parse JSON responses to Employee and PerformanceReview model
     std::optional<Employee> parseEmployeeJson(const json& jEmp);
     std::optional<PerformanceReview> parsePerformanceReview(const json& jPerf);
 
+    // Accept-Encoding for every GET, plus Accept for row lists
+    httplib::Headers requestHeaders(bool rowList) const;
+
     // Helper function to handle common request/error logic
     std::optional<httplib::Result> makeGetRequest(const std::string& path);
     std::optional<httplib::Result> makePostRequest(const std::string& path, const std::string& body,
                                                    const std::string& conentType);
 
     // Helper for PUT, DELETE
+    std::optional<httplib::Result> makePutRequest(const std::string& path, const std::string& body,
+                                                  const std::string& contentType);
 
 protected:
 };
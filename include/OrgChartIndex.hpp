@@ -0,0 +1,88 @@
+#ifndef ORGCHARTINDEX_HPP
+#define ORGCHARTINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace PerfMgmt {
+
+// In-memory reporting hierarchy built from employees.reports_to.
+//
+// Mutations only touch the id -> manager map; the flattened layout is rebuilt
+// lazily by the first query after a reporting line changed:
+//  - children of every node in one contiguous array (CSR offsets)
+//  - a preorder numbering where the subtree of a node is the interval
+//    [enter, enter + subtreeSize) of the preorder array
+// which gives O(1) depth / subtree size / ancestor checks and O(subtree)
+// subtree listing. Employees whose manager is unknown are treated as roots.
+// Safe to query from several threads while another thread mutates it.
+class OrgChartIndex {
+public:
+    // ---- Mutation ----
+
+    // insert or move an employee; only a changed manager invalidates the layout
+    void upsert(int employeeId, std::optional<int> reportsTo, bool isActive);
+    // O(1), deactivated employees stay in the hierarchy
+    void setActive(int employeeId, bool isActive);
+    // drop an employee whose id no longer exists; its reports become roots until they are moved
+    void erase(int employeeId);
+    void clear();
+
+    // ---- Queries ----
+
+    bool contains(int employeeId) const;
+    std::optional<bool> isActive(int employeeId) const;
+    // direct reports ordered by id
+    std::vector<int> directReports(int employeeId) const;
+    // every transitive report in preorder, without employeeId itself
+    std::vector<int> subtree(int employeeId, bool activeOnly = false) const;
+    // number of transitive reports
+    std::size_t subtreeSize(int employeeId) const;
+    // employeeId first, then its manager, up to the root
+    std::vector<int> chainToRoot(int employeeId) const;
+    // 0 for roots
+    std::optional<std::size_t> depth(int employeeId) const;
+    // true if employeeId is in the subtree of managerId (managerId itself excluded)
+    bool reportsTransitivelyTo(int employeeId, int managerId) const;
+
+    std::size_t size() const;
+    // bumped whenever an employee is added or a reporting line changes, for caches derived from the hierarchy
+    std::uint64_t generation() const;
+
+private:
+    struct Node {
+        std::optional<int> reportsTo;
+        bool isActive{true};
+    };
+
+    // rebuild the flattened arrays if a reporting line changed, returns a read lock
+    std::shared_lock<std::shared_mutex> readLock() const;
+    void flatten() const;
+    // dense slot of employeeId in the flattened arrays
+    std::optional<std::uint32_t> slotOf(int employeeId) const;
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<int, Node> nodes;
+    std::uint64_t layoutGeneration{0};
+
+    // ---- flattened layout, valid while !dirty ----
+    mutable bool dirty{false};
+    mutable std::unordered_map<int, std::uint32_t> slots;
+    mutable std::vector<int> ids;                  // slot -> employee id
+    mutable std::vector<std::int32_t> parents;     // slot -> parent slot, -1 for roots
+    mutable std::vector<std::uint32_t> childBegin; // slot -> offset into children, size n + 1
+    mutable std::vector<std::uint32_t> children;   // child slots grouped by parent
+    mutable std::vector<std::uint32_t> enter;      // slot -> position in preorder
+    mutable std::vector<std::uint32_t> sizes;      // slot -> subtree size including itself
+    mutable std::vector<std::uint32_t> depths;     // slot -> distance to its root
+    mutable std::vector<std::uint32_t> preorder;   // preorder position -> slot
+    mutable std::vector<char> activeFlags;         // slot -> isActive, kept current by setActive
+};
+
+} // namespace PerfMgmt
+
+#endif // ORGCHARTINDEX_HPP
@@ -0,0 +1,83 @@
+#ifndef RESTSERVER_HPP
+#define RESTSERVER_HPP
+
+#include <DatabaseManager.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <httplib.h>
+#include <string>
+#include <thread>
+
+namespace PerfMgmt {
+
+struct RestServerConfig {
+    std::string host{"127.0.0.1"};
+    // 5000 is where NetworkManager looks for server.py; 0 binds any free port
+    int port{5000};
+    // request handler threads; give the DatabaseManager as many reader connections so none of them waits
+    std::size_t workerCount{std::max(2u, std::thread::hardware_concurrency())};
+    // requests served on one keep-alive connection before it is closed, and idle seconds before it is dropped
+    std::size_t keepAliveMaxCount{10000};
+    std::time_t keepAliveTimeout{5};
+    // rows serialized per chunk of a streamed list, also the page size the review lists are read in
+    std::size_t chunkRows{256};
+};
+
+// Native server for the /api/employees and /api/reviews endpoints of the Flask mock (server.py), read and
+// written straight from a DatabaseManager. It is not a sync peer: the database keeps no server-wide change
+// clock, so rows carry no "version" and ?since= on a list is answered with 400 rather than with every row.
+//
+// Requests run on a fixed pool of httplib workers over keep-alive connections. Point reads use the manager's
+// pooled reader connections and read cache. Lists are streamed as chunked JSON arrays of chunkRows rows:
+// employees from one cursor, reviews page by page through the keyset lists, so neither side ever holds a
+// whole table. Review writes go through the submit* API and so get group commits once write-behind is
+// enabled; a full write-behind queue answers 503.
+//
+//     GET  /health, /metrics (Prometheus text)
+//     GET  /api/employees[?ids=], /api/employees/:id   POST /api/employees        PUT /api/employees/:id
+//     GET  /api/reviews[?employeeId=|?reviewerId=|?from=&to=|?latestFor=], /api/reviews/:id
+//     POST /api/reviews                                 PUT  /api/reviews/:id
+//
+// PUT on an unknown id answers 404, as the mock does. POST /api/employees stores the employeeId of the body.
+// ?ids=1,2,3 and ?latestFor=1,2,3 are multi-gets: the employees with those ids, or each one's latest review,
+// read in one query and answered in request order, with the ids that matched nothing left out.
+class RestServer {
+public:
+    RestServer(DatabaseManager& db, const RestServerConfig& config = {});
+    RestServer(const RestServer& other) = delete;
+    RestServer& operator=(const RestServer& other) = delete;
+
+    // bind config.host:config.port, false if the address is taken
+    bool bind();
+    // serve on the calling thread until stop(); binds first if bind() was not called
+    bool listen();
+    // from any thread: finish the requests in progress and return from listen()
+    void stop();
+    // blocks until listen() accepts connections
+    void waitUntilReady() const;
+    // bound port, e.g. the one picked for port 0; 0 before bind()
+    int port() const;
+
+private:
+    void registerRoutes();
+
+    void getEmployee(const httplib::Request& req, httplib::Response& res);
+    void listEmployees(const httplib::Request& req, httplib::Response& res);
+    void postEmployee(const httplib::Request& req, httplib::Response& res);
+    void putEmployee(const httplib::Request& req, httplib::Response& res);
+
+    void getReview(const httplib::Request& req, httplib::Response& res);
+    void listReviews(const httplib::Request& req, httplib::Response& res);
+    void postReview(const httplib::Request& req, httplib::Response& res);
+    void putReview(const httplib::Request& req, httplib::Response& res);
+
+    DatabaseManager& db;
+    RestServerConfig config;
+    httplib::Server server;
+    int boundPort{0};
+};
+
+} // namespace PerfMgmt
+
+#endif // RESTSERVER_HPP
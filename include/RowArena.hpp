@@ -0,0 +1,164 @@
+#ifndef ROWARENA_HPP
+#define ROWARENA_HPP
+
+#include <KpiColumnStore.hpp>
+#include <Models.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace PerfMgmt {
+
+// Calendar date as days since 1970-01-01: four bytes in place of a heap allocated "YYYY-MM-DD"
+using DayNumber = std::int32_t;
+// date column that is NULL or not an ISO date
+constexpr DayNumber NO_DAY = std::numeric_limits<DayNumber>::min();
+
+// day number of an ISO date "YYYY-MM-DD", anything after the day is ignored; nullopt if it is not a valid date
+std::optional<DayNumber> toDayNumber(std::string_view isoDate);
+// "YYYY-MM-DD", empty for NO_DAY
+std::string toIsoDate(DayNumber day);
+
+// Employee decoded into a RowArena; name points into the arena
+struct EmployeeRow {
+    int employeeId{0};
+    int personnelCode{0};
+    std::optional<int> reportsTo;
+    std::string_view name;
+    DayNumber hireDay{NO_DAY};
+    Role role{Role::SPECIALIST};
+    bool isActive{true};
+
+    Employee toEmployee() const;
+};
+
+// PerformanceReview decoded into a RowArena; comments point into the arena
+struct ReviewRow {
+    int reviewId{0};
+    int employeeId{0};
+    int reviewerId{0};
+    DayNumber reviewDay{NO_DAY};
+    std::optional<float> overallRating;
+    std::array<float, KPI_COUNT> kpis{}; // in Kpi order
+    std::optional<std::string_view> comments;
+
+    PerformanceReview toPerformanceReview() const;
+};
+
+// Keeps one copy of every distinct string in a memory resource and hands out views of it
+class StringInterner {
+public:
+    explicit StringInterner(std::pmr::memory_resource* resource);
+
+    // view of the stored copy of text, valid until the resource releases its memory
+    std::string_view intern(std::string_view text);
+    // number of distinct strings
+    std::size_t size() const;
+
+private:
+    std::pmr::memory_resource* resource;
+    std::pmr::unordered_set<std::string_view> strings;
+};
+
+// Memory resource that keeps the blocks handed back to it and hands them out again for requests of the same
+// size and alignment, only going to the heap for new shapes. Made for the upstream of a monotonic buffer:
+// refilling it with a query of the same size reuses every block, and memory already touched. Blocks are freed
+// on destruction.
+class BlockCache : public std::pmr::memory_resource {
+public:
+    BlockCache() = default;
+    BlockCache(const BlockCache& other) = delete;
+    BlockCache& operator=(const BlockCache& other) = delete;
+    ~BlockCache() override;
+
+private:
+    struct Block {
+        void* memory;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::vector<Block> freeBlocks;
+};
+
+// first block of a RowArena, later blocks grow geometrically
+constexpr std::size_t DEFAULT_ARENA_BYTES = 64 * 1024;
+
+// Rows of one query together with everything they point to.
+//
+// The row vector, the interned strings and the interner's own nodes are all carved out of one monotonic
+// buffer that takes geometrically larger blocks from the heap, so materializing n rows costs O(log n) heap
+// allocations instead of several per row, and freeing them is a single release. The blocks are kept for
+// the next query, so reusing an arena for a scan of the same size allocates nothing at all. Strings that
+// repeat across rows (review comments from templates) are interned and stored once; mostly unique ones
+// (names) are just copied, since hashing them would cost more than it saves. Neither copyable nor movable:
+// the rows' views must not outlive it.
+//
+//     EmployeeArena arena;
+//     if (db.scanAllEmployees(arena)) { for (const EmployeeRow& employee : arena) { ... } }
+template <typename Row>
+class RowArena {
+public:
+    using const_iterator = typename std::pmr::vector<Row>::const_iterator;
+
+    explicit RowArena(std::size_t initialBytes = DEFAULT_ARENA_BYTES) :
+        buffer(initialBytes, &blocks), strings(&buffer), items(&buffer) {
+    }
+    RowArena(const RowArena& other) = delete;
+    RowArena& operator=(const RowArena& other) = delete;
+
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+    const Row& operator[](std::size_t index) const { return items[index]; }
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    std::size_t distinctStrings() const { return strings.size(); }
+
+    // drop every row and string, keeping the blocks for the next query
+    void clear() {
+        // the containers hand their storage back before the buffer rewinds underneath them
+        items = std::pmr::vector<Row>(&buffer);
+        strings = StringInterner(&buffer);
+        buffer.release();
+    }
+    // room for count rows up front, so growing the vector does not strand old copies of it in the buffer
+    void reserve(std::size_t count) { items.reserve(count); }
+    Row& append() { return items.emplace_back(); }
+    // shared copy of a string that repeats across rows
+    std::string_view intern(std::string_view text) { return strings.intern(text); }
+    // private copy of a string that is mostly unique, e.g. a name, without the cost of a hash lookup
+    std::string_view store(std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        auto* copy = static_cast<char*>(buffer.allocate(text.size(), 1));
+        std::memcpy(copy, text.data(), text.size());
+        return {copy, text.size()};
+    }
+
+private:
+    // declared in order of use: each is destroyed after everything living in it
+    BlockCache blocks;
+    std::pmr::monotonic_buffer_resource buffer;
+    StringInterner strings;
+    std::pmr::vector<Row> items;
+};
+
+using EmployeeArena = RowArena<EmployeeRow>;
+using ReviewArena = RowArena<ReviewRow>;
+
+} // namespace PerfMgmt
+
+#endif // ROWARENA_HPP
@@ -0,0 +1,326 @@
+#ifndef ROWMAPPING_HPP
+#define ROWMAPPING_HPP
+
+#include <Models.hpp>
+#include <cstddef>
+#include <optional>
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace PerfMgmt {
+
+// Compile-time description of how a model maps onto its table columns and JSON keys.
+//
+// RowMapping<Model>::fields lists one Field per column, in table column order. Everything that moves a model
+// in or out of sqlite or JSON is generated from it: readRow() decodes a statement row in place, bindRow() /
+// bindUpdate() bind the INSERT / UPDATE placeholders, toJson() / fromJson() back to_json / from_json, and
+// JsonRowFields (JsonStreamDecoder.hpp) maps the streaming decoder's keys. Handwritten SQL column lists are
+// checked against the mapping with static_assert(matchesColumns<Model>(...)), so reordering either side
+// breaks the build rather than the data.
+
+enum FieldFlags : unsigned {
+    // primary key: last in the bindings of an UPDATE, where it is the WHERE clause
+    KEY = 1u << 0,
+    // bound as NULL when not positive, so sqlite assigns the next id
+    GENERATED = 1u << 1,
+    // a missing or null JSON value reads as the default instead of failing the row
+    JSON_DEFAULTED = 1u << 2
+};
+
+template <typename Model, typename T>
+struct Field {
+    using Type = T;
+    std::string_view column;
+    std::string_view jsonKey; // points at a literal, so data() is null terminated
+    T Model::*member;
+    unsigned flags;
+};
+
+template <typename Model, typename T>
+constexpr Field<Model, T> field(std::string_view column, std::string_view jsonKey, T Model::*member,
+                                unsigned flags = 0) {
+    return {column, jsonKey, member, flags};
+}
+
+template <typename Model>
+struct RowMapping;
+
+template <>
+struct RowMapping<Employee> {
+    static constexpr auto fields = std::make_tuple(
+        field("employee_id", "employeeId", &Employee::employeeId, KEY), field("name", "name", &Employee::name),
+        field("role", "role", &Employee::role), field("reports_to", "reportsTo", &Employee::reportsTo),
+        field("hire_date", "hireDate", &Employee::hireDate),
+        field("personnel_code", "personnelCode", &Employee::personnelCode),
+        field("is_active", "isActive", &Employee::isActive));
+};
+
+template <>
+struct RowMapping<PerformanceReview> {
+    static constexpr auto fields = std::make_tuple(
+        field("review_id", "reviewId", &PerformanceReview::reviewId, KEY | GENERATED),
+        field("employee_id", "employeeId", &PerformanceReview::employeeId),
+        field("reviewer_id", "reviewerId", &PerformanceReview::reviewerId),
+        field("review_date", "reviewDate", &PerformanceReview::reviewDate, JSON_DEFAULTED),
+        field("overall_rating", "overallRating", &PerformanceReview::overallRating),
+        field("comments", "comments", &PerformanceReview::comments),
+        // KPIs the server never rated arrive as null or are left out
+        field("punctuality_rating", "punctualityRating", &PerformanceReview::punctualityRating, JSON_DEFAULTED),
+        field("quality_of_work_rating", "qualityOfWorkRating", &PerformanceReview::qualityOfWorkRating,
+              JSON_DEFAULTED),
+        field("teamwork_rating", "teamworkRating", &PerformanceReview::teamworkRating, JSON_DEFAULTED),
+        field("communication_rating", "communicationRating", &PerformanceReview::communicationRating,
+              JSON_DEFAULTED),
+        field("problem_solving_rating", "problemSolvingRating", &PerformanceReview::problemSolvingRating,
+              JSON_DEFAULTED),
+        field("creativity_rating", "creativityRating", &PerformanceReview::creativityRating, JSON_DEFAULTED),
+        field("technical_skills_rating", "technicalSkillsRating", &PerformanceReview::technicalSkillsRating,
+              JSON_DEFAULTED),
+        field("adaptability_rating", "adaptabilityRating", &PerformanceReview::adaptabilityRating, JSON_DEFAULTED),
+        field("leadership_rating", "leadershipRating", &PerformanceReview::leadershipRating, JSON_DEFAULTED),
+        field("initiative_rating", "initiativeRating", &PerformanceReview::initiativeRating, JSON_DEFAULTED));
+};
+
+// number of mapped columns, i.e. the index of the first column after a readRow()
+template <typename Model>
+constexpr std::size_t fieldCount = std::tuple_size_v<std::decay_t<decltype(RowMapping<Model>::fields)>>;
+
+namespace mapping {
+
+// f(field, index) for every field of Model, unrolled at compile time
+template <typename Model, typename Visitor, std::size_t... I>
+constexpr void visitFields(Visitor&& visit, std::index_sequence<I...>) {
+    (visit(std::get<I>(RowMapping<Model>::fields), std::integral_constant<std::size_t, I>{}), ...);
+}
+
+template <typename Model, typename Visitor>
+constexpr void forEachField(Visitor&& visit) {
+    visitFields<Model>(std::forward<Visitor>(visit), std::make_index_sequence<fieldCount<Model>>{});
+}
+
+template <typename T>
+struct IsOptional : std::false_type {};
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+// ---- sqlite columns ----
+
+inline std::string_view columnText(sqlite3_stmt* stmt, int column) {
+    const unsigned char* value = sqlite3_column_text(stmt, column);
+    if (!value) {
+        return {};
+    }
+    return {reinterpret_cast<const char*>(value), static_cast<std::size_t>(sqlite3_column_bytes(stmt, column))};
+}
+
+// read: column -> field, in place; bindable: field -> a value database_binder accepts
+inline void readColumn(sqlite3_stmt* stmt, int column, int& value) {
+    value = sqlite3_column_int(stmt, column);
+}
+inline void readColumn(sqlite3_stmt* stmt, int column, float& value) {
+    value = static_cast<float>(sqlite3_column_double(stmt, column));
+}
+inline void readColumn(sqlite3_stmt* stmt, int column, bool& value) {
+    value = sqlite3_column_int(stmt, column) != 0;
+}
+// assign() reuses the capacity of a string that is read into again
+inline void readColumn(sqlite3_stmt* stmt, int column, std::string& value) {
+    auto text = columnText(stmt, column);
+    value.assign(text.data(), text.size());
+}
+// the table's CHECK constraint only admits known roles
+inline void readColumn(sqlite3_stmt* stmt, int column, Role& value) {
+    value = stringToRole(columnText(stmt, column)).value_or(Role::SPECIALIST);
+}
+template <typename T>
+void readColumn(sqlite3_stmt* stmt, int column, std::optional<T>& value) {
+    if (sqlite3_column_type(stmt, column) == SQLITE_NULL) {
+        value.reset();
+        return;
+    }
+    readColumn(stmt, column, value ? *value : value.emplace());
+}
+
+template <typename T>
+const T& bindable(const T& value) {
+    return value;
+}
+inline int bindable(bool value) {
+    return static_cast<int>(value);
+}
+inline std::string bindable(Role value) {
+    return roleToString(value);
+}
+
+// ---- JSON values ----
+
+template <typename T>
+void writeJson(json& j, const char* key, const T& value) {
+    j[key] = value;
+}
+inline void writeJson(json& j, const char* key, Role value) {
+    j[key] = roleToString(value);
+}
+// empty optionals are left out
+template <typename T>
+void writeJson(json& j, const char* key, const std::optional<T>& value) {
+    if (value) {
+        writeJson(j, key, *value);
+    }
+}
+
+template <typename T>
+void readJson(const json& value, T& target) {
+    target = value.get<T>();
+}
+// unknown roles throw like a wrong type does
+inline void readJson(const json& value, Role& target) {
+    target = stringToRole(value.get<std::string>()).value();
+}
+template <typename T>
+void readJson(const json& value, std::optional<T>& target) {
+    readJson(value, target.emplace());
+}
+
+} // namespace mapping
+
+// ---- Statements ----
+
+// decode the current row of stmt into model, the mapped columns starting at firstColumn
+template <typename Model>
+void readRow(sqlite3_stmt* stmt, Model& model, int firstColumn = 0) {
+    mapping::forEachField<Model>([&](const auto& field, auto index) {
+        mapping::readColumn(stmt, firstColumn + static_cast<int>(index()), model.*field.member);
+    });
+}
+
+// bind every mapped column in order, as the placeholders of an INSERT over the mapped column list
+template <typename Binder, typename Model>
+void bindRow(Binder& stmt, const Model& model) {
+    mapping::forEachField<Model>([&](const auto& field, auto) {
+        using T = typename std::decay_t<decltype(field)>::Type;
+        if constexpr (std::is_same_v<T, int>) {
+            if (field.flags & GENERATED) {
+                const int& id = model.*field.member;
+                stmt << (id > 0 ? std::optional<int>(id) : std::nullopt);
+                return;
+            }
+        }
+        stmt << mapping::bindable(model.*field.member);
+    });
+}
+
+// bind the non-key columns in order and then the key, as an UPDATE ... SET <non-key columns> WHERE <key> = ?
+template <typename Binder, typename Model>
+void bindUpdate(Binder& stmt, const Model& model) {
+    mapping::forEachField<Model>([&](const auto& field, auto) {
+        if (!(field.flags & KEY)) {
+            stmt << mapping::bindable(model.*field.member);
+        }
+    });
+    mapping::forEachField<Model>([&](const auto& field, auto) {
+        if (field.flags & KEY) {
+            stmt << mapping::bindable(model.*field.member);
+        }
+    });
+}
+
+// ---- Column order checks ----
+
+namespace mapping {
+constexpr bool isIdentifier(char c) {
+    return c == '_' || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// leading identifier of the next top-level item of a comma separated list, pos moves past its comma
+constexpr std::string_view nextColumn(std::string_view list, std::size_t& pos) {
+    while (pos < list.size() && list[pos] == ' ') {
+        ++pos;
+    }
+    std::size_t begin = pos;
+    while (pos < list.size() && isIdentifier(list[pos])) {
+        ++pos;
+    }
+    std::string_view column = list.substr(begin, pos - begin);
+    int depth = 0;
+    for (; pos < list.size() && (depth > 0 || list[pos] != ','); ++pos) {
+        depth += list[pos] == '(' ? 1 : list[pos] == ')' ? -1 : 0;
+    }
+    if (pos < list.size()) {
+        ++pos;
+    }
+    return column;
+}
+} // namespace mapping
+
+// True if columns, a comma separated SQL list of column names or of "column = expression" assignments, names
+// the mapped columns of Model in mapping order and nothing else. skipKey leaves out the KEY columns, as in the
+// SET list of an UPDATE.
+template <typename Model>
+constexpr bool matchesColumns(std::string_view columns, bool skipKey = false) {
+    std::size_t pos = 0;
+    bool matches = true;
+    mapping::forEachField<Model>([&](const auto& field, auto) {
+        if (!(skipKey && (field.flags & KEY)) && mapping::nextColumn(columns, pos) != field.column) {
+            matches = false;
+        }
+    });
+    return matches && mapping::nextColumn(columns, pos).empty() && pos == columns.size();
+}
+
+// position of column in the mapping, and so in a matching column list; -1 if Model does not map it
+template <typename Model>
+constexpr int columnIndex(std::string_view column) {
+    int position = -1;
+    mapping::forEachField<Model>([&](const auto& field, auto index) {
+        if (field.column == column) {
+            position = static_cast<int>(index());
+        }
+    });
+    return position;
+}
+
+// ---- JSON ----
+
+template <typename Model>
+void toJson(json& j, const Model& model) {
+    j = json::object();
+    mapping::forEachField<Model>(
+        [&](const auto& field, auto) { mapping::writeJson(j, field.jsonKey.data(), model.*field.member); });
+}
+
+// required keys throw json::out_of_range when missing, optional ones read as empty
+template <typename Model>
+void fromJson(const json& j, Model& model) {
+    mapping::forEachField<Model>([&](const auto& field, auto) {
+        using T = typename std::decay_t<decltype(field)>::Type;
+        auto& target = model.*field.member;
+        if constexpr (mapping::IsOptional<T>::value) {
+            auto it = j.find(field.jsonKey.data());
+            if (it == j.end() || it->is_null()) {
+                target.reset();
+            } else {
+                mapping::readJson(*it, target);
+            }
+        } else {
+            if (field.flags & JSON_DEFAULTED) {
+                auto it = j.find(field.jsonKey.data());
+                if (it == j.end() || it->is_null()) {
+                    target = T{};
+                    return;
+                }
+                mapping::readJson(*it, target);
+                return;
+            }
+            mapping::readJson(j.at(field.jsonKey.data()), target);
+        }
+    });
+}
+
+} // namespace PerfMgmt
+
+#endif // ROWMAPPING_HPP
@@ -0,0 +1,73 @@
+#ifndef SEARCHINDEX_HPP
+#define SEARCHINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace PerfMgmt {
+
+// one ranked match, best first
+struct SearchHit {
+    int id{0};
+    double score{0.0};
+};
+
+// In-memory trigram index over short texts keyed by id (employee names, review comments).
+//
+// Texts are lowercased (ASCII) and split into words; every word is padded as "  word " before it is cut into
+// trigrams, so the leading trigrams of a word encode its prefix. A query is cut the same way, except that its
+// last word gets no trailing pad and so matches as a prefix while it is being typed. Candidates are the texts
+// sharing at least one trigram with the query, counted through the posting lists; they are ranked by the share
+// of the query's trigrams they contain, then by substring / word-prefix matches, then by length. Because a
+// typo only breaks the few trigrams around it, misspelt queries still rank the intended text near the top.
+// Safe to query from several threads while another thread mutates it.
+class SearchIndex {
+public:
+    // share of the query trigrams a text must contain to be returned
+    static constexpr double DEFAULT_MIN_COVERAGE = 0.5;
+
+    // ---- Mutation ----
+
+    // insert or replace the text of id; an empty text removes it
+    void upsert(int id, std::string_view text);
+    void erase(int id);
+    void clear();
+
+    // ---- Queries ----
+
+    // at most limit hits, best first; empty for a query without letters or digits
+    std::vector<SearchHit> search(std::string_view query, std::size_t limit = 10,
+                                  double minCoverage = DEFAULT_MIN_COVERAGE) const;
+    bool contains(int id) const;
+    std::size_t size() const;
+
+private:
+    using Trigram = std::uint32_t;
+
+    struct Document {
+        int id{0};
+        std::string text;              // lowercased, words separated by single spaces
+        std::vector<Trigram> trigrams; // distinct
+    };
+
+    // lowercased words joined by single spaces
+    static std::string normalize(std::string_view text);
+    // distinct trigrams of normalized text; prefixQuery leaves the last word open-ended
+    static std::vector<Trigram> trigramsOf(const std::string& normalized, bool prefixQuery);
+    void eraseLocked(int id);
+
+    mutable std::shared_mutex mutex;
+    std::vector<Document> documents;                        // slot -> document, id 0 marks a free slot
+    std::vector<std::uint32_t> freeSlots;
+    std::unordered_map<int, std::uint32_t> slots;           // id -> slot
+    std::unordered_map<Trigram, std::vector<std::uint32_t>> postings; // trigram -> slots, unordered
+};
+
+} // namespace PerfMgmt
+
+#endif // SEARCHINDEX_HPP
@@ -0,0 +1,157 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <KpiColumnStore.hpp>
+#include <Models.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace PerfMgmt {
+
+// Binary snapshot of the employees and performance_reviews tables, laid out to be used in place from mmap.
+//
+//   header | employee records | review records | employee index | review index | string table
+//
+// Records are fixed width and 8-byte aligned. Employees are stored in id order; reviews are grouped by
+// employee in (review_date, review_id) order, and every employee record points at its range of reviews.
+// The two indexes map ids to record numbers, sorted by id for binary search. Names, dates and comments are
+// interned once in the string table and referenced by offset and length.
+// Integers are in host byte order; a snapshot from a machine of the other endianness is rejected.
+namespace snapshot {
+
+constexpr char MAGIC[8] = {'P', 'M', 'S', 'N', 'A', 'P', '\0', '\0'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+constexpr std::uint32_t ENDIAN_TAG = 0x01020304;
+// sentinels for absent optional fields
+constexpr std::int32_t NO_MANAGER = 0;
+constexpr std::uint32_t NO_STRING = 0xFFFFFFFF;
+
+struct StringRef {
+    std::uint32_t offset{NO_STRING};
+    std::uint32_t length{0};
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::uint64_t fileSize;
+    std::uint64_t employeeCount;
+    std::uint64_t reviewCount;
+    std::uint64_t employeesOffset;
+    std::uint64_t reviewsOffset;
+    std::uint64_t employeeIndexOffset;
+    std::uint64_t reviewIndexOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t stringsSize;
+};
+
+struct EmployeeRecord {
+    std::int32_t employeeId;
+    std::int32_t personnelCode;
+    std::int32_t reportsTo; // NO_MANAGER for roots
+    std::uint8_t role;
+    std::uint8_t isActive;
+    std::uint16_t reserved;
+    StringRef name;
+    StringRef hireDate;
+    // this employee's reviews are review records [firstReview, firstReview + reviewCount)
+    std::uint32_t firstReview;
+    std::uint32_t reviewCount;
+};
+
+struct ReviewRecord {
+    std::int32_t reviewId;
+    std::int32_t employeeId;
+    std::int32_t reviewerId;
+    float overallRating;
+    std::uint8_t hasOverallRating;
+    std::uint8_t reserved[3];
+    float kpis[KPI_COUNT]; // in Kpi order
+    StringRef reviewDate;
+    StringRef comments; // offset NO_STRING when there are none
+    std::uint32_t reserved2;
+};
+
+// id -> record number
+struct IndexEntry {
+    std::int32_t id;
+    std::uint32_t record;
+};
+
+static_assert(sizeof(Header) % 8 == 0 && sizeof(EmployeeRecord) % 8 == 0 && sizeof(ReviewRecord) % 8 == 0,
+              "snapshot sections must stay 8-byte aligned");
+
+} // namespace snapshot
+
+// Collects rows and writes them as a snapshot file.
+// Rows may be added in any order; write() sorts them into the snapshot layout.
+class SnapshotWriter {
+public:
+    void addEmployee(const Employee& employee);
+    void addReview(const PerformanceReview& review);
+    // written to path + ".tmp" and renamed over path, so readers never map a half-written file
+    bool write(const std::string& path);
+
+private:
+    snapshot::StringRef intern(std::string_view text);
+
+    std::vector<snapshot::EmployeeRecord> employees;
+    std::vector<snapshot::ReviewRecord> reviews;
+    std::string strings;
+    std::unordered_map<std::string, snapshot::StringRef> internedStrings;
+};
+
+// Read-only view of a snapshot file mapped into memory. Opening validates the header and every section
+// and string bound, afterwards reads touch only the pages they need. Move-only, unmaps on destruction.
+class Snapshot {
+public:
+    // nullopt if the file cannot be mapped or is not a valid snapshot of this format version
+    static std::optional<Snapshot> open(const std::string& path);
+
+    Snapshot(Snapshot&& other) noexcept;
+    Snapshot& operator=(Snapshot&& other) noexcept;
+    Snapshot(const Snapshot& other) = delete;
+    Snapshot& operator=(const Snapshot& other) = delete;
+    ~Snapshot();
+
+    std::size_t employeeCount() const;
+    std::size_t reviewCount() const;
+
+    // ---- Zero-copy access ----
+
+    // records in id order / grouped by employee
+    const snapshot::EmployeeRecord& employeeRecord(std::size_t index) const;
+    const snapshot::ReviewRecord& reviewRecord(std::size_t index) const;
+    // view into the mapping, valid while the snapshot lives
+    std::string_view text(const snapshot::StringRef& ref) const;
+
+    // ---- Decoded rows ----
+
+    // O(log n) through the id indexes
+    std::optional<Employee> getEmployee(int employeeId) const;
+    std::optional<PerformanceReview> getPerformanceReview(int reviewId) const;
+    // every review of employeeId in (review_date, review_id) order
+    std::vector<PerformanceReview> getReviewsForEmployee(int employeeId) const;
+    Employee employeeAt(std::size_t index) const;
+    PerformanceReview reviewAt(std::size_t index) const;
+
+private:
+    Snapshot(const unsigned char* base, std::size_t size);
+    bool validate() const;
+    const snapshot::Header& header() const;
+    // record number of id in an index section, nullopt if absent
+    std::optional<std::uint32_t> find(std::uint64_t indexOffset, std::uint64_t count, int id) const;
+
+    const unsigned char* base{nullptr};
+    std::size_t size{0};
+};
+
+} // namespace PerfMgmt
+
+#endif // SNAPSHOT_HPP
@@ -0,0 +1,50 @@
+#ifndef STATEMENTCACHE_HPP
+#define STATEMENTCACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <sqlite_modern_cpp.h>
+#include <string>
+#include <unordered_map>
+
+namespace PerfMgmt {
+
+// Owns the prepared statements of one connection, keyed by their SQL text.
+// A statement is prepared on first use and afterwards only reset and rebound.
+// Not thread-safe: the owner serializes access together with the connection.
+class StatementCache {
+public:
+    explicit StatementCache(sqlite::database& db);
+    StatementCache(const StatementCache& other) = delete;
+    StatementCache& operator=(const StatementCache& other) = delete;
+    ~StatementCache();
+
+    // prepared statement for sql, reset and with its bindings cleared
+    sqlite::database_binder& acquire(const std::string& sql);
+    // the same as a raw statement, for rows decoded in place through RowMapping rather than through a
+    // database_binder callback; throws sqlite::sqlite_exception if sql does not prepare
+    sqlite3_stmt* acquireRaw(const std::string& sql);
+
+    // drop every cached statement (e.g. after a schema change)
+    void clear();
+
+    std::size_t size() const;
+    std::size_t hits() const;
+    std::size_t misses() const;
+
+private:
+    struct Finalizer {
+        void operator()(sqlite3_stmt* stmt) const { sqlite3_finalize(stmt); }
+    };
+
+    sqlite::database& db;
+    std::unordered_map<std::string, sqlite::database_binder> statements;
+    std::unordered_map<std::string, std::unique_ptr<sqlite3_stmt, Finalizer>> rawStatements;
+    std::atomic<std::size_t> hitCount{0};
+    std::atomic<std::size_t> missCount{0};
+};
+
+} // namespace PerfMgmt
+
+#endif // STATEMENTCACHE_HPP
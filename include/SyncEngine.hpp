@@ -0,0 +1,64 @@
+#ifndef SYNCENGINE_HPP
+#define SYNCENGINE_HPP
+
+#include <AsyncNetworkManager.hpp>
+#include <DatabaseManager.hpp>
+#include <NetworkManager.hpp>
+#include <cstddef>
+#include <string>
+
+namespace PerfMgmt {
+
+// dirty rows read from sqlite per round of pushes
+constexpr std::size_t DEFAULT_SYNC_PAGE_SIZE = 256;
+
+// What one sync pass moved in each direction
+struct SyncReport {
+    std::size_t employeesPulled{0};
+    std::size_t reviewsPulled{0};
+    std::size_t employeesPushed{0};
+    std::size_t reviewsPushed{0};
+    // rows or requests that failed and will be retried by the next pass
+    std::size_t failures{0};
+
+    bool ok() const { return failures == 0; }
+};
+
+// Incremental two-way sync between the local database and the REST server.
+// Pulls only rows the server changed after the stored watermark, then pushes
+// only rows edited locally since their last push, so the cost of a pass grows
+// with churn rather than headcount. Ids are the server's: a row created offline
+// is posted and renumbered to the id the server assigns, along with the rows
+// referencing it; a row referencing one still unpushed waits for it. A local
+// edit that has not been pushed yet wins over a concurrent remote one.
+class SyncEngine {
+public:
+    SyncEngine(DatabaseManager& database, const std::string& serverBaseUrl, const AsyncNetworkConfig& config = {},
+               std::size_t pageSize = DEFAULT_SYNC_PAGE_SIZE);
+    SyncEngine(const SyncEngine& other) = delete;
+    SyncEngine& operator=(const SyncEngine& other) = delete;
+
+    // pull then push
+    SyncReport sync();
+    // fetch and apply server changes after the watermarks
+    SyncReport pull();
+    // upload dirty rows, pipelined over the async client
+    SyncReport push();
+
+private:
+    void pullEmployees(SyncReport& report);
+    void pullReviews(SyncReport& report);
+    void pushEmployees(SyncReport& report);
+    // one pass over the dirty employees; true if it adopted a server id
+    bool pushEmployeePass(SyncReport& report);
+    void pushReviews(SyncReport& report);
+
+    DatabaseManager& database;
+    NetworkManager client;
+    AsyncNetworkManager pipeline;
+    std::size_t pageSize;
+};
+
+} // namespace PerfMgmt
+
+#endif // SYNCENGINE_HPP
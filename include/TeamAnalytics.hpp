@@ -0,0 +1,109 @@
+#ifndef TEAMANALYTICS_HPP
+#define TEAMANALYTICS_HPP
+
+#include <KpiColumnStore.hpp>
+#include <Models.hpp>
+#include <OrgChartIndex.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace PerfMgmt {
+
+// calendar quarter a review falls into
+struct ReviewPeriod {
+    int year{0};
+    int quarter{1}; // 1..4
+
+    // from the leading YYYY-MM of a review date, nullopt if it has none
+    static std::optional<ReviewPeriod> fromDate(const std::string& reviewDate);
+    bool operator==(const ReviewPeriod& other) const { return year == other.year && quarter == other.quarter; }
+};
+
+// Count, sum and sum of squares of every KPI and of overallRating over a set of reviews.
+// Additive, so rollups of disjoint sets combine with += and a review is taken back out with -=.
+struct KpiRollup {
+    std::size_t count{0};
+    std::array<double, KPI_COUNT> sum{};
+    std::array<double, KPI_COUNT> sumOfSquares{};
+    // overallRating is optional, so it keeps its own count
+    std::size_t overallCount{0};
+    double overallSum{0.0};
+    double overallSumOfSquares{0.0};
+
+    void add(const PerformanceReview& review);
+    KpiRollup& operator+=(const KpiRollup& other);
+    KpiRollup& operator-=(const KpiRollup& other);
+
+    // nullopt while no review contributed
+    std::optional<double> mean(Kpi kpi) const;
+    std::optional<double> overallMean() const;
+    // population standard deviation
+    std::optional<double> stddev(Kpi kpi) const;
+    std::optional<double> overallStddev() const;
+};
+
+// Materialized review rollups per reporting subtree and per quarter.
+//
+// Every review is kept as its contribution (employee, quarter, one-review rollup). Adding, replacing or
+// removing a review applies the difference to the employee's own rollup and to the subtree rollup of each
+// manager on its chain to the root, so a query is a single hash lookup: O(depth) per change, O(1) per read.
+// The reporting lines come from an OrgChartIndex; when one of them changes, the subtree rollups are rebuilt
+// from the per-employee rollups by the next call. Safe to query from several threads while another updates.
+class TeamAnalytics {
+public:
+    explicit TeamAnalytics(const OrgChartIndex& orgChart);
+
+    // ---- Mutation ----
+
+    // insert or replace the review with review.reviewId; an empty reviewDate keeps the quarter of the replaced review
+    void addReview(const PerformanceReview& review);
+    void removeReview(int reviewId);
+    void clear();
+
+    // ---- Queries ----
+    // period nullopt means all quarters, including reviews without a parsable date
+
+    // reviews of every transitive report of managerId, managerId's own reviews excluded
+    KpiRollup team(int managerId, std::optional<ReviewPeriod> period = std::nullopt) const;
+    // reviews of employeeId only
+    KpiRollup employee(int employeeId, std::optional<ReviewPeriod> period = std::nullopt) const;
+    std::size_t reviewCount() const;
+
+private:
+    struct Contribution {
+        int employeeId{0};
+        std::int32_t periodKey{0};
+        KpiRollup values;
+    };
+    using RollupMap = std::unordered_map<std::int64_t, KpiRollup>;
+
+    // quarters are keyed year * 4 + quarter - 1, ALL_PERIODS and NO_PERIOD never collide with them
+    static constexpr std::int32_t ALL_PERIODS = -1;
+    static constexpr std::int32_t NO_PERIOD = -2;
+    static std::int32_t periodKey(const ReviewPeriod& period);
+    static std::int64_t rollupKey(int id, std::int32_t periodKey);
+
+    // rebuild the subtree rollups if a reporting line changed, returns a read lock
+    std::shared_lock<std::shared_mutex> readLock() const;
+    void rebuildSubtrees() const;
+    // apply one contribution with sign +1 / -1 to its employee and every manager above it
+    void apply(const Contribution& contribution, int sign);
+    static void applyTo(RollupMap& rollups, std::int64_t key, const KpiRollup& values, int sign);
+    KpiRollup lookup(const RollupMap& rollups, int id, std::optional<ReviewPeriod> period) const;
+
+    const OrgChartIndex& orgChart;
+    mutable std::shared_mutex mutex;
+    std::unordered_map<int, Contribution> reviews; // review id -> what it added
+    RollupMap own;                                 // (employee, period) -> their own reviews
+    mutable RollupMap subtrees;                    // (manager, period) -> reviews of their transitive reports
+    mutable std::uint64_t builtGeneration{0};      // orgChart.generation() subtrees match
+};
+
+} // namespace PerfMgmt
+
+#endif // TEAMANALYTICS_HPP
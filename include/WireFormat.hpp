@@ -0,0 +1,149 @@
+#ifndef WIREFORMAT_HPP
+#define WIREFORMAT_HPP
+
+#include <JsonStreamDecoder.hpp>
+#include <charconv>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace PerfMgmt {
+
+// Body encodings a row list can travel in. JSON is what every server speaks; the binary ones carry the same
+// arrays of objects with the same keys, they only spell numbers, booleans and lengths in binary.
+enum class WireFormat {
+    JSON,
+    MSGPACK,
+    CBOR
+};
+
+// media type sent in Accept and expected in Content-Type
+const char* mediaType(WireFormat format);
+// format of a Content-Type value, parameters ignored; nullopt for anything else
+std::optional<WireFormat> wireFormatOf(std::string_view contentType);
+
+// Decoder for a MessagePack or CBOR array of row objects with the same interface as JsonRowDecoder.
+// Binary arrays carry their length up front, so the body is collected and decoded in finish(). The decode is
+// nlohmann's SAX parser handing every field straight to JsonRowDecoder's record handling, so rows are built
+// in place without a DOM and accepted by exactly the same field rules as the JSON path.
+template <typename Row>
+class BinaryRowDecoder : protected JsonRowDecoder<Row> {
+public:
+    using ExtraFieldHandler = typename JsonRowDecoder<Row>::ExtraFieldHandler;
+
+    BinaryRowDecoder(std::vector<Row>& rows, WireFormat format, ExtraFieldHandler extra = nullptr)
+        : JsonRowDecoder<Row>(rows, std::move(extra)), format(format) {}
+
+    bool feed(const char* data, std::size_t length) {
+        body.append(data, length);
+        return true;
+    }
+
+    // true if the body was an array of valid rows
+    bool finish() {
+        Events events(*this);
+        bool parsed = json::sax_parse(body, &events,
+                                      format == WireFormat::CBOR ? json::input_format_t::cbor
+                                                                 : json::input_format_t::msgpack);
+        body.clear();
+        body.shrink_to_fit();
+        if (!parsed || events.depth != 0) {
+            this->fail(events.error.empty() ? "truncated " + std::string(mediaType(format)) + " body" : events.error);
+        }
+        return !failed();
+    }
+
+    bool failed() const { return JsonRowDecoder<Row>::failed(); }
+    const std::string& error() const { return JsonRowDecoder<Row>::error(); }
+
+private:
+    // nlohmann SAX events of the body, depth 1 inside the row array and 2 inside a row
+    struct Events {
+        explicit Events(BinaryRowDecoder& decoder) : decoder(decoder) {}
+
+        BinaryRowDecoder& decoder;
+        int depth{0};
+        std::string fieldKey;
+        std::string error;
+        char number[32];
+
+        bool scalar(const JsonScalar& value) {
+            if (depth == 2) {
+                return decoder.onField(fieldKey, value);
+            }
+            // values nested deeper in a row are skipped, like the JSON parser does
+            return depth > 2 || reject(depth == 0 ? "body is not an array" : "array element is not an object");
+        }
+        template <typename Number>
+        bool numeric(Number value) {
+            auto [end, ec] = std::to_chars(number, number + sizeof(number), value);
+            JsonScalar scalar;
+            scalar.type = JsonScalar::Type::Number;
+            scalar.text = std::string_view(number, ec == std::errc() ? end - number : 0);
+            return this->scalar(scalar);
+        }
+        bool reject(const std::string& message) {
+            error = message;
+            return false;
+        }
+
+        bool null() { return scalar(JsonScalar{}); }
+        bool boolean(bool value) {
+            JsonScalar scalar;
+            scalar.type = JsonScalar::Type::Boolean;
+            scalar.boolean = value;
+            return this->scalar(scalar);
+        }
+        bool number_integer(json::number_integer_t value) { return numeric(value); }
+        bool number_unsigned(json::number_unsigned_t value) { return numeric(value); }
+        bool number_float(json::number_float_t value, const json::string_t&) { return numeric(value); }
+        bool string(json::string_t& value) {
+            JsonScalar scalar;
+            scalar.type = JsonScalar::Type::String;
+            scalar.text = value;
+            return this->scalar(scalar);
+        }
+        bool binary(json::binary_t&) { return depth >= 2 || reject("array element is not an object"); }
+        bool key(json::string_t& value) {
+            fieldKey.swap(value);
+            return true;
+        }
+        bool start_object(std::size_t) {
+            if (depth == 1) {
+                decoder.onRecordBegin();
+            } else if (depth == 0) {
+                return reject("body is not an array");
+            }
+            ++depth;
+            return true;
+        }
+        bool end_object() { return --depth != 1 || decoder.onRecordEnd(); }
+        bool start_array(std::size_t) {
+            if (depth == 1) {
+                return reject("array element is not an object");
+            }
+            ++depth;
+            return true;
+        }
+        bool end_array() {
+            --depth;
+            return true;
+        }
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) {
+            return reject(e.what());
+        }
+    };
+
+    WireFormat format;
+    std::string body;
+};
+
+} // namespace PerfMgmt
+
+#endif // WIREFORMAT_HPP
@@ -0,0 +1,119 @@
+#ifndef WRITEBEHINDQUEUE_HPP
+#define WRITEBEHINDQUEUE_HPP
+
+#include <Models.hpp>
+#include <MpscQueue.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace PerfMgmt {
+
+struct WriteBehindConfig {
+    // writes committed in one transaction at most
+    std::size_t maxBatchSize{256};
+    // once the first write of a group arrived, how long the writer waits for more before committing.
+    // 0 commits whatever is queued right away; groups still form from the writes that arrive during a commit,
+    // and a lone writer pays no extra latency
+    std::chrono::microseconds maxBatchDelay{0};
+    // writes queued and not yet committed; beyond this submitting blocks, or fails fast without blockWhenFull
+    std::size_t capacity{4096};
+    bool blockWhenFull{true};
+};
+
+enum class WriteKind { INSERT_REVIEW, UPDATE_REVIEW, DELETE_REVIEW };
+
+enum class WriteStatus {
+    // durable: the transaction holding the write has committed
+    COMMITTED,
+    // the statement failed, matched no row, or its group's transaction was rolled back
+    FAILED,
+    // turned away up front because the queue was at capacity (WriteBehindConfig::blockWhenFull off)
+    QUEUE_FULL
+};
+
+// what a submitter's future resolves to
+struct WriteResult {
+    WriteStatus status{WriteStatus::FAILED};
+    // id of the written review, assigned by sqlite for inserts without one
+    int reviewId{0};
+
+    bool ok() const { return status == WriteStatus::COMMITTED; }
+};
+
+// one queued mutation together with the promise its submitter waits on
+struct PendingWrite {
+    WriteKind kind{WriteKind::INSERT_REVIEW};
+    // DELETE_REVIEW only reads reviewId
+    PerformanceReview review;
+    std::promise<WriteResult> done;
+};
+
+// Write-behind front end for the review mutators.
+//
+// Submitters push onto a lock-free MPSC queue and get a future back; one writer thread drains the queue in
+// groups of up to maxBatchSize writes, or whatever arrived within maxBatchDelay of the group's first write,
+// and hands each group to commitGroup, which writes it in a single transaction and resolves every promise.
+// Hundreds of concurrent submitters thus pay for one fsync and one lock acquisition per group instead of
+// one each. capacity bounds the writes in flight: a full queue blocks the submitter or turns it away.
+class WriteBehindQueue {
+public:
+    // called on the writer thread with every group, in submission order; must resolve every promise
+    using CommitGroup = std::function<void(std::vector<PendingWrite>& group)>;
+
+    WriteBehindQueue(const WriteBehindConfig& config, CommitGroup commitGroup);
+    WriteBehindQueue(const WriteBehindQueue& other) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue& other) = delete;
+    // commits everything still queued, then joins the writer
+    ~WriteBehindQueue();
+
+    std::future<WriteResult> submit(WriteKind kind, const PerformanceReview& review);
+    // blocks until every write submitted before the call has been committed or failed
+    void flush();
+
+    // writes queued or being committed right now
+    std::size_t backlog() const;
+    std::size_t capacity() const;
+    // groups committed so far and the writes they held, for the mean group size
+    std::uint64_t groupsCommitted() const;
+    std::uint64_t writesCommitted() const;
+
+private:
+    // take a slot below capacity, waiting for one if blocking is enabled; false if the queue is full
+    bool reserveSlot();
+    void writerLoop();
+    // sleep until a write is queued, stopping is set or deadline passes
+    void waitForWrites(std::chrono::steady_clock::time_point deadline);
+
+    WriteBehindConfig config;
+    CommitGroup commitGroup;
+    MpscQueue<PendingWrite> queue;
+
+    // reserved slots, i.e. writes submitted and not yet resolved
+    std::atomic<std::size_t> depth{0};
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> groups{0};
+    std::atomic<bool> stopping{false};
+
+    // only for sleeping: the writer on an empty queue, submitters on a full one, flush() on the backlog
+    std::mutex sleepMutex;
+    std::condition_variable writesQueued;
+    std::condition_variable writesDone;
+    std::atomic<bool> writerSleeping{false};
+    std::atomic<std::size_t> sleepers{0};
+
+    std::thread writer;
+};
+
+} // namespace PerfMgmt
+
+#endif // WRITEBEHINDQUEUE_HPP
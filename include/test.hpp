@@ -3,5 +3,12 @@
 namespace PerfMgmt {
 
 void test_App();
+// multi-producer stress of MpscQueue: every item arrives exactly once and each producer's items in push order
+bool test_MpscQueue();
+// ChangeFeed readers lapped by the writer: every event they get is whole, and the ones they miss are counted
+bool test_ChangeFeed();
+// sync id handling: rows pulled onto a local id move it aside, posted rows adopt (even swapped) server ids with
+// every reference, and rows naming an unpushed employee wait for it
+bool test_SyncIds();
 
 } // namespace PerfMgmt
\ No newline at end of file
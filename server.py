@@ -1,23 +1,98 @@
 from flask import Flask, jsonify, request
 import datetime
+import gzip
 import time
 
+# Optional binary encoders (pip install msgpack cbor2); without them every answer stays JSON
+try:
+    import msgpack
+except ImportError:
+    msgpack = None
+try:
+    import cbor2
+except ImportError:
+    cbor2 = None
+
 app = Flask(__name__)
 
 # --- Mock Data ---
 # Keep track of data (in memory, resets when server restarts)
 mock_employees = {
-    1: {"employeeId": 1,"personnelCode": 981207, "name": "Alice Manager (Mock)", "role": "Manager", "reportsTo": None, "isActive": True, "hireDate": "2023-01-15T10:00:00Z"},
-    2: {"employeeId": 2, "personnelCode": 981208,"name": "Bob Boss (Mock)", "role": "Boss", "reportsTo": 1, "isActive": True, "hireDate": "2023-02-20T11:30:00Z"},
-    3: {"employeeId": 3, "personnelCode": 981209, "name": "Charlie Specialist (Mock)", "role": "Specialist", "reportsTo": 2, "isActive": True, "hireDate": "2023-03-10T09:15:00Z"}
+    1: {"employeeId": 1,"personnelCode": 981207, "name": "Alice Manager (Mock)", "role": "Manager", "reportsTo": None, "isActive": True, "hireDate": "2023-01-15T10:00:00Z", "version": 1},
+    2: {"employeeId": 2, "personnelCode": 981208,"name": "Bob Boss (Mock)", "role": "Boss", "reportsTo": 1, "isActive": True, "hireDate": "2023-02-20T11:30:00Z", "version": 2},
+    3: {"employeeId": 3, "personnelCode": 981209, "name": "Charlie Specialist (Mock)", "role": "Specialist", "reportsTo": 2, "isActive": True, "hireDate": "2023-03-10T09:15:00Z", "version": 3}
 }
 mock_reviews = {
-    101: {"reviewId": 101, "employeeId": 2, "reviewerId": 1, "reviewDate": "2024-05-01T14:00:00Z", "overallRating": 4.0, "comments": "Good progress (Mock)", "punctuality": 5},
-    102: {"reviewId": 102, "employeeId": 3, "reviewerId": 2, "reviewDate": "2024-05-02T10:30:00Z", "overallRating": 3.5, "comments": "Needs improvement on planning (Mock)", "adequacyPlanning": 2}
+    101: {"reviewId": 101, "employeeId": 2, "reviewerId": 1, "reviewDate": "2024-05-01T14:00:00Z", "overallRating": 4.0, "comments": "Good progress (Mock)",
+          "punctualityRating": 5, "qualityOfWorkRating": 4, "communicationRating": 4, "teamworkRating": 5, "technicalSkillsRating": 4,
+          "problemSolvingRating": 4, "creativityRating": 3, "adaptabilityRating": 4, "leadershipRating": 3, "initiativeRating": 4, "version": 4},
+    102: {"reviewId": 102, "employeeId": 3, "reviewerId": 2, "reviewDate": "2024-05-02T10:30:00Z", "overallRating": 3.5, "comments": "Needs improvement on planning (Mock)",
+          "punctualityRating": 4, "qualityOfWorkRating": 3, "communicationRating": 4, "teamworkRating": 4, "technicalSkillsRating": 3,
+          "problemSolvingRating": 3, "creativityRating": 4, "adaptabilityRating": 2, "leadershipRating": 3, "initiativeRating": 3, "version": 5}
 }
+# Rating keys used by the client's PerformanceReview JSON
+RATING_FIELDS = ["punctualityRating", "qualityOfWorkRating", "communicationRating", "teamworkRating",
+                 "technicalSkillsRating", "problemSolvingRating", "creativityRating", "adaptabilityRating",
+                 "leadershipRating", "initiativeRating"]
+# Every created or modified row takes the next value of this clock as its "version";
+# clients pass the highest version they have seen as ?since= to get only newer rows
+change_clock = 5
+# ids one ?ids= / ?latestFor= multi-get may ask for, as in the native server
+MAX_MULTI_GET_IDS = 500
+
+# Media types a client may ask for with Accept instead of JSON, as NetworkManager::setWireFormat does
+BINARY_ENCODERS = {}
+if msgpack is not None:
+    BINARY_ENCODERS["application/msgpack"] = lambda payload: msgpack.packb(payload, use_bin_type=True)
+if cbor2 is not None:
+    BINARY_ENCODERS["application/cbor"] = cbor2.dumps
+# Bodies below this are sent as they are, gzip would barely shrink them
+GZIP_MIN_BYTES = 512
+
+def next_version():
+    global change_clock
+    change_clock += 1
+    return change_clock
+
+def requested_ids(name):
+    # ?name=1,2,3 as a list of ints, None when absent or malformed
+    text = request.args.get(name)
+    if text is None:
+        return None
+    try:
+        ids = [int(part) for part in text.split(',')]
+    except ValueError:
+        return None
+    return ids if len(ids) <= MAX_MULTI_GET_IDS and all(i > 0 for i in ids) else None
+
+def changed_since(rows):
+    since = request.args.get('since', type=int)
+    if since is None:
+        return list(rows)
+    return [row for row in rows if row.get("version", 0) > since]
+
 next_employee_id = 4
 next_review_id = 103
 
+# --- Response encoding ---
+
+@app.after_request
+def encode_response(response):
+    # JSON answers are re-encoded in the binary format the client prefers, when we have an encoder for it
+    if response.mimetype == "application/json" and BINARY_ENCODERS:
+        best = request.accept_mimetypes.best_match(["application/json"] + list(BINARY_ENCODERS))
+        if best in BINARY_ENCODERS:
+            response.set_data(BINARY_ENCODERS[best](response.get_json()))
+            response.mimetype = best
+        response.vary.add("Accept")
+    # then gzipped for clients that take it
+    if ("gzip" in request.accept_encodings and "Content-Encoding" not in response.headers
+            and not response.direct_passthrough and len(response.get_data()) >= GZIP_MIN_BYTES):
+        response.set_data(gzip.compress(response.get_data(), compresslevel=6))
+        response.headers["Content-Encoding"] = "gzip"
+        response.vary.add("Accept-Encoding")
+    return response
+
 # --- API Endpoints ---
 
 @app.route('/')
@@ -28,8 +103,14 @@ def health_check():
 @app.route('/api/employees', methods=['GET'])
 def get_employees():
     print("GET /api/employees requested")
-    # Return list of all employee values
-    return jsonify(list(mock_employees.values())), 200
+    # ?ids=1,2,3: just those employees in request order, ids without an employee left out
+    if 'ids' in request.args:
+        ids = requested_ids('ids')
+        if ids is None:
+            return jsonify({"error": f"ids must be up to {MAX_MULTI_GET_IDS} comma separated ids"}), 400
+        return jsonify([mock_employees[i] for i in ids if i in mock_employees]), 200
+    # Return list of all employee values, or only those changed after ?since=
+    return jsonify(changed_since(mock_employees.values())), 200
 
 @app.route('/api/employees/<int:employee_id>', methods=['GET'])
 def get_employee(employee_id):
@@ -61,7 +142,8 @@ def add_employee():
         "role": data.get("role"),
         "reportsTo": data.get("reportsTo"), # Assumes client sends ID or null
         "isActive": data.get("isActive", True),
-        "hireDate": data.get("hireDate", datetime.datetime.now(datetime.timezone.utc).isoformat(timespec='seconds') + 'Z')
+        "hireDate": data.get("hireDate", datetime.datetime.now(datetime.timezone.utc).isoformat(timespec='seconds') + 'Z'),
+        "version": next_version()
     }
     mock_employees[next_employee_id] = new_employee
     print(f"Added employee: {new_employee}")
@@ -88,6 +170,7 @@ def update_employee(employee_id):
     employee["reportsTo"] = data.get("reportsTo", employee["reportsTo"])
     employee["isActive"] = data.get("isActive", employee["isActive"])
     employee["hireDate"] = data.get("hireDate", employee["hireDate"])
+    employee["version"] = next_version()
 
     mock_employees[employee_id] = employee # Update in our mock store
     print(f"Updated employee {employee_id}: {employee}")
@@ -99,12 +182,26 @@ def get_reviews():
     employee_id = request.args.get('employeeId', type=int)
     print(f"GET /api/reviews requested (employeeId={employee_id})")
 
+    # ?latestFor=1,2,3: the most recent review of each of those employees, in request order
+    if 'latestFor' in request.args:
+        ids = requested_ids('latestFor')
+        if ids is None:
+            return jsonify({"error": f"latestFor must be up to {MAX_MULTI_GET_IDS} comma separated ids"}), 400
+        latest = {}
+        for review in mock_reviews.values():
+            current = latest.get(review["employeeId"])
+            key = (review["reviewDate"], review["reviewId"])
+            if current is None or key > (current["reviewDate"], current["reviewId"]):
+                latest[review["employeeId"]] = review
+        return jsonify([latest[i] for i in ids if i in latest]), 200
+
+    reviews = changed_since(mock_reviews.values())
     if employee_id is not None:
-        filtered_reviews = [r for r in mock_reviews.values() if r.get("employeeId") == employee_id]
+        filtered_reviews = [r for r in reviews if r.get("employeeId") == employee_id]
         return jsonify(filtered_reviews), 200
     else:
         # Return all reviews if no filter specified (or handle as error)
-        return jsonify(list(mock_reviews.values())), 200
+        return jsonify(reviews), 200
 
 
 @app.route('/api/reviews', methods=['POST'])
@@ -132,11 +229,10 @@ def add_review():
         "reviewDate": data.get("reviewDate", datetime.datetime.now(datetime.timezone.utc).isoformat(timespec='seconds') + 'Z'),
         "overallRating": data.get("overallRating"),
         "comments": data.get("comments"),
-        "punctuality": data.get("punctuality"),
-        "conflictManagement": data.get("conflictManagement"),
-        "adequacyPlanning": data.get("adequacyPlanning"),
-        "taskExecutionSpeed": data.get("taskExecutionSpeed")
     }
+    for field in RATING_FIELDS:
+        new_review[field] = data.get(field)
+    new_review["version"] = next_version()
     mock_reviews[next_review_id] = new_review
     print(f"Added review: {new_review}")
     response_data = new_review # Respond with created object
@@ -144,6 +240,28 @@ def add_review():
     return jsonify(response_data), 201 # 201 Created
 
 
+@app.route('/api/reviews/<int:review_id>', methods=['PUT'])
+def update_review(review_id):
+    print(f"PUT /api/reviews/{review_id} requested")
+    if review_id not in mock_reviews:
+        return jsonify({"error": "Review not found"}), 404
+    if not request.is_json:
+        return jsonify({"error": "Request must be JSON"}), 400
+
+    data = request.get_json()
+    print(f"Received data: {data}")
+
+    # Update existing review (only fields provided in request)
+    review = mock_reviews[review_id]
+    for field in ["reviewerId", "reviewDate", "overallRating", "comments"] + RATING_FIELDS:
+        review[field] = data.get(field, review.get(field))
+    review["employeeId"] = data.get("employeeId", review["employeeId"])
+    review["version"] = next_version()
+
+    print(f"Updated review {review_id}: {review}")
+    return jsonify(review), 200 # 200 OK
+
+
 # --- Run the Server ---
 if __name__ == '__main__':
     # Run on localhost (127.0.0.1) port 5000
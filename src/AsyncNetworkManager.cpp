@@ -0,0 +1,160 @@
+#include <AsyncNetworkManager.hpp>
+#include <Metrics.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace PerfMgmt {
+
+namespace {
+// a request counts as done when the call produced something usable
+bool succeeded(bool result) {
+    return result;
+}
+
+template <typename T>
+bool succeeded(const std::optional<T>& result) {
+    return result.has_value();
+}
+} // namespace
+
+AsyncNetworkManager::AsyncNetworkManager(const std::string& serverBaseUrl, const AsyncNetworkConfig& config)
+    : config(config) {
+    this->config.workerCount = std::max<std::size_t>(1, config.workerCount);
+    this->config.maxInFlight = std::max<std::size_t>(1, config.maxInFlight);
+    this->config.maxAttempts = std::max(1, config.maxAttempts);
+
+    clients.reserve(this->config.workerCount);
+    workers.reserve(this->config.workerCount);
+    for (std::size_t i = 0; i < this->config.workerCount; ++i) {
+        clients.push_back(std::make_unique<NetworkManager>(serverBaseUrl));
+        clients.back()->setWireFormat(this->config.wireFormat);
+    }
+    for (std::size_t i = 0; i < this->config.workerCount; ++i) {
+        workers.emplace_back(&AsyncNetworkManager::workerLoop, this, i);
+    }
+}
+
+AsyncNetworkManager::~AsyncNetworkManager() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<std::optional<Employee>> AsyncNetworkManager::fetchSingleEmployee(int employeeId) {
+    return submit<std::optional<Employee>>(
+        [employeeId](NetworkManager& client) { return client.fetchSingleEmployee(employeeId); });
+}
+
+std::future<std::optional<int>> AsyncNetworkManager::sendNewEmployee(const Employee& employee) {
+    return submit<std::optional<int>>([employee](NetworkManager& client) { return client.sendNewEmployee(employee); },
+                                      Retry::UNSENT_ONLY);
+}
+
+std::future<bool> AsyncNetworkManager::sendUpdatedEmployee(int serverEmployeeId, const Employee& employee) {
+    return submit<bool>([serverEmployeeId, employee](NetworkManager& client) {
+        return client.sendUpdatedEmployee(serverEmployeeId, employee);
+    });
+}
+
+std::future<std::optional<std::vector<PerformanceReview>>>
+AsyncNetworkManager::fetchReviewsForEmployee(int serverEmployeeId) {
+    return submit<std::optional<std::vector<PerformanceReview>>>(
+        [serverEmployeeId](NetworkManager& client) { return client.fetchReviewsForEmployee(serverEmployeeId); });
+}
+
+std::future<std::optional<int>> AsyncNetworkManager::sendNewReview(int serverEmployeeId,
+                                                                   const PerformanceReview& review) {
+    return submit<std::optional<int>>(
+        [serverEmployeeId, review](NetworkManager& client) { return client.sendNewReview(serverEmployeeId, review); },
+        Retry::UNSENT_ONLY);
+}
+
+std::future<bool> AsyncNetworkManager::updateReview(int serverReviewId, const PerformanceReview& review) {
+    return submit<bool>(
+        [serverReviewId, review](NetworkManager& client) { return client.updateReview(serverReviewId, review); });
+}
+
+std::size_t AsyncNetworkManager::inFlight() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return pending;
+}
+
+void AsyncNetworkManager::waitIdle() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    slotFree.wait(lock, [this] { return pending == 0; });
+}
+
+template <typename Result>
+std::future<Result> AsyncNetworkManager::submit(std::function<Result(NetworkManager&)> call, Retry retry) {
+    // std::function needs a copyable target, so the promise is shared
+    auto promise = std::make_shared<std::promise<Result>>();
+    auto future = promise->get_future();
+
+    enqueue([this, promise, call = std::move(call), retry](NetworkManager& client) {
+        try {
+            auto backoff = config.initialBackoff;
+            for (int attempt = 1;; ++attempt) {
+                Result result = call(client);
+                if (succeeded(result) || attempt >= config.maxAttempts || !isTransient(client, retry)) {
+                    promise->set_value(std::move(result));
+                    return;
+                }
+                Metrics::instance().httpRetries.add();
+                std::this_thread::sleep_for(backoff);
+                backoff *= 2;
+            }
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+void AsyncNetworkManager::enqueue(Task task) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    // backpressure: keep at most maxInFlight requests between the caller and the server
+    slotFree.wait(lock, [this] { return pending < config.maxInFlight; });
+    ++pending;
+    tasks.push_back(std::move(task));
+    lock.unlock();
+    taskReady.notify_one();
+}
+
+void AsyncNetworkManager::workerLoop(std::size_t index) {
+    NetworkManager& client = *clients[index];
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task(client);
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            --pending;
+        }
+        slotFree.notify_all();
+    }
+}
+
+bool AsyncNetworkManager::isTransient(const NetworkManager& client, Retry retry) const {
+    if (retry == Retry::UNSENT_ONLY) {
+        // after a timeout or a 5xx the server may have committed the row; only a refused connection is safe
+        return client.lastRequestUnsent();
+    }
+    int statusCode = client.lastStatusCode();
+    // 0: connection refused, reset or timed out before any response arrived
+    return statusCode == 0 || statusCode == 429 || statusCode >= 500;
+}
+
+} // namespace PerfMgmt
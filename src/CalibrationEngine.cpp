@@ -0,0 +1,362 @@
+#include <CalibrationEngine.hpp>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace PerfMgmt {
+
+namespace {
+
+constexpr std::uint32_t NO_EMPLOYEE = std::numeric_limits<std::uint32_t>::max();
+// below this many entries per run a single-threaded sort beats splitting it up
+constexpr std::size_t MIN_SORT_RUN = 16 * 1024;
+// ids spread over at most this many times as many values as there are employees are looked up in a table
+constexpr std::size_t DENSE_ID_SPREAD = 4;
+
+// Runs fn(task) for every task in [0, tasks) on up to threads threads, the calling thread included. Workers
+// take the next task off a shared counter, so uneven tasks still keep every worker busy.
+template <typename Fn>
+void parallelFor(std::size_t tasks, std::size_t threads, Fn&& fn) {
+    std::size_t workers = std::min(threads, tasks);
+    if (workers <= 1) {
+        for (std::size_t task = 0; task < tasks; ++task) {
+            fn(task);
+        }
+        return;
+    }
+    std::atomic<std::size_t> next{0};
+    auto work = [&] {
+        for (std::size_t task = next.fetch_add(1, std::memory_order_relaxed); task < tasks;
+             task = next.fetch_add(1, std::memory_order_relaxed)) {
+            fn(task);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t i = 1; i < workers; ++i) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+// first index of part `part` when count items are cut into parts equal slices
+std::size_t sliceStart(std::size_t count, std::size_t parts, std::size_t part) {
+    return count * std::min(part, parts) / parts;
+}
+
+// Sorts every list with less. Each list is cut into runs that are sorted as independent tasks, then adjacent
+// runs are merged pairwise, the merges of one round again in parallel, until one run is left.
+template <typename T, std::size_t N, typename Less>
+void parallelSort(std::array<std::vector<T>, N>& lists, std::size_t threads, Less less) {
+    std::size_t longest = 0;
+    for (const auto& list : lists) {
+        longest = std::max(longest, list.size());
+    }
+    std::size_t runs = std::clamp<std::size_t>(longest / MIN_SORT_RUN, 1, threads);
+    parallelFor(N * runs, threads, [&](std::size_t task) {
+        auto& list = lists[task / runs];
+        std::size_t run = task % runs;
+        std::sort(list.begin() + sliceStart(list.size(), runs, run),
+                  list.begin() + sliceStart(list.size(), runs, run + 1), less);
+    });
+
+    std::array<std::vector<T>, N> merged;
+    for (std::size_t l = 0; l < N; ++l) {
+        merged[l].resize(lists[l].size());
+    }
+    for (std::size_t width = 1; width < runs; width *= 2) {
+        std::size_t pairs = (runs + 2 * width - 1) / (2 * width);
+        parallelFor(N * pairs, threads, [&](std::size_t task) {
+            const auto& from = lists[task / pairs];
+            auto& to = merged[task / pairs];
+            std::size_t first = 2 * width * (task % pairs);
+            std::size_t low = sliceStart(from.size(), runs, first);
+            std::size_t middle = sliceStart(from.size(), runs, first + width);
+            std::size_t high = sliceStart(from.size(), runs, first + 2 * width);
+            std::merge(from.begin() + low, from.begin() + middle, from.begin() + middle, from.begin() + high,
+                       to.begin() + low, less);
+        });
+        std::swap(lists, merged);
+    }
+}
+
+} // namespace
+
+CalibrationEngine::CalibrationEngine(const CalibrationConfig& config) : config(config) {
+    this->config.threads = std::max<std::size_t>(1, config.threads);
+}
+
+void CalibrationEngine::clear() {
+    employeeIds.clear();
+    roles.clear();
+    for (std::size_t metric = 0; metric < METRIC_COUNT; ++metric) {
+        organization[metric].clear();
+        byRole[metric].clear();
+        roleStart[metric].fill(0);
+        organizationStandings[metric].clear();
+        roleStandings[metric].clear();
+    }
+    ranked = 0;
+    reviewsCounted = 0;
+}
+
+void CalibrationEngine::compute(const EmployeeArena& employees, const ReviewArena& reviews) {
+    clear();
+    const std::size_t threads = config.threads;
+
+    // candidates in id order; scanAllEmployees already delivers them sorted
+    std::vector<std::pair<int, Role>> candidates;
+    candidates.reserve(employees.size());
+    for (const EmployeeRow& employee : employees) {
+        if (employee.isActive || !config.activeOnly) {
+            candidates.emplace_back(employee.employeeId, employee.role);
+        }
+    }
+    if (!std::is_sorted(candidates.begin(), candidates.end())) {
+        std::sort(candidates.begin(), candidates.end());
+    }
+    employeeIds.reserve(candidates.size());
+    roles.reserve(candidates.size());
+    for (const auto& [id, role] : candidates) {
+        employeeIds.push_back(id);
+        roles.push_back(role);
+    }
+    const std::size_t employeeCount = employeeIds.size();
+
+    // Partition the reviews by the id range of the employee they are about, one range per worker, with a
+    // parallel counting sort: every chunk of reviews counts its reviews per range, a prefix sum turns the
+    // counts into each chunk's write positions, and every chunk scatters its review indices there.
+    const std::size_t parts = std::max<std::size_t>(1, std::min(threads, employeeCount));
+    const std::size_t chunks = threads;
+    auto rangeOf = [employeeCount, parts](std::uint32_t employee) {
+        return static_cast<std::size_t>(employee) * parts / employeeCount;
+    };
+    // employee id -> index: a direct table when the ids are dense, as sqlite's rowids usually are
+    std::vector<std::uint32_t> denseIndex;
+    if (employeeCount > 0 &&
+        static_cast<std::size_t>(employeeIds.back()) - employeeIds.front() < DENSE_ID_SPREAD * employeeCount) {
+        denseIndex.assign(static_cast<std::size_t>(employeeIds.back()) - employeeIds.front() + 1, NO_EMPLOYEE);
+        for (std::size_t employee = 0; employee < employeeCount; ++employee) {
+            denseIndex[static_cast<std::size_t>(employeeIds[employee]) - employeeIds.front()] =
+                static_cast<std::uint32_t>(employee);
+        }
+    }
+    auto indexOf = [&](int employeeId) {
+        if (!denseIndex.empty()) {
+            auto offset = static_cast<std::size_t>(employeeId) - employeeIds.front();
+            return employeeId < employeeIds.front() || offset >= denseIndex.size() ? NO_EMPLOYEE : denseIndex[offset];
+        }
+        auto it = std::lower_bound(employeeIds.begin(), employeeIds.end(), employeeId);
+        return it == employeeIds.end() || *it != employeeId ? NO_EMPLOYEE
+                                                            : static_cast<std::uint32_t>(it - employeeIds.begin());
+    };
+    std::vector<std::uint32_t> owners(reviews.size());
+    std::vector<std::size_t> offsets(chunks * parts, 0); // [chunk * parts + range]
+    parallelFor(chunks, threads, [&](std::size_t chunk) {
+        std::size_t* counts = &offsets[chunk * parts];
+        std::size_t last = sliceStart(reviews.size(), chunks, chunk + 1);
+        for (std::size_t r = sliceStart(reviews.size(), chunks, chunk); r < last; ++r) {
+            const ReviewRow& review = reviews[r];
+            owners[r] = NO_EMPLOYEE;
+            if ((config.fromDay != NO_DAY && (review.reviewDay == NO_DAY || review.reviewDay < config.fromDay)) ||
+                (config.toDay != NO_DAY && (review.reviewDay == NO_DAY || review.reviewDay >= config.toDay))) {
+                continue;
+            }
+            owners[r] = indexOf(review.employeeId);
+            if (owners[r] != NO_EMPLOYEE) {
+                ++counts[rangeOf(owners[r])];
+            }
+        }
+    });
+    // exclusive prefix sum in (range, chunk) order, so every range's reviews end up contiguous
+    std::vector<std::size_t> rangeStart(parts + 1, 0);
+    std::size_t total = 0;
+    for (std::size_t range = 0; range < parts; ++range) {
+        rangeStart[range] = total;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            std::size_t count = offsets[chunk * parts + range];
+            offsets[chunk * parts + range] = total;
+            total += count;
+        }
+    }
+    rangeStart[parts] = total;
+    reviewsCounted = total;
+    std::vector<std::uint32_t> grouped(total);
+    parallelFor(chunks, threads, [&](std::size_t chunk) {
+        std::size_t* next = &offsets[chunk * parts];
+        std::size_t last = sliceStart(reviews.size(), chunks, chunk + 1);
+        for (std::size_t r = sliceStart(reviews.size(), chunks, chunk); r < last; ++r) {
+            if (owners[r] != NO_EMPLOYEE) {
+                grouped[next[rangeOf(owners[r])]++] = static_cast<std::uint32_t>(r);
+            }
+        }
+    });
+
+    // every worker sums the reviews of its own employees, nobody else writes to them
+    std::array<std::vector<double>, METRIC_COUNT> sums;
+    for (auto& metricSums : sums) {
+        metricSums.assign(employeeCount, 0.0);
+    }
+    std::vector<std::uint32_t> reviewCounts(employeeCount, 0);
+    std::vector<std::uint32_t> overallCounts(employeeCount, 0);
+    parallelFor(parts, threads, [&](std::size_t range) {
+        for (std::size_t g = rangeStart[range]; g < rangeStart[range + 1]; ++g) {
+            const ReviewRow& review = reviews[grouped[g]];
+            std::uint32_t employee = owners[grouped[g]];
+            ++reviewCounts[employee];
+            for (std::size_t kpi = 0; kpi < KPI_COUNT; ++kpi) {
+                sums[kpi][employee] += review.kpis[kpi];
+            }
+            if (review.overallRating) {
+                ++overallCounts[employee];
+                sums[OVERALL][employee] += *review.overallRating;
+            }
+        }
+    });
+    ranked = static_cast<std::size_t>(
+        std::count_if(reviewCounts.begin(), reviewCounts.end(), [](std::uint32_t count) { return count > 0; }));
+
+    // one entry per employee with a score on the metric
+    parallelFor(METRIC_COUNT, threads, [&](std::size_t metric) {
+        const auto& counts = metric == OVERALL ? overallCounts : reviewCounts;
+        auto& entries = organization[metric];
+        entries.reserve(employeeCount);
+        for (std::size_t employee = 0; employee < employeeCount; ++employee) {
+            if (counts[employee] > 0) {
+                float mean = static_cast<float>(sums[metric][employee] / counts[employee]);
+                entries.push_back({mean, static_cast<std::uint32_t>(employee)});
+            }
+        }
+    });
+
+    // best score first, ties in id order so the rankings are reproducible
+    parallelSort(organization, threads, [](const Entry& a, const Entry& b) {
+        return a.score > b.score || (a.score == b.score && a.employee < b.employee);
+    });
+
+    // stable partition by role keeps every role's entries best first
+    parallelFor(METRIC_COUNT, threads, [&](std::size_t metric) {
+        const auto& entries = organization[metric];
+        auto& starts = roleStart[metric];
+        std::array<std::size_t, ROLE_COUNT> next{};
+        for (const Entry& entry : entries) {
+            ++next[static_cast<std::size_t>(roles[entry.employee])];
+        }
+        for (std::size_t role = 0, start = 0; role < ROLE_COUNT; ++role) {
+            starts[role] = start;
+            start += next[role];
+            next[role] = starts[role];
+        }
+        starts[ROLE_COUNT] = entries.size();
+        byRole[metric].resize(entries.size());
+        for (const Entry& entry : entries) {
+            byRole[metric][next[static_cast<std::size_t>(roles[entry.employee])]++] = entry;
+        }
+        organizationStandings[metric].assign(employeeCount, Standing{});
+        roleStandings[metric].assign(employeeCount, Standing{});
+    });
+
+    // the organization and every role of every metric rank independently; the roles of one metric write disjoint
+    // employees of roleStandings
+    parallelFor(METRIC_COUNT * (ROLE_COUNT + 1), threads, [&](std::size_t task) {
+        std::size_t metric = task / (ROLE_COUNT + 1);
+        std::size_t scope = task % (ROLE_COUNT + 1);
+        if (scope == ROLE_COUNT) {
+            rank(organization[metric].data(), organization[metric].size(), organizationStandings[metric]);
+        } else {
+            const auto& starts = roleStart[metric];
+            rank(byRole[metric].data() + starts[scope], starts[scope + 1] - starts[scope], roleStandings[metric]);
+        }
+    });
+}
+
+void CalibrationEngine::rank(const Entry* entries, std::size_t count, std::vector<Standing>& standings) {
+    if (count == 0) {
+        return;
+    }
+    double sum = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += entries[i].score;
+    }
+    double mean = sum / count;
+    double squares = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        squares += (entries[i].score - mean) * (entries[i].score - mean);
+    }
+    double stddev = std::sqrt(squares / count);
+
+    for (std::size_t first = 0; first < count;) {
+        std::size_t last = first + 1;
+        while (last < count && entries[last].score == entries[first].score) {
+            ++last;
+        }
+        // count - last score lower, last - first tie
+        float percentile = static_cast<float>(100.0 * ((count - last) + 0.5 * (last - first)) / count);
+        float zScore = stddev > 0.0 ? static_cast<float>((entries[first].score - mean) / stddev) : 0.0f;
+        for (std::size_t i = first; i < last; ++i) {
+            standings[entries[i].employee] = {entries[i].score, static_cast<std::uint32_t>(first + 1), percentile,
+                                              zScore};
+        }
+        first = last;
+    }
+}
+
+std::optional<Standing> CalibrationEngine::find(int employeeId, std::size_t metric, CalibrationScope scope) const {
+    auto it = std::lower_bound(employeeIds.begin(), employeeIds.end(), employeeId);
+    if (it == employeeIds.end() || *it != employeeId) {
+        return std::nullopt;
+    }
+    const auto& standings = scope == CalibrationScope::ORGANIZATION ? organizationStandings : roleStandings;
+    const Standing& standing = standings[metric][static_cast<std::size_t>(it - employeeIds.begin())];
+    if (standing.rank == 0) {
+        return std::nullopt;
+    }
+    return standing;
+}
+
+std::vector<int> CalibrationEngine::ids(std::size_t metric, CalibrationScope scope, Role role) const {
+    const Entry* first = organization[metric].data();
+    const Entry* last = first + organization[metric].size();
+    if (scope == CalibrationScope::ROLE) {
+        const auto& starts = roleStart[metric];
+        std::size_t index = static_cast<std::size_t>(role);
+        first = byRole[metric].data() + starts[index];
+        last = byRole[metric].data() + starts[index + 1];
+    }
+    std::vector<int> result;
+    result.reserve(static_cast<std::size_t>(last - first));
+    for (const Entry* entry = first; entry != last; ++entry) {
+        result.push_back(employeeIds[entry->employee]);
+    }
+    return result;
+}
+
+std::optional<Standing> CalibrationEngine::standing(int employeeId, Kpi kpi, CalibrationScope scope) const {
+    return find(employeeId, static_cast<std::size_t>(kpi), scope);
+}
+
+std::optional<Standing> CalibrationEngine::overallStanding(int employeeId, CalibrationScope scope) const {
+    return find(employeeId, OVERALL, scope);
+}
+
+std::vector<int> CalibrationEngine::ranking(Kpi kpi, CalibrationScope scope, Role role) const {
+    return ids(static_cast<std::size_t>(kpi), scope, role);
+}
+
+std::vector<int> CalibrationEngine::overallRanking(CalibrationScope scope, Role role) const {
+    return ids(OVERALL, scope, role);
+}
+
+std::size_t CalibrationEngine::rankedEmployees() const {
+    return ranked;
+}
+
+std::size_t CalibrationEngine::countedReviews() const {
+    return reviewsCounted;
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,115 @@
+#include "ChangeFeed.hpp"
+#include <algorithm>
+
+namespace PerfMgmt {
+
+namespace {
+std::size_t powerOfTwoAtLeast(std::size_t value) {
+    std::size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+} // namespace
+
+ChangeFeed::ChangeFeed(std::size_t capacity)
+    : slots(std::make_unique<Slot[]>(powerOfTwoAtLeast(capacity))), mask(powerOfTwoAtLeast(capacity) - 1) {}
+
+std::uint64_t ChangeFeed::publish(ChangeKind kind, int employeeId, int reviewId) {
+    std::uint64_t sequence = published.load(std::memory_order_relaxed) + 1;
+    Slot& slot = slots[sequence & mask];
+    // the payload stores are releases so that a reader seeing any of them also sees the odd stamp before them
+    // and drops its copy; on x86 these are plain moves, and unlike fences ThreadSanitizer understands them
+    slot.stamp.store(2 * sequence - 1, std::memory_order_relaxed);
+    slot.kind.store(kind, std::memory_order_release);
+    slot.employeeId.store(employeeId, std::memory_order_release);
+    slot.reviewId.store(reviewId, std::memory_order_release);
+    slot.stamp.store(2 * sequence, std::memory_order_release);
+    published.store(sequence, std::memory_order_release);
+    return sequence;
+}
+
+ChangeFeed::ReadStatus ChangeFeed::read(std::uint64_t sequence, ChangeEvent& event) const {
+    const Slot& slot = slots[sequence & mask];
+    std::uint64_t before = slot.stamp.load(std::memory_order_acquire);
+    if (before != 2 * sequence) {
+        // the slot is stamped before published moves, so a smaller stamp means the event is not out yet
+        return before < 2 * sequence ? ReadStatus::NOT_YET : ReadStatus::OVERWRITTEN;
+    }
+    event.sequence = sequence;
+    // acquires keep the second stamp load behind the payload loads
+    event.kind = slot.kind.load(std::memory_order_acquire);
+    event.employeeId = slot.employeeId.load(std::memory_order_acquire);
+    event.reviewId = slot.reviewId.load(std::memory_order_acquire);
+    return slot.stamp.load(std::memory_order_relaxed) == before ? ReadStatus::READY : ReadStatus::OVERWRITTEN;
+}
+
+ChangeSubscription ChangeFeed::subscribe() const {
+    return ChangeSubscription(*this, lastSequence() + 1);
+}
+
+ChangeSubscription ChangeFeed::subscribeFrom(std::uint64_t sequence) const {
+    return ChangeSubscription(*this, std::max<std::uint64_t>(sequence, 1));
+}
+
+std::uint64_t ChangeFeed::lastSequence() const {
+    return published.load(std::memory_order_acquire);
+}
+
+std::size_t ChangeFeed::capacity() const {
+    return mask + 1;
+}
+
+ChangeSubscription::ChangeSubscription(const ChangeFeed& feed, std::uint64_t sequence)
+    : feed(&feed), sequence(sequence) {}
+
+std::optional<ChangeEvent> ChangeSubscription::next() {
+    ChangeEvent event;
+    while (true) {
+        std::uint64_t last = feed->lastSequence();
+        if (sequence > last) {
+            return std::nullopt;
+        }
+        std::uint64_t oldest = last > feed->mask ? last - feed->mask : 1;
+        if (sequence < oldest) {
+            skipped += oldest - sequence;
+            sequence = oldest;
+        }
+        switch (feed->read(sequence, event)) {
+        case ChangeFeed::ReadStatus::READY:
+            ++sequence;
+            return event;
+        case ChangeFeed::ReadStatus::NOT_YET:
+            return std::nullopt;
+        case ChangeFeed::ReadStatus::OVERWRITTEN:
+            // lapped, the slot already holds or is taking a newer event: this one is lost
+            ++skipped;
+            ++sequence;
+            break;
+        }
+    }
+}
+
+std::size_t ChangeSubscription::poll(std::vector<ChangeEvent>& events, std::size_t maxEvents) {
+    std::size_t appended{0};
+    while (appended < maxEvents) {
+        auto event = next();
+        if (!event) {
+            break;
+        }
+        events.push_back(*event);
+        ++appended;
+    }
+    return appended;
+}
+
+std::uint64_t ChangeSubscription::nextSequence() const {
+    return sequence;
+}
+
+std::uint64_t ChangeSubscription::missed() const {
+    return skipped;
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,203 @@
+#include "ConnectionPool.hpp"
+#include <Metrics.hpp>
+#include <iostream>
+
+namespace PerfMgmt {
+
+namespace {
+// the delay schedule of sqlite3_busy_timeout, so waits behave the same while being counted
+constexpr int BUSY_DELAYS_MS[] = {1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100};
+constexpr int BUSY_DELAY_COUNT = static_cast<int>(sizeof(BUSY_DELAYS_MS) / sizeof(BUSY_DELAYS_MS[0]));
+
+// context is the pool's busyTimeout; returning 0 gives up and lets the statement fail with SQLITE_BUSY
+int countingBusyHandler(void* context, int attempt) {
+    auto timeout = static_cast<int>(static_cast<const std::chrono::milliseconds*>(context)->count());
+    const int lastDelay = BUSY_DELAYS_MS[BUSY_DELAY_COUNT - 1];
+    int delay = attempt < BUSY_DELAY_COUNT ? BUSY_DELAYS_MS[attempt] : lastDelay;
+    int waited = 0;
+    for (int i = 0; i < attempt && i < BUSY_DELAY_COUNT; ++i) {
+        waited += BUSY_DELAYS_MS[i];
+    }
+    if (attempt > BUSY_DELAY_COUNT) {
+        waited += lastDelay * (attempt - BUSY_DELAY_COUNT);
+    }
+    if (waited + delay > timeout) {
+        delay = timeout - waited;
+        if (delay <= 0) {
+            return 0;
+        }
+    }
+    Metrics::instance().dbBusyRetries.add();
+    sqlite3_sleep(delay);
+    return 1;
+}
+} // namespace
+
+PooledConnection::PooledConnection(const std::string& dbAddress, const sqlite::sqlite_config& config) :
+    db(dbAddress, config), statements(db) {
+}
+
+ConnectionPool::Lease::Lease(ConnectionPool* pool, PooledConnection* connection,
+                             std::unique_lock<std::recursive_mutex> writerLock) :
+    pool(pool), connection(connection), writerLock(std::move(writerLock)) {
+}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept :
+    pool(other.pool), connection(other.connection), writerLock(std::move(other.writerLock)) {
+    other.connection = nullptr;
+}
+
+ConnectionPool::Lease::~Lease() {
+    if (!connection) {
+        return;
+    }
+    // writer leases are returned by releasing writerLock, after this body
+    if (writerLock.owns_lock()) {
+        pool->releaseWriter();
+    } else {
+        pool->release(connection);
+    }
+}
+
+PooledConnection& ConnectionPool::Lease::operator*() const {
+    return *connection;
+}
+
+PooledConnection* ConnectionPool::Lease::operator->() const {
+    return connection;
+}
+
+ConnectionPool::ConnectionPool(const std::string& dbAddress, const PoolConfig& config) :
+    dbAddress(dbAddress), config(config) {
+    sqlite::sqlite_config writerConfig;
+    // the pool guarantees a connection is only used by one thread at a time
+    // URI filenames let a connection setup attach further databases read-only
+    writerConfig.flags = sqlite::OpenFlags::READWRITE | sqlite::OpenFlags::CREATE | sqlite::OpenFlags::NOMUTEX |
+                         sqlite::OpenFlags::URI;
+    writer = std::make_unique<PooledConnection>(dbAddress, writerConfig);
+    configure(*writer, true);
+}
+
+void ConnectionPool::openReaders() {
+    std::lock_guard<std::mutex> lock(readersMutex);
+    if (!readers.empty()) {
+        return;
+    }
+    sqlite::sqlite_config readerConfig;
+    readerConfig.flags = sqlite::OpenFlags::READONLY | sqlite::OpenFlags::NOMUTEX | sqlite::OpenFlags::URI;
+    for (std::size_t i = 0; i < config.readerCount; ++i) {
+        readers.push_back(std::make_unique<PooledConnection>(dbAddress, readerConfig));
+        configure(*readers.back(), false);
+        idleReaders.push_back(readers.back().get());
+    }
+}
+
+void ConnectionPool::configure(PooledConnection& connection, bool isWriter) {
+    // same waits as sqlite3_busy_timeout, but every one of them shows up in Metrics::dbBusyRetries
+    sqlite3_busy_handler(connection.db.connection().get(), countingBusyHandler, &config.busyTimeout);
+    // journal_mode is persistent in the file, only the writer has to set it
+    if (isWriter && config.walMode) {
+        std::string journalMode;
+        connection.db << "PRAGMA journal_mode=WAL;" >> journalMode;
+        if (journalMode != "wal") {
+            std::cerr << "[ConnectionPool] : " << "WAL mode not available, journal mode is " << journalMode
+                      << std::endl;
+        }
+    }
+}
+
+ConnectionPool::Lease ConnectionPool::acquireReader() {
+    std::thread::id self = std::this_thread::get_id();
+    if (config.readerCount == 0 || writerOwner.load(std::memory_order_relaxed) == self) {
+        return acquireWriter();
+    }
+    std::unique_lock<std::mutex> lock(readersMutex);
+    for (const auto& reader : readers) {
+        if (reader->leaseCount > 0 && reader->owner == self) {
+            // nested lease: the connection is in use further up this thread's stack, so no setup either
+            ++reader->leaseCount;
+            return Lease(this, reader.get(), std::unique_lock<std::recursive_mutex>());
+        }
+    }
+    readerAvailable.wait(lock, [this] { return !idleReaders.empty(); });
+    PooledConnection* connection = idleReaders.back();
+    idleReaders.pop_back();
+    connection->owner = self;
+    connection->leaseCount = 1;
+    lock.unlock();
+    Lease lease(this, connection, std::unique_lock<std::recursive_mutex>());
+    applySetup(*connection);
+    return lease;
+}
+
+ConnectionPool::Lease ConnectionPool::acquireWriter() {
+    Lease lease(this, writer.get(), std::unique_lock<std::recursive_mutex>(writerMutex));
+    if (writerDepth++ == 0) {
+        writerOwner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    }
+    applySetup(*writer);
+    return lease;
+}
+
+void ConnectionPool::setConnectionSetup(ConnectionSetup connectionSetup) {
+    std::lock_guard<std::mutex> lock(setupMutex);
+    setup = std::make_shared<const ConnectionSetup>(std::move(connectionSetup));
+    setupGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void ConnectionPool::applySetup(PooledConnection& connection) {
+    // a single atomic load per lease while nothing changed
+    if (connection.setupGeneration == setupGeneration.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::shared_ptr<const ConnectionSetup> current;
+    {
+        std::lock_guard<std::mutex> lock(setupMutex);
+        current = setup;
+        connection.setupGeneration = setupGeneration.load(std::memory_order_relaxed);
+    }
+    if (current && *current) {
+        (*current)(connection);
+    }
+}
+
+void ConnectionPool::release(PooledConnection* connection) {
+    {
+        std::lock_guard<std::mutex> lock(readersMutex);
+        if (--connection->leaseCount > 0) {
+            return;
+        }
+        connection->owner = std::thread::id();
+        idleReaders.push_back(connection);
+    }
+    readerAvailable.notify_one();
+}
+
+void ConnectionPool::releaseWriter() {
+    // still under writerMutex; only the owner can see its own id, so a relaxed store is enough
+    if (--writerDepth == 0) {
+        writerOwner.store(std::thread::id(), std::memory_order_relaxed);
+    }
+}
+
+std::size_t ConnectionPool::readerCount() const {
+    return config.readerCount;
+}
+
+std::size_t ConnectionPool::statementCacheHits() const {
+    std::size_t hits = writer->statements.hits();
+    for (const auto& reader : readers) {
+        hits += reader->statements.hits();
+    }
+    return hits;
+}
+
+std::size_t ConnectionPool::statementCacheMisses() const {
+    std::size_t misses = writer->statements.misses();
+    for (const auto& reader : readers) {
+        misses += reader->statements.misses();
+    }
+    return misses;
+}
+
+} // namespace PerfMgmt
@@ -1,15 +1,552 @@
 #include "DatabaseManager.hpp"
+#include <Metrics.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace PerfMgmt {
 
-DatabaseManager::DatabaseManager(const std::string& dbAddress) : db(dbAddress) {
+namespace {
+// column lists in RowMapping order: readRow / bindRow / bindUpdate rely on it, the static_asserts enforce it
+constexpr std::string_view EMPLOYEE_COLUMNS =
+    "employee_id, name, role, reports_to, hire_date, personnel_code, is_active";
+constexpr std::string_view REVIEW_COLUMNS =
+    "review_id, employee_id, reviewer_id, review_date, overall_rating, comments, punctuality_rating, "
+    "quality_of_work_rating, teamwork_rating, communication_rating, problem_solving_rating, creativity_rating, "
+    "technical_skills_rating, adaptability_rating, leadership_rating, initiative_rating";
+constexpr std::string_view EMPLOYEE_UPDATE_COLUMNS =
+    "name = ?, role = ?, reports_to = ?, hire_date = ?, personnel_code = ?, is_active = ?";
+// an empty review date keeps the stored one
+constexpr std::string_view REVIEW_UPDATE_COLUMNS =
+    "employee_id = ?, reviewer_id = ?, review_date = COALESCE(NULLIF(?, ''), review_date), overall_rating = ?, "
+    "comments = ?, punctuality_rating = ?, quality_of_work_rating = ?, teamwork_rating = ?, "
+    "communication_rating = ?, problem_solving_rating = ?, creativity_rating = ?, technical_skills_rating = ?, "
+    "adaptability_rating = ?, leadership_rating = ?, initiative_rating = ?";
+static_assert(matchesColumns<Employee>(EMPLOYEE_COLUMNS), "EMPLOYEE_COLUMNS must follow RowMapping<Employee>");
+static_assert(matchesColumns<PerformanceReview>(REVIEW_COLUMNS),
+              "REVIEW_COLUMNS must follow RowMapping<PerformanceReview>");
+static_assert(matchesColumns<Employee>(EMPLOYEE_UPDATE_COLUMNS, true),
+              "EMPLOYEE_UPDATE_COLUMNS must follow RowMapping<Employee>");
+static_assert(matchesColumns<PerformanceReview>(REVIEW_UPDATE_COLUMNS, true),
+              "REVIEW_UPDATE_COLUMNS must follow RowMapping<PerformanceReview>");
+
+const std::string INSERT_EMPLOYEE_SQL =
+    "INSERT INTO employees (" + std::string(EMPLOYEE_COLUMNS) + ") VALUES (?, ?, ?, ?, ?, ?, ?);";
+
+// an empty review date falls back to the column default
+const std::string INSERT_REVIEW_SQL = "INSERT INTO performance_reviews (" + std::string(REVIEW_COLUMNS) +
+                                      ") VALUES (?, ?, ?, COALESCE(NULLIF(?, ''), CURRENT_DATE), ?, ?, ?, ?, ?, ?, "
+                                      "?, ?, ?, ?, ?, ?);";
+
+const std::string SELECT_EMPLOYEE_SQL =
+    "SELECT " + std::string(EMPLOYEE_COLUMNS) + " FROM employees WHERE employee_id = ?;";
+// multi-gets bind the requested ids as one JSON array, so any number of them is a single prepared statement
+const std::string SELECT_EMPLOYEES_BY_ID_SQL = "SELECT " + std::string(EMPLOYEE_COLUMNS) +
+                                               " FROM employees WHERE employee_id IN (SELECT value FROM json_each(?));";
+const std::string SELECT_ALL_EMPLOYEES_SQL = "SELECT " + std::string(EMPLOYEE_COLUMNS) + " FROM employees;";
+const std::string STREAM_EMPLOYEES_SQL =
+    "SELECT " + std::string(EMPLOYEE_COLUMNS) + " FROM employees ORDER BY employee_id;";
+const std::string SELECT_REPORTS_SQL =
+    "SELECT " + std::string(EMPLOYEE_COLUMNS) + " FROM employees WHERE reports_to = ?;";
+const std::string UPDATE_EMPLOYEE_SQL =
+    "UPDATE employees SET " + std::string(EMPLOYEE_UPDATE_COLUMNS) + " WHERE employee_id = ?;";
+const std::string DEACTIVATE_EMPLOYEE_SQL = "UPDATE employees SET is_active = ? WHERE employee_id = ?;";
+const std::string SELECT_REVIEW_SQL =
+    "SELECT " + std::string(REVIEW_COLUMNS) + " FROM review_history WHERE review_id = ?;";
+// the employee's latest review across the partitions, the same ordering as SELECT_LATEST_REVIEWS_SQL
+const std::string SELECT_EMPLOYEE_REVIEW_SQL =
+    "SELECT " + std::string(REVIEW_COLUMNS) + " FROM review_history WHERE employee_id = ? "
+    "ORDER BY review_date DESC, review_id DESC LIMIT 1;";
+// one idx_review_employee_date probe per requested employee and partition
+const std::string SELECT_LATEST_REVIEWS_SQL =
+    "SELECT " + std::string(REVIEW_COLUMNS) + " FROM review_history WHERE review_id IN (SELECT (SELECT "
+    "latest.review_id FROM review_history AS latest WHERE latest.employee_id = ids.value ORDER BY "
+    "latest.review_date DESC, latest.review_id DESC LIMIT 1) FROM json_each(?) AS ids);";
+const std::string UPDATE_REVIEW_SQL =
+    "UPDATE performance_reviews SET " + std::string(REVIEW_UPDATE_COLUMNS) + " WHERE review_id = ?;";
+const std::string DELETE_REVIEW_SQL = "DELETE FROM performance_reviews WHERE review_id = ?;";
+const std::string SELECT_ALL_REVIEWS_SQL = "SELECT " + std::string(REVIEW_COLUMNS) + " FROM review_history;";
+const std::string SELECT_REVIEW_COMMENTS_SQL = "SELECT " + std::string(REVIEW_COLUMNS) +
+                                               " FROM review_history WHERE comments IS NOT NULL AND comments <> '';";
+const std::string COUNT_REVIEWS_SQL = "SELECT COUNT(*) FROM review_history;";
+const std::string COUNT_EMPLOYEES_SQL = "SELECT COUNT(*) FROM employees;";
+const std::string SELECT_REVIEW_ROWS_SQL =
+    "SELECT " + std::string(REVIEW_COLUMNS) + " FROM review_history ORDER BY review_id;";
+// positions of the REVIEW_COLUMNS a ReviewRow is decoded from, taken from the mapping rather than counted by hand
+constexpr int REVIEW_ID_COLUMN = columnIndex<PerformanceReview>("review_id");
+constexpr int REVIEW_EMPLOYEE_COLUMN = columnIndex<PerformanceReview>("employee_id");
+constexpr int REVIEW_REVIEWER_COLUMN = columnIndex<PerformanceReview>("reviewer_id");
+constexpr int REVIEW_DATE_COLUMN = columnIndex<PerformanceReview>("review_date");
+constexpr int REVIEW_OVERALL_COLUMN = columnIndex<PerformanceReview>("overall_rating");
+constexpr int REVIEW_COMMENTS_COLUMN = columnIndex<PerformanceReview>("comments");
+// KPI columns in Kpi order, as ReviewRow stores them
+constexpr std::array<std::string_view, KPI_COUNT> KPI_COLUMN_NAMES{
+    "punctuality_rating", "quality_of_work_rating", "communication_rating", "teamwork_rating",
+    "technical_skills_rating", "problem_solving_rating", "creativity_rating", "adaptability_rating",
+    "leadership_rating", "initiative_rating"};
+constexpr std::array<int, KPI_COUNT> reviewKpiColumns() {
+    std::array<int, KPI_COUNT> columns{};
+    for (std::size_t k = 0; k < KPI_COUNT; ++k) {
+        columns[k] = columnIndex<PerformanceReview>(KPI_COLUMN_NAMES[k]);
+    }
+    return columns;
+}
+constexpr std::array<int, KPI_COUNT> REVIEW_KPI_COLUMNS = reviewKpiColumns();
+constexpr bool allMapped(const std::array<int, KPI_COUNT>& columns) {
+    for (int column : columns) {
+        if (column < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(REVIEW_ID_COLUMN >= 0 && REVIEW_EMPLOYEE_COLUMN >= 0 && REVIEW_REVIEWER_COLUMN >= 0 &&
+                  REVIEW_DATE_COLUMN >= 0 && REVIEW_OVERALL_COLUMN >= 0 && REVIEW_COMMENTS_COLUMN >= 0 &&
+                  allMapped(REVIEW_KPI_COLUMNS),
+              "every column a ReviewRow is decoded from must be mapped by RowMapping<PerformanceReview>");
+// rows pulled from the server: inserted as already synced, and never overwrite local edits that are not pushed yet
+const std::string UPSERT_REMOTE_EMPLOYEE_SQL =
+    "INSERT INTO employees (" + std::string(EMPLOYEE_COLUMNS) +
+    ", local_version, synced_version) VALUES (?, ?, ?, ?, ?, ?, ?, 1, 1) ON CONFLICT(employee_id) DO UPDATE SET "
+    "name = excluded.name, role = excluded.role, reports_to = excluded.reports_to, hire_date = excluded.hire_date, "
+    "personnel_code = excluded.personnel_code, is_active = excluded.is_active, local_version = local_version + 1, "
+    "synced_version = local_version + 1 WHERE local_version = synced_version;";
+const std::string UPSERT_REMOTE_REVIEW_SQL =
+    "INSERT INTO performance_reviews (" + std::string(REVIEW_COLUMNS) +
+    ", local_version, synced_version) VALUES (?, ?, ?, "
+    "COALESCE(NULLIF(?, ''), CURRENT_DATE), ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, 1, 1) ON CONFLICT(review_id) DO "
+    "UPDATE SET employee_id = excluded.employee_id, reviewer_id = excluded.reviewer_id, review_date = "
+    "excluded.review_date, overall_rating = excluded.overall_rating, comments = excluded.comments, "
+    "punctuality_rating = excluded.punctuality_rating, quality_of_work_rating = excluded.quality_of_work_rating, "
+    "teamwork_rating = excluded.teamwork_rating, communication_rating = excluded.communication_rating, "
+    "problem_solving_rating = excluded.problem_solving_rating, creativity_rating = excluded.creativity_rating, "
+    "technical_skills_rating = excluded.technical_skills_rating, adaptability_rating = excluded.adaptability_rating, "
+    "leadership_rating = excluded.leadership_rating, initiative_rating = excluded.initiative_rating, "
+    "local_version = local_version + 1, synced_version = local_version + 1 WHERE local_version = synced_version;";
+// a row referencing an employee the server has never seen waits for that employee's POST: its local id would
+// name another row on the server, adopting the server's id rewrites the reference and frees the row
+const std::string SELECT_DIRTY_EMPLOYEES_SQL =
+    "SELECT " + std::string(EMPLOYEE_COLUMNS) + ", local_version, synced_version = 0 FROM employees "
+    "WHERE local_version > synced_version AND employee_id > ? AND NOT EXISTS (SELECT 1 FROM employees AS manager "
+    "WHERE manager.employee_id = employees.reports_to AND manager.employee_id <> employees.employee_id AND "
+    "manager.synced_version = 0) ORDER BY employee_id LIMIT ?;";
+// keyset pages: seek past (review_date, review_id) of the previous page, one extra row tells if another page follows
+const std::string SELECT_REVIEW_PAGE_COLUMNS = "SELECT " + std::string(REVIEW_COLUMNS) + " FROM review_history ";
+const std::string REVIEW_PAGE_KEYSET =
+    "(review_date, review_id) > (?, ?) ORDER BY review_date, review_id LIMIT ?;";
+const std::string SELECT_EMPLOYEE_REVIEW_PAGE_SQL =
+    SELECT_REVIEW_PAGE_COLUMNS + "WHERE employee_id = ? AND " + REVIEW_PAGE_KEYSET;
+const std::string SELECT_REVIEWER_REVIEW_PAGE_SQL =
+    SELECT_REVIEW_PAGE_COLUMNS + "WHERE reviewer_id = ? AND " + REVIEW_PAGE_KEYSET;
+const std::string SELECT_SNAPSHOT_REVIEWS_SQL = SELECT_REVIEW_PAGE_COLUMNS + "ORDER BY employee_id, review_date;";
+const std::string SELECT_DIRTY_REVIEWS_SQL =
+    "SELECT " + std::string(REVIEW_COLUMNS) + ", local_version, synced_version = 0 FROM performance_reviews "
+    "WHERE local_version > synced_version AND review_id > ? AND NOT EXISTS (SELECT 1 FROM employees WHERE "
+    "employees.employee_id IN (performance_reviews.employee_id, performance_reviews.reviewer_id) AND "
+    "employees.synced_version = 0) ORDER BY review_id LIMIT ?;";
+const std::string MARK_EMPLOYEE_SYNCED_SQL =
+    "UPDATE employees SET synced_version = MAX(synced_version, ?) WHERE employee_id = ?;";
+const std::string MARK_REVIEW_SYNCED_SQL =
+    "UPDATE performance_reviews SET synced_version = MAX(synced_version, ?) WHERE review_id = ?;";
+// A row created offline keeps its local id until its POST returns the one the server assigned. Renumbering an
+// employee rewrites the rows pointing at it as well, which the edit triggers turn dirty
+const std::string SELECT_MAX_EMPLOYEE_ID_SQL = "SELECT COALESCE(MAX(employee_id), 0) FROM employees;";
+const std::string SELECT_MAX_REVIEW_ID_SQL = "SELECT COALESCE(MAX(review_id), 0) FROM performance_reviews;";
+const std::string SELECT_UNPUSHED_EMPLOYEES_SQL = "SELECT employee_id FROM employees WHERE synced_version = 0 AND "
+                                                  "employee_id IN (SELECT value FROM json_each(?));";
+const std::string SELECT_UNPUSHED_REVIEWS_SQL = "SELECT review_id FROM performance_reviews WHERE synced_version = 0 "
+                                                "AND review_id IN (SELECT value FROM json_each(?));";
+const std::string SELECT_REPORT_IDS_SQL = "SELECT employee_id FROM employees WHERE reports_to = ?;";
+const std::string SELECT_REVIEW_IDS_OF_EMPLOYEE_SQL =
+    "SELECT review_id FROM performance_reviews WHERE employee_id = ?1 OR reviewer_id = ?1;";
+const std::string RENUMBER_EMPLOYEE_SQL = "UPDATE employees SET employee_id = ? WHERE employee_id = ?;";
+const std::string RENUMBER_REPORTS_TO_SQL = "UPDATE employees SET reports_to = ? WHERE reports_to = ?;";
+const std::string RENUMBER_REVIEWED_EMPLOYEE_SQL =
+    "UPDATE performance_reviews SET employee_id = ? WHERE employee_id = ?;";
+const std::string RENUMBER_REVIEWER_SQL = "UPDATE performance_reviews SET reviewer_id = ? WHERE reviewer_id = ?;";
+const std::string RENUMBER_REVIEW_SQL = "UPDATE performance_reviews SET review_id = ? WHERE review_id = ?;";
+const std::string SELECT_HOT_REVIEWS_BY_ID_SQL = "SELECT " + std::string(REVIEW_COLUMNS) +
+                                                 " FROM performance_reviews WHERE review_id IN "
+                                                 "(SELECT value FROM json_each(?));";
+const std::string SELECT_WATERMARK_SQL = "SELECT value FROM sync_state WHERE name = ?;";
+const std::string UPSERT_WATERMARK_SQL =
+    "INSERT INTO sync_state (name, value) VALUES (?, ?) ON CONFLICT(name) DO UPDATE SET value = excluded.value;";
+
+// ---- review archive ----
+// archived years are attached as reviews_<year>; review_history is a temp view over the hot table and every
+// attached archive, which sqlite flattens into an index-ordered merge of the partitions
+constexpr std::string_view REVIEW_ARCHIVE_SCHEMA = "reviews_";
+// the schema a year is archived through while it is written, attached read-write
+const std::string ARCHIVE_TARGET_SQL = "ATTACH DATABASE ? AS archive_target;";
+const std::string DETACH_ARCHIVE_TARGET_SQL = "DETACH DATABASE archive_target;";
+// the hot table's columns without the foreign keys, which cannot reach across files, and without the CHECKs
+// every row already passed
+const std::string CREATE_ARCHIVE_TABLE_SQL =
+    "CREATE TABLE IF NOT EXISTS archive_target.performance_reviews (review_id INTEGER PRIMARY KEY, employee_id "
+    "INTEGER NOT NULL, reviewer_id INTEGER NOT NULL, review_date DATE NOT NULL, overall_rating REAL, comments TEXT, "
+    "punctuality_rating REAL, quality_of_work_rating REAL, teamwork_rating REAL, communication_rating REAL, "
+    "problem_solving_rating REAL, creativity_rating REAL, technical_skills_rating REAL, adaptability_rating REAL, "
+    "leadership_rating REAL, initiative_rating REAL, local_version INTEGER NOT NULL, synced_version INTEGER NOT NULL);";
+const std::string CREATE_ARCHIVE_INDEXES_SQL[] = {
+    "CREATE INDEX IF NOT EXISTS archive_target.idx_review_employee_date ON performance_reviews(employee_id, "
+    "review_date);",
+    "CREATE INDEX IF NOT EXISTS archive_target.idx_review_reviewer_date ON performance_reviews(reviewer_id, "
+    "review_date);",
+    "CREATE INDEX IF NOT EXISTS archive_target.idx_review_date ON performance_reviews(review_date);",
+};
+// rows of [?, ?) by review_date; OR REPLACE makes a rerun after an interrupted archiving converge
+const std::string COPY_TO_ARCHIVE_SQL = "INSERT OR REPLACE INTO archive_target.performance_reviews (" +
+                                        std::string(REVIEW_COLUMNS) + ", local_version, synced_version) SELECT " +
+                                        std::string(REVIEW_COLUMNS) +
+                                        ", local_version, synced_version FROM main.performance_reviews WHERE "
+                                        "review_date >= ? AND review_date < ?;";
+const std::string COUNT_ARCHIVE_SQL = "SELECT COUNT(*) FROM archive_target.performance_reviews;";
+const std::string VACUUM_ARCHIVE_SQL = "VACUUM archive_target;";
+const std::string VACUUM_HOT_SQL = "VACUUM main;";
+const std::string DELETE_ARCHIVED_SQL =
+    "DELETE FROM main.performance_reviews WHERE review_date >= ? AND review_date < ?;";
+const std::string REGISTER_ARCHIVE_SQL =
+    "INSERT INTO review_archives (year, path, review_count) VALUES (?, ?, ?) ON CONFLICT(year) DO UPDATE SET "
+    "path = excluded.path, review_count = excluded.review_count;";
+const std::string SELECT_ARCHIVES_SQL = "SELECT year, path, review_count FROM review_archives ORDER BY year;";
+const std::string SELECT_REVIEW_YEARS_SQL =
+    "SELECT DISTINCT CAST(substr(review_date, 1, 4) AS INTEGER) FROM main.performance_reviews WHERE review_date < ?;";
+
+const std::string BEGIN_SQL = "BEGIN TRANSACTION;";
+const std::string COMMIT_SQL = "COMMIT;";
+
+OperationMetrics& dbOperation(const char* name) {
+    return Metrics::instance().operation("db", name);
+}
+
+// a failed call; SQLITE_BUSY is also counted on its own since it points at lock contention, not bad input
+void recordFailure(OperationTimer& timer, const std::exception& e) {
+    timer.fail();
+    auto* sqliteError = dynamic_cast<const sqlite::sqlite_exception*>(&e);
+    if (sqliteError && sqliteError->get_code() == SQLITE_BUSY) {
+        Metrics::instance().dbBusyErrors.add();
+    }
+}
+
+// placeholders of a raw statement; text is bound without a copy and has to outlive the stepping
+void bindParameter(sqlite3_stmt* stmt, int index, int value) {
+    sqlite3_bind_int(stmt, index, value);
+}
+
+void bindParameter(sqlite3_stmt* stmt, int index, sqlite_int64 value) {
+    sqlite3_bind_int64(stmt, index, value);
+}
+
+void bindParameter(sqlite3_stmt* stmt, int index, const std::string& value) {
+    sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+}
+
+// params bound to the placeholders of stmt from the first on
+template <typename... Params>
+void bindParameters(sqlite3_stmt* stmt, const Params&... params) {
+    int index = 0;
+    (bindParameter(stmt, ++index, params), ...);
+}
+
+// Steps a raw statement to its end and hands every row to decode(stmt), which reads the columns in place
+// (readRow, or sqlite3_column_* for partial rows) rather than through a type-erased callback taking a
+// std::string per text value. The statement is reset afterwards so it does not hold on to its read lock;
+// a failing step throws sqlite::sqlite_exception like database_binder does.
+template <typename Decode>
+void stepRows(sqlite3_stmt* stmt, Decode&& decode) {
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        decode(stmt);
+    }
+    sqlite3_reset(stmt);
+    if (rc != SQLITE_DONE) {
+        sqlite::errors::throw_sqlite_error(rc, sqlite3_sql(stmt));
+    }
+}
+
+// the positive ids among ids as a JSON array for json_each, empty if there are none
+std::string idArray(const std::vector<int>& ids) {
+    std::string array;
+    for (int id : ids) {
+        if (id > 0) {
+            array += array.empty() ? '[' : ',';
+            array += std::to_string(id);
+        }
+    }
+    return array.empty() ? array : array + ']';
+}
+
+// rows of a multi-get spread back over the request: slot i holds the row whose keyOf(row) is ids[i], if any
+template <typename Row, typename KeyOf>
+std::vector<std::optional<Row>> inRequestOrder(const std::vector<int>& ids, std::vector<Row>& rows, KeyOf keyOf) {
+    std::unordered_map<int, Row*> byId;
+    byId.reserve(rows.size());
+    for (Row& row : rows) {
+        byId.emplace(keyOf(row), &row);
+    }
+    std::vector<std::optional<Row>> result(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto it = byId.find(ids[i]);
+        if (it != byId.end()) {
+            result[i] = *it->second;
+        }
+    }
+    return result;
+}
+
+// databases created before change tracking lack the version columns
+void addColumnIfMissing(sqlite::database& db, const std::string& table, const std::string& column,
+                        const std::string& definition) {
+    int found{0};
+    db << "SELECT COUNT(*) FROM pragma_table_info(?) WHERE name = ?;" << table << column >> found;
+    if (found == 0) {
+        db << "ALTER TABLE " + table + " ADD COLUMN " + column + " " + definition + ";";
+    }
+}
+
+// "YYYY-01-01", the first review_date of year
+std::string yearStart(int year) {
+    char date[32];
+    std::snprintf(date, sizeof(date), "%04d-01-01", year);
+    return date;
+}
+
+// the archive of one year, next to the database file
+std::string archivePath(const std::string& dbAddress, int year) {
+    return dbAddress + ".reviews-" + std::to_string(year) + ".db";
+}
+
+// path as a URI filename that opens it read-only
+std::string readOnlyUri(const std::string& path) {
+    std::string uri = "file:";
+    for (char c : path) {
+        switch (c) {
+        case '%':
+            uri += "%25";
+            break;
+        case '?':
+            uri += "%3f";
+            break;
+        case '#':
+            uri += "%23";
+            break;
+        default:
+            uri += c;
+        }
+    }
+    return uri + "?mode=ro";
+}
+
+// The connection setup of the review archive: detach the archives the connection had, attach the current ones
+// read-only and rebuild review_history over them. An archive that does not attach is left out and logged.
+void attachArchives(PooledConnection& connection, const std::vector<ReviewArchive>& archives) {
+    // cached statements can still be bound to the schemas about to go away
+    connection.statements.clear();
+    auto& db = connection.db;
+    std::string columns(REVIEW_COLUMNS);
+    std::string view = "CREATE TEMP VIEW review_history AS SELECT " + columns + " FROM main.performance_reviews";
+    try {
+        for (const auto& schema : connection.attached) {
+            db << "DETACH DATABASE " + schema + ";";
+        }
+        connection.attached.clear();
+        for (const auto& archive : archives) {
+            std::string schema = std::string(REVIEW_ARCHIVE_SCHEMA) + std::to_string(archive.year);
+            try {
+                db << "ATTACH DATABASE ? AS " + schema + ";" << readOnlyUri(archive.path);
+            } catch (const sqlite::sqlite_exception& e) {
+                std::cerr << "[attachArchives] : " << archive.path << ": " << e.what() << std::endl;
+                continue;
+            }
+            connection.attached.push_back(schema);
+            view += " UNION ALL SELECT " + columns + " FROM " + schema + ".performance_reviews";
+        }
+        db << "DROP VIEW IF EXISTS temp.review_history;";
+        db << view + ";";
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[attachArchives] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+    }
+}
+
+// Review list pages of a date range are routed to the hot table and the archives whose year overlaps
+// [fromDate, toDate); each arm seeks its own idx_review_date, numbered placeholders give them the same four
+// bindings and the compound ORDER BY merges the arms in index order instead of sorting.
+struct DateRangeRoute {
+    const std::string& fromDate;
+    const std::string& toDate;
+};
+
+std::string statementFor(const DateRangeRoute& route, const PooledConnection& connection) {
+    auto armFor = [](const std::string& schema) {
+        return "SELECT " + std::string(REVIEW_COLUMNS) + " FROM " + schema +
+               ".performance_reviews WHERE review_date < ?1 AND (review_date, review_id) > (?2, ?3)";
+    };
+    std::string sql = armFor("main");
+    for (const auto& schema : connection.attached) {
+        int year = std::stoi(schema.substr(REVIEW_ARCHIVE_SCHEMA.size()));
+        if (yearStart(year) < route.toDate && yearStart(year + 1) > route.fromDate) {
+            sql += " UNION ALL " + armFor(schema);
+        }
+    }
+    return sql + " ORDER BY review_date, review_id LIMIT ?4;";
+}
+
+const std::string& statementFor(const std::string& sql, const PooledConnection&) {
+    return sql;
+}
+
+// today's date in UTC as YYYY-MM-DD, the value sqlite's CURRENT_DATE would store
+std::string currentDate() {
+    // civil date of a day count since 1970-01-01 (days from civil, inverted)
+    auto days = std::chrono::duration_cast<std::chrono::hours>(std::chrono::system_clock::now().time_since_epoch())
+                    .count() / 24;
+    long long shifted = days + 719468;
+    long long era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+    long long dayOfEra = shifted - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long monthIndex = (5 * dayOfYear + 2) / 153;
+    long long day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    long long month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    long long year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    char date[32];
+    std::snprintf(date, sizeof(date), "%04lld-%02lld-%02lld", year, month, day);
+    return date;
+}
+
+// a row as the insert statements store it. An empty review date would become CURRENT_DATE inside sqlite, so it
+// is filled in before binding and the caches and rollups see the date that was written
+const Employee& asInserted(const Employee& employee) {
+    return employee;
+}
+
+PerformanceReview asInserted(const PerformanceReview& review) {
+    PerformanceReview stored = review;
+    if (stored.reviewDate.empty()) {
+        stored.reviewDate = currentDate();
+    }
+    return stored;
+}
+
+// sqlite numbered a review inserted without an id
+void readInsertedId(Employee&, sqlite3*) {
+}
+
+void readInsertedId(PerformanceReview& review, sqlite3* handle) {
+    if (review.reviewId <= 0) {
+        review.reviewId = static_cast<int>(sqlite3_last_insert_rowid(handle));
+    }
+}
+
+// ids whose rows a renumbering changed or left, reloaded once it committed
+struct Renumbered {
+    std::vector<int> employeeIds;
+    std::vector<int> reviewIds;
+};
+
+// move one row from -> to inside the open transaction; an employee takes its reports and reviews along
+void renumberEmployee(PooledConnection& connection, int from, int to, Renumbered& renumbered) {
+    auto collect = [&connection, from](const std::string& sql, std::vector<int>& ids) {
+        auto* stmt = connection.statements.acquireRaw(sql);
+        bindParameters(stmt, from);
+        stepRows(stmt, [&ids](sqlite3_stmt* row) { ids.push_back(sqlite3_column_int(row, 0)); });
+    };
+    collect(SELECT_REPORT_IDS_SQL, renumbered.employeeIds);
+    collect(SELECT_REVIEW_IDS_OF_EMPLOYEE_SQL, renumbered.reviewIds);
+    for (const auto* sql : {&RENUMBER_EMPLOYEE_SQL, &RENUMBER_REPORTS_TO_SQL, &RENUMBER_REVIEWED_EMPLOYEE_SQL,
+                            &RENUMBER_REVIEWER_SQL}) {
+        auto& stmt = connection.statements.acquire(*sql);
+        stmt << to << from;
+        stmt.execute();
+    }
+    renumbered.employeeIds.insert(renumbered.employeeIds.end(), {from, to});
+}
+
+void renumberReview(PooledConnection& connection, int from, int to, Renumbered& renumbered) {
+    auto& stmt = connection.statements.acquire(RENUMBER_REVIEW_SQL);
+    stmt << to << from;
+    stmt.execute();
+    renumbered.reviewIds.insert(renumbered.reviewIds.end(), {from, to});
+}
+
+// the statements renumbering one table
+struct IdTable {
+    const std::string& selectMaxId;
+    const std::string& selectUnpushed;
+    const std::string& markSynced;
+    void (*renumber)(PooledConnection&, int, int, Renumbered&);
+};
+const IdTable EMPLOYEE_IDS{SELECT_MAX_EMPLOYEE_ID_SQL, SELECT_UNPUSHED_EMPLOYEES_SQL, MARK_EMPLOYEE_SYNCED_SQL,
+                           renumberEmployee};
+const IdTable REVIEW_IDS{SELECT_MAX_REVIEW_ID_SQL, SELECT_UNPUSHED_REVIEWS_SQL, MARK_REVIEW_SYNCED_SQL, renumberReview};
+
+// move the never pushed rows sitting on any of ids to fresh ids above every existing row and above ids
+void vacateIds(PooledConnection& connection, const IdTable& table, const std::vector<int>& ids,
+               Renumbered& renumbered) {
+    std::string array = idArray(ids);
+    if (array.empty()) {
+        return;
+    }
+    std::vector<int> occupied;
+    auto* stmt = connection.statements.acquireRaw(table.selectUnpushed);
+    bindParameters(stmt, array);
+    stepRows(stmt, [&occupied](sqlite3_stmt* row) { occupied.push_back(sqlite3_column_int(row, 0)); });
+    if (occupied.empty()) {
+        return;
+    }
+    int next = *std::max_element(ids.begin(), ids.end());
+    stepRows(connection.statements.acquireRaw(table.selectMaxId),
+             [&next](sqlite3_stmt* row) { next = std::max(next, sqlite3_column_int(row, 0)); });
+    for (int id : occupied) {
+        table.renumber(connection, id, ++next, renumbered);
+    }
+}
+
+// give the posted rows their server ids and record the pushed versions, inside the open transaction
+void adoptIds(PooledConnection& connection, const IdTable& table, const std::vector<AssignedId>& assigned,
+              Renumbered& renumbered) {
+    // parked on negative ids first, so two posted rows can trade places
+    std::vector<int> serverIds;
+    for (std::size_t i = 0; i < assigned.size(); ++i) {
+        if (assigned[i].localId != assigned[i].serverId) {
+            table.renumber(connection, assigned[i].localId, -static_cast<int>(i + 1), renumbered);
+        }
+        serverIds.push_back(assigned[i].serverId);
+    }
+    // another row created offline can hold a server id; a pushed row holding one fails the renumbering below
+    vacateIds(connection, table, serverIds, renumbered);
+    for (std::size_t i = 0; i < assigned.size(); ++i) {
+        if (assigned[i].localId != assigned[i].serverId) {
+            table.renumber(connection, -static_cast<int>(i + 1), assigned[i].serverId, renumbered);
+        }
+        auto& mark = connection.statements.acquire(table.markSynced);
+        mark << static_cast<sqlite_int64>(assigned[i].version) << assigned[i].serverId;
+        mark.execute();
+    }
+}
+} // namespace
+
+DatabaseManager::DatabaseManager(const std::string& dbAddress) : DatabaseManager(dbAddress, PoolConfig{}) {
+}
+
+DatabaseManager::DatabaseManager(const std::string& dbAddress, const PoolConfig& poolConfig) :
+    pool(dbAddress, poolConfig), dbAddress(dbAddress) {
     // additional initializations
     this->InitializeDatabase();
+    // review_history has to exist on every connection, with or without archives
+    loadReviewArchives();
+    // read-only connections can only be opened once the schema exists
+    pool.openReaders();
 }
 
 bool DatabaseManager::InitializeDatabase() {
     try {
+        auto connection = pool.acquireWriter();
+        auto& db = connection->db;
         db << "CREATE TABLE IF NOT EXISTS employees ("
               "employee_id INTEGER PRIMARY KEY AUTOINCREMENT,"
               "name TEXT NOT NULL,"
@@ -19,6 +556,8 @@ bool DatabaseManager::InitializeDatabase() {
               "hire_date TEXT,"
               "personnel_code INT,"
               "is_active INT DEFAULT 1,"
+              "local_version INTEGER NOT NULL DEFAULT 1,"
+              "synced_version INTEGER NOT NULL DEFAULT 0,"
               "FOREIGN KEY (reports_to) REFERENCES employees(employee_id)"
               ");";
 
@@ -44,6 +583,8 @@ bool DatabaseManager::InitializeDatabase() {
               "adaptability_rating REAL CHECK(adaptability_rating BETWEEN 1 AND 10),"
               "leadership_rating REAL CHECK(leadership_rating BETWEEN 1 AND 10),"
               "initiative_rating REAL CHECK(initiative_rating BETWEEN 1 AND 10),"
+              "local_version INTEGER NOT NULL DEFAULT 1,"
+              "synced_version INTEGER NOT NULL DEFAULT 0,"
 
               "FOREIGN KEY (employee_id) REFERENCES employees(employee_id),"
               "FOREIGN KEY (reviewer_id) REFERENCES employees(employee_id)"
@@ -51,12 +592,53 @@ bool DatabaseManager::InitializeDatabase() {
 
         db << "CREATE INDEX IF NOT EXISTS idx_employee_name ON employees(name);";
         db << "CREATE INDEX IF NOT EXISTS idx_employee_role ON employees(role);";
-        db << "CREATE INDEX IF NOT EXISTS idx_review_employee_id ON "
-              "performance_reviews(employee_id);";
-        db << "CREATE INDEX IF NOT EXISTS idx_review_reviewer_id ON "
-              "performance_reviews(reviewer_id);";
+        db << "CREATE INDEX IF NOT EXISTS idx_employee_reports_to ON employees(reports_to);";
+        // review_id is the rowid, which every index entry ends with, so these are ordered by
+        // (employee_id | reviewer_id | -, review_date, review_id): exactly the keyset of the review list pages
+        db << "CREATE INDEX IF NOT EXISTS idx_review_employee_date ON "
+              "performance_reviews(employee_id, review_date);";
+        db << "CREATE INDEX IF NOT EXISTS idx_review_reviewer_date ON "
+              "performance_reviews(reviewer_id, review_date);";
         db << "CREATE INDEX IF NOT EXISTS idx_review_date ON "
               "performance_reviews(review_date);";
+        // prefixes of the composite indexes above, left over by older databases
+        db << "DROP INDEX IF EXISTS idx_review_employee_id;";
+        db << "DROP INDEX IF EXISTS idx_review_reviewer_id;";
+
+        // ---- change tracking for the sync engine ----
+        // a row is dirty while local_version > synced_version; rows that existed before tracking start out dirty
+        addColumnIfMissing(db, "employees", "local_version", "INTEGER NOT NULL DEFAULT 1");
+        addColumnIfMissing(db, "employees", "synced_version", "INTEGER NOT NULL DEFAULT 0");
+        addColumnIfMissing(db, "performance_reviews", "local_version", "INTEGER NOT NULL DEFAULT 1");
+        addColumnIfMissing(db, "performance_reviews", "synced_version", "INTEGER NOT NULL DEFAULT 0");
+        db << "CREATE TABLE IF NOT EXISTS sync_state ("
+              "name TEXT PRIMARY KEY,"
+              "value INTEGER NOT NULL"
+              ");";
+        // local edits bump the version; updates that also move synced_version come from the sync engine itself
+        db << "CREATE TRIGGER IF NOT EXISTS trg_employee_local_edit AFTER UPDATE OF name, role, reports_to, "
+              "hire_date, personnel_code, is_active ON employees WHEN NEW.synced_version = OLD.synced_version "
+              "BEGIN UPDATE employees SET local_version = OLD.local_version + 1 WHERE employee_id = NEW.employee_id; "
+              "END;";
+        db << "CREATE TRIGGER IF NOT EXISTS trg_review_local_edit AFTER UPDATE OF employee_id, reviewer_id, "
+              "review_date, overall_rating, comments, punctuality_rating, quality_of_work_rating, teamwork_rating, "
+              "communication_rating, problem_solving_rating, creativity_rating, technical_skills_rating, "
+              "adaptability_rating, leadership_rating, initiative_rating ON performance_reviews "
+              "WHEN NEW.synced_version = OLD.synced_version "
+              "BEGIN UPDATE performance_reviews SET local_version = OLD.local_version + 1 "
+              "WHERE review_id = NEW.review_id; END;";
+        // partial indexes keep the dirty scans proportional to the number of unpushed rows
+        db << "CREATE INDEX IF NOT EXISTS idx_employee_dirty ON employees(employee_id) "
+              "WHERE local_version > synced_version;";
+        db << "CREATE INDEX IF NOT EXISTS idx_review_dirty ON performance_reviews(review_id) "
+              "WHERE local_version > synced_version;";
+
+        // ---- review archive ----
+        db << "CREATE TABLE IF NOT EXISTS review_archives ("
+              "year INTEGER PRIMARY KEY,"
+              "path TEXT NOT NULL,"
+              "review_count INTEGER NOT NULL"
+              ");";
         return true;
     } catch (const sqlite::sqlite_exception& e) {
         std::cerr << "[IitializeDatabase] : " << "Database initialization error: " << e.what()
@@ -66,40 +648,67 @@ bool DatabaseManager::InitializeDatabase() {
 }
 
 bool DatabaseManager::addEmployee(const Employee& employee) {
+    static auto& metrics = dbOperation("addEmployee");
+    OperationTimer timer(metrics);
     if (employee.employeeId <= 0) {
         std::cerr << "[addEmployee] : " << "Invalid employee Id " << std::endl;
+        timer.fail();
         return false;
     }
     try {
-        auto stmt =
-            db << "INSERT INTO employees (employee_id, name, role, reports_to, hire_date, personnel_code, is_active) "
-                  "VALUES (?, ?, ?, ?, ?, ?, ?);";
-        stmt << employee.employeeId << employee.name << roleToString(employee.role);
-        stmt << employee.reportsTo.value_or(SQLITE_NULL);
-        stmt << employee.hireDate << employee.personnelCode << static_cast<int>(employee.isActive);
+        auto connection = pool.acquireWriter();
+        auto& stmt = connection->statements.acquire(INSERT_EMPLOYEE_SQL);
+        bindRow(stmt, employee);
         stmt.execute();
+        Metrics::instance().dbRowsWritten.add();
+        if (orgChartEnabled) {
+            orgChart.upsert(employee.employeeId, employee.reportsTo, employee.isActive);
+        }
+        if (searchEnabled) {
+            employeeNames.upsert(employee.employeeId, employee.name);
+        }
+        publishChange(ChangeKind::EMPLOYEE_INSERTED, employee.employeeId);
         return true;
     } catch (const std::exception& e) {
         std::cerr << "[addEmployee] : " << e.what() << '\n';
+        recordFailure(timer, e);
         return false;
     }
 }
 
 std::optional<Employee> DatabaseManager::getEmployee(int emplyeeId) {
+    static auto& metrics = dbOperation("getEmployee");
+    OperationTimer timer(metrics);
     if (emplyeeId <= 0) {
         std::cerr << "[getEmployee] : " << "Invalid employee id" << std::endl;
+        timer.fail();
         return std::nullopt;
     }
 
+    std::uint64_t cacheVersion{0};
+    if (employeeCache) {
+        if (auto cached = employeeCache->get(emplyeeId)) {
+            return cached;
+        }
+        cacheVersion = employeeCache->version(emplyeeId);
+    }
+
     Employee employeeResult;
     bool isFound{false};
 
     try {
-        db << "SELECT employee_id, name, reports_to, role, hire_date, personnel_code, "
-              "is_active FROM employees WHERE employee_id = ?;"
-           << emplyeeId >>
-            getSingleEmployeeCollector(employeeResult, isFound);
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_EMPLOYEE_SQL);
+        bindParameters(stmt, emplyeeId);
+        stepRows(stmt, [&](sqlite3_stmt* row) {
+            readRow(row, employeeResult);
+            isFound = true;
+        });
         if (isFound) {
+            Metrics::instance().dbRowsRead.add();
+            if (employeeCache) {
+                employeeCache->put(emplyeeId, employeeResult, cacheVersion);
+            }
             return employeeResult;
         } else {
             return std::nullopt;
@@ -107,116 +716,256 @@ std::optional<Employee> DatabaseManager::getEmployee(int emplyeeId) {
 
     } catch (const std::exception& e) {
         std::cerr << "[getEmployee] : " << "Error in geting employee" << e.what() << '\n';
+        recordFailure(timer, e);
         return std::nullopt;
     }
 }
 
 std::optional<std::vector<Employee>> DatabaseManager::getAllEmployees() {
+    static auto& metrics = dbOperation("getAllEmployees");
+    OperationTimer timer(metrics);
     std::vector<Employee> employees;
-    bool isFound{false};
-
-    auto collector = getMultipleEmployeeCollector(employees, isFound);
     try {
-        db << "SELECT * FROM employees;" >> collector;
+        auto connection = pool.acquireReader();
+        stepRows(connection->statements.acquireRaw(SELECT_ALL_EMPLOYEES_SQL),
+                 [&employees](sqlite3_stmt* row) { readRow(row, employees.emplace_back()); });
+        Metrics::instance().dbRowsRead.add(employees.size());
         return employees;
     } catch (const std::exception& e) {
         std::cerr << "[getAllEmployees] : " << e.what() << '\n';
+        recordFailure(timer, e);
         return std::nullopt;
     }
 }
 
+EmployeeCursor DatabaseManager::streamAllEmployees() {
+    return EmployeeCursor(pool.acquireReader(), STREAM_EMPLOYEES_SQL);
+}
+
+bool DatabaseManager::scanAllEmployees(EmployeeArena& arena) {
+    static auto& metrics = dbOperation("scanAllEmployees");
+    OperationTimer timer(metrics);
+    arena.clear();
+    try {
+        auto connection = pool.acquireReader();
+        int employeeCount{0};
+        connection->statements.acquire(COUNT_EMPLOYEES_SQL) >> employeeCount;
+        arena.reserve(static_cast<std::size_t>(employeeCount));
+        // columns: employee_id, name, role, reports_to, hire_date, personnel_code, is_active
+        stepRows(connection->statements.acquireRaw(STREAM_EMPLOYEES_SQL), [&arena](sqlite3_stmt* stmt) {
+            EmployeeRow& row = arena.append();
+            row.employeeId = sqlite3_column_int(stmt, 0);
+            row.name = arena.store(mapping::columnText(stmt, 1));
+            row.role = stringToRole(mapping::columnText(stmt, 2)).value_or(Role::SPECIALIST);
+            if (sqlite3_column_type(stmt, 3) != SQLITE_NULL) {
+                row.reportsTo = sqlite3_column_int(stmt, 3);
+            }
+            row.hireDay = toDayNumber(mapping::columnText(stmt, 4)).value_or(NO_DAY);
+            row.personnelCode = sqlite3_column_int(stmt, 5);
+            row.isActive = sqlite3_column_int(stmt, 6) != 0;
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "[scanAllEmployees] : " << e.what() << '\n';
+        recordFailure(timer, e);
+        arena.clear();
+        return false;
+    }
+    Metrics::instance().dbRowsRead.add(arena.size());
+    return true;
+}
+
+std::optional<std::vector<std::optional<Employee>>> DatabaseManager::getEmployees(const std::vector<int>& employeeIds) {
+    static auto& metrics = dbOperation("getEmployees");
+    OperationTimer timer(metrics);
+
+    // the read cache answers what it can, only the rest goes to sqlite
+    std::vector<Employee> employees;
+    std::vector<int> missing;
+    std::unordered_map<int, std::uint64_t> cacheVersions;
+    for (int id : employeeIds) {
+        if (employeeCache && id > 0) {
+            if (auto cached = employeeCache->get(id)) {
+                employees.push_back(std::move(*cached));
+                continue;
+            }
+            cacheVersions.emplace(id, employeeCache->version(id));
+        }
+        missing.push_back(id);
+    }
+    std::string ids = idArray(missing);
+    if (ids.empty()) {
+        return inRequestOrder(employeeIds, employees, [](const Employee& employee) { return employee.employeeId; });
+    }
+
+    try {
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_EMPLOYEES_BY_ID_SQL);
+        bindParameters(stmt, ids);
+        std::size_t cached = employees.size();
+        stepRows(stmt, [&employees](sqlite3_stmt* row) { readRow(row, employees.emplace_back()); });
+        Metrics::instance().dbRowsRead.add(employees.size() - cached);
+        if (employeeCache) {
+            for (std::size_t i = cached; i < employees.size(); ++i) {
+                employeeCache->put(employees[i].employeeId, employees[i], cacheVersions[employees[i].employeeId]);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[getEmployees] : " << e.what() << '\n';
+        recordFailure(timer, e);
+        return std::nullopt;
+    }
+    return inRequestOrder(employeeIds, employees, [](const Employee& employee) { return employee.employeeId; });
+}
+
 std::optional<std::vector<Employee>> DatabaseManager::getEmployeesReportingToHead(const int reviewerId) {
+    static auto& metrics = dbOperation("getEmployeesReportingToHead");
+    OperationTimer timer(metrics);
     if (reviewerId <= 0) {
         std::cerr << "Invalid reviewer id" << std::endl;
+        timer.fail();
         return std::nullopt;
     }
 
     std::vector<Employee> employees;
-    bool isFound{false};
-
-    auto collector = getMultipleEmployeeCollector(employees, isFound);
     try {
-        db << "SELECT * FROM employees WHERE reports_to = ?;" << reviewerId >> collector;
-        if (isFound) {
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_REPORTS_SQL);
+        bindParameters(stmt, reviewerId);
+        stepRows(stmt, [&employees](sqlite3_stmt* row) { readRow(row, employees.emplace_back()); });
+        Metrics::instance().dbRowsRead.add(employees.size());
+        if (!employees.empty()) {
             return employees;
         } else {
             return std::nullopt;
         }
     } catch (const std::exception& e) {
         std::cerr << "[getEmployeeReportingToHead] : " << e.what() << '\n';
+        recordFailure(timer, e);
         return std::nullopt;
     }
 }
 
 bool DatabaseManager::updateEmployee(const Employee& employee) {
+    static auto& metrics = dbOperation("updateEmployee");
+    OperationTimer timer(metrics);
     if (employee.employeeId <= 0) {
         std::cerr << "[updateEmployee] : " << "Invalid employee Id " << std::endl;
+        timer.fail();
         return false;
     }
     try {
-        db << "UPDATE employees SET name = ?, role = ?, reports_to = ?, hire_date = ?, personnel_code = ?, is_active = "
-              "? "
-              "WHERE "
-              "employee_id = ?;"
-           << employee.name << roleToString(employee.role) << employee.reportsTo << employee.hireDate
-           << employee.personnelCode << employee.isActive << employee.employeeId;
+        auto connection = pool.acquireWriter();
+        auto& stmt = connection->statements.acquire(UPDATE_EMPLOYEE_SQL);
+        bindUpdate(stmt, employee);
+        stmt.execute();
+        int changes = sqlite3_changes(connection->db.connection().get());
+        Metrics::instance().dbRowsWritten.add(static_cast<std::uint64_t>(changes));
+        if (employeeCache) {
+            employeeCache->erase(employee.employeeId);
+        }
+        if (orgChartEnabled && changes > 0) {
+            orgChart.upsert(employee.employeeId, employee.reportsTo, employee.isActive);
+        }
+        if (searchEnabled && changes > 0) {
+            employeeNames.upsert(employee.employeeId, employee.name);
+        }
+        if (changes > 0) {
+            publishChange(ChangeKind::EMPLOYEE_UPDATED, employee.employeeId);
+        }
     } catch (const sqlite::sqlite_exception& e) {
         std::cerr << "[updateEmployee] : " << "employee update error: " << e.what() << " (code: " << e.get_code() << ")"
                   << std::endl;
+        recordFailure(timer, e);
+        return false;
     }
     return true;
 }
 
 bool DatabaseManager::deactivateEmployee(int employeeId) {
+    static auto& metrics = dbOperation("deactivateEmployee");
+    OperationTimer timer(metrics);
     if (employeeId <= 0) {
         std::cerr << "[deactivateEmployee] : " << "Invalid employee ID!" << std::endl;
+        timer.fail();
         return false;
     }
     try {
-        auto stmt = db << "UPDATE employees SET is_active = ? WHERE employee_id = ?;";
+        auto connection = pool.acquireWriter();
+        auto& stmt = connection->statements.acquire(DEACTIVATE_EMPLOYEE_SQL);
         stmt << 0 << employeeId;
         stmt.execute();
+        int changes = sqlite3_changes(connection->db.connection().get());
+        Metrics::instance().dbRowsWritten.add(static_cast<std::uint64_t>(changes));
+        if (employeeCache) {
+            employeeCache->erase(employeeId);
+        }
+        if (orgChartEnabled) {
+            orgChart.setActive(employeeId, false);
+        }
+        if (changes > 0) {
+            publishChange(ChangeKind::EMPLOYEE_DEACTIVATED, employeeId);
+        }
         return true;
     } catch (const std::exception& e) {
         std::cerr << "[deactivateEmployee] : " << e.what() << '\n';
+        recordFailure(timer, e);
     }
     return false;
 }
 
 bool DatabaseManager::addPerformanceReview(const PerformanceReview& review) {
+    static auto& metrics = dbOperation("addPerformanceReview");
+    OperationTimer timer(metrics);
     try {
-        auto stmt =
-            db << "INSERT INTO performance_reviews (review_id, employee_id, reviewer_id, overall_rating, comments,"
-                  "punctuality_rating, quality_of_work_rating, teamwork_rating, "
-                  "communication_rating, problem_solving_rating, creativity_rating, technical_skills_rating, "
-                  "adaptability_rating, leadership_rating, initiative_rating) VALUES (?, ?, ?, ?, ?, ?, "
-                  "?, ?, ?, ? ,? ,?, ?, ?, ?);";
-        stmt << review.reviewId << review.employeeId << review.reviewerId << review.overallRating.value_or(SQLITE_NULL)
-             << review.comments.value_or(nullptr) << review.punctualityRating << review.qualityOfWorkRating
-             << review.teamworkRating << review.communicationRating << review.problemSolvingRating
-             << review.creativityRating << review.technicalSkillsRating << review.adaptabilityRating
-             << review.leadershipRating << review.initiativeRating;
+        auto connection = pool.acquireWriter();
+        auto& stmt = connection->statements.acquire(INSERT_REVIEW_SQL);
+        PerformanceReview stored = asInserted(review);
+        bindRow(stmt, stored);
         stmt.execute();
+        Metrics::instance().dbRowsWritten.add();
+        readInsertedId(stored, connection->db.connection().get());
+        reviewWritten(stored, ChangeKind::REVIEW_ADDED);
         return true;
     } catch (const sqlite::sqlite_exception& e) {
         std::cerr << "[addPerformanceReview] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        recordFailure(timer, e);
         return false;
     }
 }
 
 std::optional<PerformanceReview> DatabaseManager::getPerformanceReview(const int& reviewId) {
+    static auto& metrics = dbOperation("getPerformanceReview");
+    OperationTimer timer(metrics);
     if (reviewId <= 0) {
         std::cerr << "[getPerformanceReview] : " << "Invalid review id" << std::endl;
+        timer.fail();
         return std::nullopt;
     }
 
+    std::uint64_t cacheVersion{0};
+    if (reviewCache) {
+        if (auto cached = reviewCache->get(reviewId)) {
+            return cached;
+        }
+        cacheVersion = reviewCache->version(reviewId);
+    }
+
     PerformanceReview review;
     bool isFound{false};
 
-    auto collector = getPerformanceReviewCollector(review, isFound);
     try {
-        db << "SELECT * FROM performance_reviews WHERE review_id = (?);" << reviewId >> collector;
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_REVIEW_SQL);
+        bindParameters(stmt, reviewId);
+        stepRows(stmt, [&](sqlite3_stmt* row) {
+            readRow(row, review);
+            isFound = true;
+        });
         if (isFound) {
+            Metrics::instance().dbRowsRead.add();
+            if (reviewCache) {
+                reviewCache->put(reviewId, review, cacheVersion);
+            }
             return review;
         } else {
             return std::nullopt;
@@ -224,17 +973,26 @@ std::optional<PerformanceReview> DatabaseManager::getPerformanceReview(const int
 
     } catch (const std::exception& e) {
         std::cerr << "[getPerformanceReview] : " << e.what() << '\n';
+        recordFailure(timer, e);
         return std::nullopt;
     }
 }
 
 std::optional<PerformanceReview> DatabaseManager::getPerformanceForEmployee(const int& employeeId) {
+    static auto& metrics = dbOperation("getPerformanceForEmployee");
+    OperationTimer timer(metrics);
     PerformanceReview review;
     bool isFound{false};
-    auto collector = getPerformanceReviewCollector(review, isFound);
     try {
-        db << "SELECT * FROM performance_reviews WHERE employee_id = (?);" << employeeId >> collector;
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_EMPLOYEE_REVIEW_SQL);
+        bindParameters(stmt, employeeId);
+        stepRows(stmt, [&](sqlite3_stmt* row) {
+            readRow(row, review);
+            isFound = true;
+        });
         if (isFound) {
+            Metrics::instance().dbRowsRead.add();
             return review;
         } else {
             return std::nullopt;
@@ -242,79 +1000,1100 @@ std::optional<PerformanceReview> DatabaseManager::getPerformanceForEmployee(cons
 
     } catch (const std::exception& e) {
         std::cerr << "[getPerformanceForEmployee] : " << e.what() << '\n';
+        recordFailure(timer, e);
         return std::nullopt;
     }
 }
 
 std::optional<std::vector<PerformanceReview>> DatabaseManager::getReviewByReviewer(int reviewerId) {
-    return std::optional<std::vector<PerformanceReview>>();
+    std::vector<PerformanceReview> reviews;
+    std::optional<ReviewCursor> after;
+    do {
+        auto page = getReviewsByReviewer(reviewerId, after, MAX_REVIEW_PAGE_SIZE);
+        if (!page) {
+            return std::nullopt;
+        }
+        reviews.insert(reviews.end(), std::make_move_iterator(page->reviews.begin()),
+                       std::make_move_iterator(page->reviews.end()));
+        after = std::move(page->next);
+    } while (after);
+    return reviews;
 }
 
-bool DatabaseManager::updatePerformanceReview(int reviewId) {
-    return false;
+std::optional<ReviewPage> DatabaseManager::getReviewsForEmployee(int employeeId,
+                                                                 const std::optional<ReviewCursor>& after,
+                                                                 std::size_t pageSize) {
+    static auto& metrics = dbOperation("getReviewsForEmployee");
+    OperationTimer timer(metrics);
+    if (employeeId <= 0) {
+        std::cerr << "[getReviewsForEmployee] : " << "Invalid employee id" << std::endl;
+        timer.fail();
+        return std::nullopt;
+    }
+    auto page = getReviewPage(
+        "getReviewsForEmployee", SELECT_EMPLOYEE_REVIEW_PAGE_SQL,
+        employeeId, after.value_or(ReviewCursor{}),
+        pageSize);
+    if (!page) {
+        timer.fail();
+    }
+    return page;
+}
+
+std::optional<ReviewPage> DatabaseManager::getReviewsByReviewer(int reviewerId,
+                                                                const std::optional<ReviewCursor>& after,
+                                                                std::size_t pageSize) {
+    static auto& metrics = dbOperation("getReviewsByReviewer");
+    OperationTimer timer(metrics);
+    if (reviewerId <= 0) {
+        std::cerr << "[getReviewsByReviewer] : " << "Invalid reviewer id" << std::endl;
+        timer.fail();
+        return std::nullopt;
+    }
+    auto page = getReviewPage(
+        "getReviewsByReviewer", SELECT_REVIEWER_REVIEW_PAGE_SQL,
+        reviewerId, after.value_or(ReviewCursor{}),
+        pageSize);
+    if (!page) {
+        timer.fail();
+    }
+    return page;
+}
+
+std::optional<ReviewPage> DatabaseManager::getReviewsInDateRange(const std::string& fromDate,
+                                                                 const std::string& toDate,
+                                                                 const std::optional<ReviewCursor>& after,
+                                                                 std::size_t pageSize) {
+    static auto& metrics = dbOperation("getReviewsInDateRange");
+    OperationTimer timer(metrics);
+    // the lower bound is the first keyset position: a separate review_date >= ? would be picked for the index
+    // seek and make every page rescan the range from its start
+    ReviewCursor start{fromDate, 0};
+    if (after && after->reviewDate >= fromDate) {
+        start = *after;
+    }
+    auto page = getReviewPage(
+        "getReviewsInDateRange", DateRangeRoute{start.reviewDate, toDate},
+        toDate, start, pageSize);
+    if (!page) {
+        timer.fail();
+    }
+    return page;
+}
+
+template <typename Query, typename Filter>
+std::optional<ReviewPage> DatabaseManager::getReviewPage(const char* tag, const Query& query, const Filter& filter,
+                                                         const ReviewCursor& after, std::size_t pageSize) {
+    if (pageSize == 0) {
+        pageSize = DEFAULT_REVIEW_PAGE_SIZE;
+    }
+    pageSize = std::min(pageSize, MAX_REVIEW_PAGE_SIZE);
+    ReviewPage page;
+    page.reviews.reserve(pageSize);
+    bool hasMore{false};
+    try {
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(statementFor(query, *connection));
+        bindParameters(stmt, filter, after.reviewDate, after.reviewId, static_cast<sqlite_int64>(pageSize + 1));
+        // rows are decoded straight into the page, the extra row only sets hasMore
+        stepRows(stmt, [&](sqlite3_stmt* row) {
+            if (page.reviews.size() == pageSize) {
+                hasMore = true;
+                return;
+            }
+            readRow(row, page.reviews.emplace_back());
+        });
+        Metrics::instance().dbRowsRead.add(page.reviews.size());
+        if (hasMore) {
+            page.next = ReviewCursor{page.reviews.back().reviewDate, page.reviews.back().reviewId};
+        }
+        return page;
+    } catch (const std::exception& e) {
+        std::cerr << "[" << tag << "] : " << e.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+bool DatabaseManager::updatePerformanceReview(const PerformanceReview& review) {
+    static auto& metrics = dbOperation("updatePerformanceReview");
+    OperationTimer timer(metrics);
+    if (review.reviewId <= 0) {
+        std::cerr << "[updatePerformanceReview] : " << "Invalid review id" << std::endl;
+        timer.fail();
+        return false;
+    }
+    try {
+        auto connection = pool.acquireWriter();
+        auto& stmt = connection->statements.acquire(UPDATE_REVIEW_SQL);
+        bindUpdate(stmt, review);
+        stmt.execute();
+        int changes = sqlite3_changes(connection->db.connection().get());
+        Metrics::instance().dbRowsWritten.add(static_cast<std::uint64_t>(changes));
+        if (changes > 0) {
+            reviewWritten(review, ChangeKind::REVIEW_UPDATED);
+        }
+        return changes > 0;
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[updatePerformanceReview] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        recordFailure(timer, e);
+        return false;
+    }
 }
 
 bool DatabaseManager::deletePerformanceReview(int reviewId) {
-    return false;
+    static auto& metrics = dbOperation("deletePerformanceReview");
+    OperationTimer timer(metrics);
+    if (reviewId <= 0) {
+        std::cerr << "[deletePerformanceReview] : " << "Invalid review id" << std::endl;
+        timer.fail();
+        return false;
+    }
+    try {
+        auto connection = pool.acquireWriter();
+        auto& stmt = connection->statements.acquire(DELETE_REVIEW_SQL);
+        stmt << reviewId;
+        stmt.execute();
+        int changes = sqlite3_changes(connection->db.connection().get());
+        Metrics::instance().dbRowsWritten.add(static_cast<std::uint64_t>(changes));
+        if (changes > 0) {
+            reviewDeleted(reviewId);
+        }
+        return changes > 0;
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[deletePerformanceReview] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        recordFailure(timer, e);
+        return false;
+    }
 }
 
-std::function<void(int, std::string, std::string, int, std::string, int, bool)>
-DatabaseManager::getMultipleEmployeeCollector(std::vector<Employee>& employees, bool& isFound) const {
-    return [&](int EmployeeId, std::string Name, std::string role, std::optional<int> reportsTo, std::string hireDate,
-               int personnelCode, bool isActive) {
-        Employee employee;
-        employee.employeeId = EmployeeId;
-        employee.name = Name;
-        employee.role = PerfMgmt::stringToRole(role).value();
-        employee.reportsTo = reportsTo;
-        employee.hireDate = hireDate;
-        employee.isActive = isActive;
-        employee.personnelCode = personnelCode;
-        employees.push_back(employee);
-        isFound = true;
-    };
+BulkImportResult DatabaseManager::addEmployees(const std::vector<Employee>& employees, std::size_t batchSize) {
+    auto result = bulkInsert(
+        "addEmployees", INSERT_EMPLOYEE_SQL, employees, batchSize,
+        [](const Employee& employee) -> const char* {
+            return employee.employeeId <= 0 ? "Invalid employee Id" : nullptr;
+        },
+        [this](const Employee& employee) { employeeWritten(employee, ChangeKind::EMPLOYEE_INSERTED); });
+    return result;
+}
+
+bool DatabaseManager::enableOrgChartIndex() {
+    orgChartEnabled = rebuildOrgChart();
+    return orgChartEnabled;
+}
+
+const OrgChartIndex& DatabaseManager::orgChartIndex() const {
+    return orgChart;
+}
+
+bool DatabaseManager::enableSearchIndex() {
+    searchEnabled = rebuildEmployeeNameIndex() && rebuildReviewCommentIndex();
+    return searchEnabled;
+}
+
+const SearchIndex& DatabaseManager::employeeNameIndex() const {
+    return employeeNames;
+}
+
+const SearchIndex& DatabaseManager::reviewCommentIndex() const {
+    return reviewComments;
+}
+
+bool DatabaseManager::rebuildEmployeeNameIndex() {
+    // holding the writer keeps mutators out until the index matches the table; the scan then reads on the
+    // writer too, so this never waits for a reader while holding it
+    auto writer = pool.acquireWriter();
+    employeeNames.clear();
+    return forEachEmployee([this](const Employee& employee) {
+        employeeNames.upsert(employee.employeeId, employee.name);
+    });
+}
+
+bool DatabaseManager::rebuildReviewCommentIndex() {
+    auto connection = pool.acquireWriter();
+    reviewComments.clear();
+    try {
+        PerformanceReview review;
+        stepRows(connection->statements.acquireRaw(SELECT_REVIEW_COMMENTS_SQL), [&](sqlite3_stmt* row) {
+            readRow(row, review);
+            reviewComments.upsert(review.reviewId, *review.comments);
+        });
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "[rebuildReviewCommentIndex] : " << e.what() << '\n';
+        return false;
+    }
+}
+
+bool DatabaseManager::enableTeamAnalytics() {
+    if (!orgChartEnabled && !enableOrgChartIndex()) {
+        return false;
+    }
+    teamAnalyticsEnabled = rebuildTeamAnalytics();
+    return teamAnalyticsEnabled;
+}
+
+const TeamAnalytics& DatabaseManager::teamAnalytics() const {
+    return teamRollups;
+}
+
+bool DatabaseManager::rebuildTeamAnalytics() {
+    // holding the writer keeps mutators out until the rollups match the table
+    auto connection = pool.acquireWriter();
+    teamRollups.clear();
+    try {
+        PerformanceReview review;
+        stepRows(connection->statements.acquireRaw(SELECT_ALL_REVIEWS_SQL), [&](sqlite3_stmt* row) {
+            readRow(row, review);
+            teamRollups.addReview(review);
+        });
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "[rebuildTeamAnalytics] : " << e.what() << '\n';
+        return false;
+    }
+}
+
+bool DatabaseManager::rebuildOrgChart() {
+    // holding the writer keeps mutators out until the index matches the table; the scan then reads on the
+    // writer too, so this never waits for a reader while holding it
+    auto writer = pool.acquireWriter();
+    orgChart.clear();
+    return forEachEmployee([this](const Employee& employee) {
+        orgChart.upsert(employee.employeeId, employee.reportsTo, employee.isActive);
+    });
+}
+
+BulkImportResult DatabaseManager::addPerformanceReviews(const std::vector<PerformanceReview>& reviews,
+                                                        std::size_t batchSize) {
+    auto result = bulkInsert(
+        "addPerformanceReviews", INSERT_REVIEW_SQL, reviews, batchSize,
+        [](const PerformanceReview& review) -> const char* {
+            return (review.employeeId <= 0 || review.reviewerId <= 0) ? "Invalid employee or reviewer id" : nullptr;
+        },
+        [this](const PerformanceReview& review) { reviewWritten(review, ChangeKind::REVIEW_ADDED); });
+    return result;
 }
 
-std::function<void(int, std::string, int, std::string, std::string, int, bool)>
-DatabaseManager::getSingleEmployeeCollector(Employee& employee, bool& isFound) const {
-    return [&](int employeeId, std::string name, std::optional<int> reportsTo, std::string roleStr,
-               std::string hireDate, int personnelCode, bool isActive) {
-        employee.employeeId = employeeId;
-        employee.name = name;
-        employee.reportsTo = reportsTo;
-        employee.hireDate = hireDate;
-        employee.role = stringToRole(roleStr).value();
-        employee.personnelCode = personnelCode;
-        employee.isActive = isActive;
-        isFound = true;
+template <typename Row, typename Validator, typename Committed>
+BulkImportResult DatabaseManager::bulkInsert(const char* tag, const std::string& sql, const std::vector<Row>& rows,
+                                             std::size_t batchSize, Validator&& validate, Committed&& committed) {
+    // tag is a string literal per caller, so each gets its own operation
+    OperationTimer timer(dbOperation(tag));
+    BulkImportResult result;
+    if (batchSize == 0) {
+        batchSize = DEFAULT_IMPORT_BATCH_SIZE;
+    }
+    // rows written by the transaction that is still open, as they were stored
+    std::vector<Row> pendingRows;
+    std::size_t index{0};
+    auto connection = pool.acquireWriter();
+    auto& statements = connection->statements;
+    sqlite3* handle = connection->db.connection().get();
+    // handed on once their transaction committed, a rolled back batch never reaches the caches, indexes or feed
+    auto commitPending = [&] {
+        statements.acquire(COMMIT_SQL).execute();
+        result.inserted += pendingRows.size();
+        for (const auto& row : pendingRows) {
+            committed(row);
+        }
+        pendingRows.clear();
     };
+    try {
+        auto& stmt = statements.acquire(sql);
+        statements.acquire(BEGIN_SQL).execute();
+        for (; index < rows.size(); ++index) {
+            if (const char* reason = validate(rows[index])) {
+                result.errors.push_back({index, -1, reason});
+                continue;
+            }
+            // a failing row only rolls back its own statement, the batch keeps going
+            try {
+                auto&& stored = asInserted(rows[index]);
+                bindRow(stmt, stored);
+                stmt.execute();
+                // an upsert whose WHERE clause rejected the row changes nothing
+                if (sqlite3_changes(handle) > 0) {
+                    readInsertedId(pendingRows.emplace_back(stored), handle);
+                }
+            } catch (const sqlite::sqlite_exception& e) {
+                stmt.reset();
+                result.errors.push_back({index, e.get_code(), e.what()});
+            }
+            if (pendingRows.size() >= batchSize) {
+                commitPending();
+                statements.acquire(BEGIN_SQL).execute();
+            }
+        }
+        commitPending();
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[" << tag << "] : " << "batch rolled back at row " << index << ": " << e.what()
+                  << " (code: " << e.get_code() << ")" << std::endl;
+        recordFailure(timer, e);
+        try {
+            connection->db << "ROLLBACK;";
+        } catch (const sqlite::sqlite_exception&) {
+            // no transaction was open
+        }
+        result.errors.push_back({index, e.get_code(), e.what()});
+    }
+    Metrics::instance().dbRowsWritten.add(result.inserted);
+    return result;
 }
 
-std::function<void(int, int, int, std::string, float, std::string, float, float, float, float, float, float, float,
-                   float, float, float)>
-DatabaseManager::getPerformanceReviewCollector(PerformanceReview& review, bool& isFound) const {
-    return [&](int ReviewID, int employeeId, int reviewerId, std::string reviewDate, float overallRating,
-               std::string comments, float punctualityRating, float qualityOfWorkRating, float teamworkRating,
-               float communicationRating, float problemSolvingRating, float creativityRating,
-               float technicalSkillRating, float adaptibilityRating, float leadershipRating, float initiativeRating) {
-        review.reviewId = ReviewID;
-        review.employeeId = employeeId;
-        review.reviewerId = reviewerId;
-        review.reviewDate = reviewDate;
-        review.overallRating = overallRating;
-        review.punctualityRating = punctualityRating;
-        review.qualityOfWorkRating = qualityOfWorkRating;
-        review.teamworkRating = teamworkRating;
-        review.communicationRating = communicationRating;
-        review.problemSolvingRating = problemSolvingRating;
-        review.creativityRating = creativityRating;
-        review.technicalSkillsRating = technicalSkillRating;
-        review.adaptabilityRating = adaptibilityRating;
-        review.leadershipRating = leadershipRating;
-        review.initiativeRating = initiativeRating;
-        review.comments = comments;
-        isFound = true;
+std::optional<std::vector<VersionedRow<Employee>>> DatabaseManager::getDirtyEmployees(int afterEmployeeId,
+                                                                                     std::size_t limit) {
+    std::vector<VersionedRow<Employee>> rows;
+    try {
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_DIRTY_EMPLOYEES_SQL);
+        bindParameters(stmt, afterEmployeeId, static_cast<sqlite_int64>(limit));
+        stepRows(stmt, [&rows](sqlite3_stmt* row) {
+            auto& dirty = rows.emplace_back();
+            readRow(row, dirty.row);
+            dirty.version = sqlite3_column_int64(row, fieldCount<Employee>);
+            dirty.isNew = sqlite3_column_int(row, fieldCount<Employee> + 1) != 0;
+        });
+        return rows;
+    } catch (const std::exception& e) {
+        std::cerr << "[getDirtyEmployees] : " << e.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+std::optional<std::vector<VersionedRow<PerformanceReview>>>
+DatabaseManager::getDirtyPerformanceReviews(int afterReviewId, std::size_t limit) {
+    std::vector<VersionedRow<PerformanceReview>> rows;
+    try {
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_DIRTY_REVIEWS_SQL);
+        bindParameters(stmt, afterReviewId, static_cast<sqlite_int64>(limit));
+        stepRows(stmt, [&rows](sqlite3_stmt* row) {
+            auto& dirty = rows.emplace_back();
+            readRow(row, dirty.row);
+            dirty.version = sqlite3_column_int64(row, fieldCount<PerformanceReview>);
+            dirty.isNew = sqlite3_column_int(row, fieldCount<PerformanceReview> + 1) != 0;
+        });
+        return rows;
+    } catch (const std::exception& e) {
+        std::cerr << "[getDirtyPerformanceReviews] : " << e.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+bool DatabaseManager::markEmployeesSynced(const std::vector<SyncedVersion>& versions) {
+    return markSynced("markEmployeesSynced", MARK_EMPLOYEE_SYNCED_SQL, versions);
+}
+
+bool DatabaseManager::markPerformanceReviewsSynced(const std::vector<SyncedVersion>& versions) {
+    return markSynced("markPerformanceReviewsSynced", MARK_REVIEW_SYNCED_SQL, versions);
+}
+
+bool DatabaseManager::markSynced(const char* tag, const std::string& sql, const std::vector<SyncedVersion>& versions) {
+    if (versions.empty()) {
+        return true;
+    }
+    auto connection = pool.acquireWriter();
+    auto& statements = connection->statements;
+    try {
+        auto& stmt = statements.acquire(sql);
+        statements.acquire(BEGIN_SQL).execute();
+        for (const auto& synced : versions) {
+            stmt << static_cast<sqlite_int64>(synced.version) << synced.id;
+            stmt.execute();
+        }
+        statements.acquire(COMMIT_SQL).execute();
+        return true;
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[" << tag << "] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        try {
+            connection->db << "ROLLBACK;";
+        } catch (const sqlite::sqlite_exception&) {
+            // no transaction was open
+        }
+        return false;
+    }
+}
+
+BulkImportResult DatabaseManager::applyRemoteEmployees(const std::vector<Employee>& employees) {
+    // holding the writer keeps new local rows off the vacated ids until the pulled ones are in
+    auto writer = pool.acquireWriter();
+    std::vector<int> ids;
+    ids.reserve(employees.size());
+    for (const auto& employee : employees) {
+        ids.push_back(employee.employeeId);
+    }
+    if (!renumberRows("applyRemoteEmployees", [&ids](PooledConnection& connection, Renumbered& renumbered) {
+            vacateIds(connection, EMPLOYEE_IDS, ids, renumbered);
+        })) {
+        return {0, {{0, -1, "could not move local rows off the pulled ids"}}};
+    }
+    return bulkInsert(
+        "applyRemoteEmployees", UPSERT_REMOTE_EMPLOYEE_SQL, employees, DEFAULT_IMPORT_BATCH_SIZE,
+        [](const Employee& employee) -> const char* {
+            return employee.employeeId <= 0 ? "Invalid employee Id" : nullptr;
+        },
+        [this](const Employee& employee) { employeeWritten(employee, ChangeKind::EMPLOYEE_UPDATED); });
+}
+
+BulkImportResult DatabaseManager::applyRemotePerformanceReviews(const std::vector<PerformanceReview>& reviews) {
+    auto writer = pool.acquireWriter();
+    std::vector<int> ids;
+    ids.reserve(reviews.size());
+    for (const auto& review : reviews) {
+        ids.push_back(review.reviewId);
+    }
+    if (!renumberRows("applyRemotePerformanceReviews", [&ids](PooledConnection& connection, Renumbered& renumbered) {
+            vacateIds(connection, REVIEW_IDS, ids, renumbered);
+        })) {
+        return {0, {{0, -1, "could not move local rows off the pulled ids"}}};
+    }
+    return bulkInsert(
+        "applyRemotePerformanceReviews", UPSERT_REMOTE_REVIEW_SQL, reviews, DEFAULT_IMPORT_BATCH_SIZE,
+        [](const PerformanceReview& review) -> const char* {
+            return review.reviewId <= 0 ? "Invalid review id" : nullptr;
+        },
+        [this](const PerformanceReview& review) { reviewWritten(review, ChangeKind::REVIEW_UPDATED); });
+}
+
+bool DatabaseManager::adoptServerEmployeeIds(const std::vector<AssignedId>& assigned) {
+    return assigned.empty() ||
+           renumberRows("adoptServerEmployeeIds", [&assigned](PooledConnection& connection, Renumbered& renumbered) {
+               adoptIds(connection, EMPLOYEE_IDS, assigned, renumbered);
+           });
+}
+
+bool DatabaseManager::adoptServerReviewIds(const std::vector<AssignedId>& assigned) {
+    return assigned.empty() ||
+           renumberRows("adoptServerReviewIds", [&assigned](PooledConnection& connection, Renumbered& renumbered) {
+               adoptIds(connection, REVIEW_IDS, assigned, renumbered);
+           });
+}
+
+template <typename Step>
+bool DatabaseManager::renumberRows(const char* tag, Step&& step) {
+    auto connection = pool.acquireWriter();
+    auto& statements = connection->statements;
+    Renumbered renumbered;
+    try {
+        statements.acquire(BEGIN_SQL).execute();
+        step(*connection, renumbered);
+        statements.acquire(COMMIT_SQL).execute();
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[" << tag << "] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        try {
+            connection->db << "ROLLBACK;";
+        } catch (const sqlite::sqlite_exception&) {
+            // no transaction was open
+        }
+        return false;
+    }
+    reloadRows(*connection, std::move(renumbered.employeeIds), std::move(renumbered.reviewIds));
+    return true;
+}
+
+void DatabaseManager::reloadRows(PooledConnection& connection, std::vector<int> employeeIds,
+                                 std::vector<int> reviewIds) {
+    auto distinct = [](std::vector<int>& ids) {
+        ids.erase(std::remove_if(ids.begin(), ids.end(), [](int id) { return id <= 0; }), ids.end());
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
     };
+    distinct(employeeIds);
+    distinct(reviewIds);
+    std::vector<Employee> employees;
+    std::vector<PerformanceReview> reviews;
+    try {
+        if (!employeeIds.empty()) {
+            auto* stmt = connection.statements.acquireRaw(SELECT_EMPLOYEES_BY_ID_SQL);
+            bindParameters(stmt, idArray(employeeIds));
+            stepRows(stmt, [&employees](sqlite3_stmt* row) { readRow(row, employees.emplace_back()); });
+        }
+        if (!reviewIds.empty()) {
+            auto* stmt = connection.statements.acquireRaw(SELECT_HOT_REVIEWS_BY_ID_SQL);
+            bindParameters(stmt, idArray(reviewIds));
+            stepRows(stmt, [&reviews](sqlite3_stmt* row) { readRow(row, reviews.emplace_back()); });
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[reloadRows] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        return;
+    }
+    // employees first, the review rollups follow the reporting lines
+    std::unordered_set<int> found;
+    for (const auto& employee : employees) {
+        found.insert(employee.employeeId);
+    }
+    for (int id : employeeIds) {
+        if (found.count(id) == 0) {
+            if (employeeCache) {
+                employeeCache->erase(id);
+            }
+            if (orgChartEnabled) {
+                orgChart.erase(id);
+            }
+            if (searchEnabled) {
+                employeeNames.erase(id);
+            }
+            publishChange(ChangeKind::EMPLOYEE_UPDATED, id);
+        }
+    }
+    for (const auto& employee : employees) {
+        employeeWritten(employee, ChangeKind::EMPLOYEE_UPDATED);
+    }
+    found.clear();
+    for (const auto& review : reviews) {
+        found.insert(review.reviewId);
+    }
+    for (int id : reviewIds) {
+        if (found.count(id) == 0) {
+            reviewDeleted(id);
+        }
+    }
+    for (const auto& review : reviews) {
+        reviewWritten(review, ChangeKind::REVIEW_UPDATED);
+    }
+}
+
+bool DatabaseManager::archiveReviewsBefore(int year) {
+    static auto& metrics = dbOperation("archiveReviewsBefore");
+    OperationTimer timer(metrics);
+    if (dbAddress.empty() || dbAddress == ":memory:") {
+        std::cerr << "[archiveReviewsBefore] : " << "an in-memory database has no place for archives" << std::endl;
+        timer.fail();
+        return false;
+    }
+    // holding the writer keeps every review write out until the moved years are gone from the hot table
+    auto connection = pool.acquireWriter();
+    auto& db = connection->db;
+    std::vector<int> years;
+    try {
+        auto* stmt = connection->statements.acquireRaw(SELECT_REVIEW_YEARS_SQL);
+        std::string cutoff = yearStart(year);
+        bindParameters(stmt, cutoff);
+        stepRows(stmt, [&years](sqlite3_stmt* row) { years.push_back(sqlite3_column_int(row, 0)); });
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[archiveReviewsBefore] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        recordFailure(timer, e);
+        return false;
+    }
+    if (years.empty()) {
+        return true;
+    }
+
+    // 1. copy every year into its archive, committed and compacted before anything leaves the hot table;
+    // until step 3 the copies are not attached anywhere, so an interruption only leaves unused files behind
+    std::vector<ReviewArchive> previous = reviewArchives();
+    std::vector<ReviewArchive> archived = previous;
+    for (int closed : years) {
+        ReviewArchive archive{closed, archivePath(dbAddress, closed), 0};
+        std::string from = yearStart(closed);
+        std::string to = yearStart(closed + 1);
+        try {
+            db << ARCHIVE_TARGET_SQL << archive.path;
+        } catch (const sqlite::sqlite_exception& e) {
+            std::cerr << "[archiveReviewsBefore] : " << archive.path << ": " << e.what() << std::endl;
+            recordFailure(timer, e);
+            return false;
+        }
+        try {
+            db << BEGIN_SQL;
+            db << CREATE_ARCHIVE_TABLE_SQL;
+            for (const auto& index : CREATE_ARCHIVE_INDEXES_SQL) {
+                db << index;
+            }
+            db << COPY_TO_ARCHIVE_SQL << from << to;
+            db << COMMIT_SQL;
+            db << COUNT_ARCHIVE_SQL >> [&archive](sqlite_int64 count) {
+                archive.reviewCount = static_cast<std::size_t>(count);
+            };
+            db << VACUUM_ARCHIVE_SQL;
+            db << DETACH_ARCHIVE_TARGET_SQL;
+        } catch (const sqlite::sqlite_exception& e) {
+            std::cerr << "[archiveReviewsBefore] : " << archive.path << ": " << e.what() << " (code: " << e.get_code()
+                      << ")" << std::endl;
+            recordFailure(timer, e);
+            try {
+                db << "ROLLBACK;";
+            } catch (const sqlite::sqlite_exception&) {
+                // no transaction was open
+            }
+            try {
+                db << DETACH_ARCHIVE_TARGET_SQL;
+            } catch (const sqlite::sqlite_exception&) {
+                // already detached
+            }
+            return false;
+        }
+        auto existing = std::find_if(archived.begin(), archived.end(),
+                                     [closed](const ReviewArchive& other) { return other.year == closed; });
+        if (existing != archived.end()) {
+            *existing = archive;
+        } else {
+            archived.push_back(archive);
+        }
+    }
+    std::sort(archived.begin(), archived.end(),
+              [](const ReviewArchive& a, const ReviewArchive& b) { return a.year < b.year; });
+
+    // 2. attach the archives before the rows leave the hot table: a read in between sees them twice, never not at all
+    attachReviewArchives(archived);
+
+    // 3. drop the copied rows and register the archives in one transaction
+    std::uint64_t moved{0};
+    try {
+        db << BEGIN_SQL;
+        for (const auto& archive : archived) {
+            if (std::find(years.begin(), years.end(), archive.year) == years.end()) {
+                continue;
+            }
+            db << DELETE_ARCHIVED_SQL << yearStart(archive.year) << yearStart(archive.year + 1);
+            moved += static_cast<std::uint64_t>(sqlite3_changes(db.connection().get()));
+            db << REGISTER_ARCHIVE_SQL << archive.year << archive.path
+               << static_cast<sqlite_int64>(archive.reviewCount);
+        }
+        db << COMMIT_SQL;
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[archiveReviewsBefore] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        recordFailure(timer, e);
+        try {
+            db << "ROLLBACK;";
+        } catch (const sqlite::sqlite_exception&) {
+            // no transaction was open
+        }
+        attachReviewArchives(previous);
+        return false;
+    }
+    Metrics::instance().dbRowsWritten.add(moved);
+
+    // 4. hand the freed pages back, so the hot file (and a backup of it) only holds the open periods;
+    // the archiving itself already succeeded, a failure here only leaves the file at its old size
+    try {
+        db << VACUUM_HOT_SQL;
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[archiveReviewsBefore] : " << "hot database not compacted: " << e.what() << std::endl;
+    }
+    return true;
+}
+
+std::vector<ReviewArchive> DatabaseManager::reviewArchives() const {
+    std::lock_guard<std::mutex> lock(archivesMutex);
+    return archives;
+}
+
+bool DatabaseManager::loadReviewArchives() {
+    std::vector<ReviewArchive> archived;
+    bool loaded{true};
+    try {
+        auto connection = pool.acquireWriter();
+        stepRows(connection->statements.acquireRaw(SELECT_ARCHIVES_SQL), [&archived](sqlite3_stmt* row) {
+            archived.push_back({sqlite3_column_int(row, 0), std::string(mapping::columnText(row, 1)),
+                                static_cast<std::size_t>(sqlite3_column_int64(row, 2))});
+        });
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[loadReviewArchives] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        loaded = false;
+    }
+    attachReviewArchives(std::move(archived));
+    return loaded;
+}
+
+void DatabaseManager::attachReviewArchives(std::vector<ReviewArchive> archived) {
+    std::lock_guard<std::mutex> lock(archivesMutex);
+    archives = std::move(archived);
+    pool.setConnectionSetup([attached = archives](PooledConnection& connection) {
+        attachArchives(connection, attached);
+    });
+}
+
+bool DatabaseManager::writeSnapshot(const std::string& path) {
+    static auto& metrics = dbOperation("writeSnapshot");
+    OperationTimer timer(metrics);
+    SnapshotWriter writer;
+    std::size_t rows{0};
+    auto connection = pool.acquireReader();
+    try {
+        // both tables from the same point in time
+        connection->db << BEGIN_SQL;
+        // one model each, read into again for every row
+        Employee employee;
+        stepRows(connection->statements.acquireRaw(STREAM_EMPLOYEES_SQL), [&](sqlite3_stmt* row) {
+            readRow(row, employee);
+            writer.addEmployee(employee);
+            ++rows;
+        });
+        PerformanceReview review;
+        stepRows(connection->statements.acquireRaw(SELECT_SNAPSHOT_REVIEWS_SQL), [&](sqlite3_stmt* row) {
+            readRow(row, review);
+            writer.addReview(review);
+            ++rows;
+        });
+        connection->db << COMMIT_SQL;
+    } catch (const std::exception& e) {
+        std::cerr << "[writeSnapshot] : " << e.what() << '\n';
+        recordFailure(timer, e);
+        try {
+            connection->db << "ROLLBACK;";
+        } catch (const sqlite::sqlite_exception&) {
+            // no transaction was open
+        }
+        return false;
+    }
+    Metrics::instance().dbRowsRead.add(rows);
+    if (!writer.write(path)) {
+        timer.fail();
+        return false;
+    }
+    return true;
+}
+
+BulkImportResult DatabaseManager::importSnapshot(const Snapshot& snapshot) {
+    std::vector<Employee> employees;
+    employees.reserve(snapshot.employeeCount());
+    for (std::size_t i = 0; i < snapshot.employeeCount(); ++i) {
+        employees.push_back(snapshot.employeeAt(i));
+    }
+    BulkImportResult result = addEmployees(employees);
+    employees = {};
+
+    std::vector<PerformanceReview> reviews;
+    reviews.reserve(snapshot.reviewCount());
+    for (std::size_t i = 0; i < snapshot.reviewCount(); ++i) {
+        reviews.push_back(snapshot.reviewAt(i));
+    }
+    BulkImportResult reviewResult = addPerformanceReviews(reviews);
+    // review error indexes continue after the employees, in snapshot record order
+    result.inserted += reviewResult.inserted;
+    for (auto& error : reviewResult.errors) {
+        error.index += snapshot.employeeCount();
+        result.errors.push_back(std::move(error));
+    }
+    return result;
+}
+
+std::int64_t DatabaseManager::syncWatermark(const std::string& name) {
+    try {
+        auto connection = pool.acquireReader();
+        sqlite_int64 value{0};
+        auto& stmt = connection->statements.acquire(SELECT_WATERMARK_SQL);
+        stmt << name;
+        stmt >> [&value](sqlite_int64 stored) { value = stored; };
+        return value;
+    } catch (const std::exception& e) {
+        std::cerr << "[syncWatermark] : " << e.what() << '\n';
+        return 0;
+    }
+}
+
+bool DatabaseManager::setSyncWatermark(const std::string& name, std::int64_t value) {
+    try {
+        auto connection = pool.acquireWriter();
+        auto& stmt = connection->statements.acquire(UPSERT_WATERMARK_SQL);
+        stmt << name << static_cast<sqlite_int64>(value);
+        stmt.execute();
+        return true;
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[setSyncWatermark] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+        return false;
+    }
+}
+
+std::optional<KpiColumnStore> DatabaseManager::loadKpiColumnStore() {
+    static auto& metrics = dbOperation("loadKpiColumnStore");
+    OperationTimer timer(metrics);
+    KpiColumnStore store;
+    try {
+        auto connection = pool.acquireReader();
+        int reviewCount{0};
+        connection->statements.acquire(COUNT_REVIEWS_SQL) >> reviewCount;
+        store.reserve(static_cast<std::size_t>(reviewCount));
+        PerformanceReview review;
+        stepRows(connection->statements.acquireRaw(SELECT_ALL_REVIEWS_SQL), [&](sqlite3_stmt* row) {
+            readRow(row, review);
+            store.append(review);
+        });
+        Metrics::instance().dbRowsRead.add(store.size());
+        return store;
+    } catch (const std::exception& e) {
+        std::cerr << "[loadKpiColumnStore] : " << e.what() << '\n';
+        recordFailure(timer, e);
+        return std::nullopt;
+    }
+}
+
+bool DatabaseManager::scanAllPerformanceReviews(ReviewArena& arena) {
+    static auto& metrics = dbOperation("scanAllPerformanceReviews");
+    OperationTimer timer(metrics);
+    arena.clear();
+    try {
+        auto connection = pool.acquireReader();
+        int reviewCount{0};
+        connection->statements.acquire(COUNT_REVIEWS_SQL) >> reviewCount;
+        arena.reserve(static_cast<std::size_t>(reviewCount));
+        stepRows(connection->statements.acquireRaw(SELECT_REVIEW_ROWS_SQL), [&arena](sqlite3_stmt* stmt) {
+            ReviewRow& row = arena.append();
+            row.reviewId = sqlite3_column_int(stmt, REVIEW_ID_COLUMN);
+            row.employeeId = sqlite3_column_int(stmt, REVIEW_EMPLOYEE_COLUMN);
+            row.reviewerId = sqlite3_column_int(stmt, REVIEW_REVIEWER_COLUMN);
+            row.reviewDay = toDayNumber(mapping::columnText(stmt, REVIEW_DATE_COLUMN)).value_or(NO_DAY);
+            if (sqlite3_column_type(stmt, REVIEW_OVERALL_COLUMN) != SQLITE_NULL) {
+                row.overallRating = static_cast<float>(sqlite3_column_double(stmt, REVIEW_OVERALL_COLUMN));
+            }
+            if (sqlite3_column_type(stmt, REVIEW_COMMENTS_COLUMN) != SQLITE_NULL) {
+                row.comments = arena.intern(mapping::columnText(stmt, REVIEW_COMMENTS_COLUMN));
+            }
+            for (std::size_t k = 0; k < KPI_COUNT; ++k) {
+                row.kpis[k] = static_cast<float>(sqlite3_column_double(stmt, REVIEW_KPI_COLUMNS[k]));
+            }
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "[scanAllPerformanceReviews] : " << e.what() << '\n';
+        recordFailure(timer, e);
+        arena.clear();
+        return false;
+    }
+    Metrics::instance().dbRowsRead.add(arena.size());
+    return true;
+}
+
+std::future<WriteResult> DatabaseManager::submitPerformanceReview(const PerformanceReview& review) {
+    return submitWrite(WriteKind::INSERT_REVIEW, review);
+}
+
+std::future<WriteResult> DatabaseManager::submitPerformanceReviewUpdate(const PerformanceReview& review) {
+    return submitWrite(WriteKind::UPDATE_REVIEW, review);
+}
+
+std::future<WriteResult> DatabaseManager::submitPerformanceReviewDeletion(int reviewId) {
+    PerformanceReview review;
+    review.reviewId = reviewId;
+    return submitWrite(WriteKind::DELETE_REVIEW, review);
+}
+
+bool DatabaseManager::calibrate(CalibrationEngine& engine) {
+    static auto& metrics = dbOperation("calibrate");
+    OperationTimer timer(metrics);
+    EmployeeArena employees;
+    ReviewArena reviews;
+    // both scans stay on this thread: a scan on another thread would wait for a second connection while this
+    // one may already hold one (a visitor, a cursor loop or a writer lease), which the pool forbids
+    if (!scanAllEmployees(employees) || !scanAllPerformanceReviews(reviews)) {
+        timer.fail();
+        return false;
+    }
+    engine.compute(employees, reviews);
+    return true;
+}
+
+std::optional<std::vector<std::optional<PerformanceReview>>>
+DatabaseManager::getLatestReviewsForEmployees(const std::vector<int>& employeeIds) {
+    static auto& metrics = dbOperation("getLatestReviewsForEmployees");
+    OperationTimer timer(metrics);
+    std::vector<PerformanceReview> reviews;
+    std::string ids = idArray(employeeIds);
+    if (ids.empty()) {
+        return std::vector<std::optional<PerformanceReview>>(employeeIds.size());
+    }
+
+    try {
+        auto connection = pool.acquireReader();
+        auto* stmt = connection->statements.acquireRaw(SELECT_LATEST_REVIEWS_SQL);
+        bindParameters(stmt, ids);
+        stepRows(stmt, [&reviews](sqlite3_stmt* row) { readRow(row, reviews.emplace_back()); });
+        Metrics::instance().dbRowsRead.add(reviews.size());
+    } catch (const std::exception& e) {
+        std::cerr << "[getLatestReviewsForEmployees] : " << e.what() << '\n';
+        recordFailure(timer, e);
+        return std::nullopt;
+    }
+    return inRequestOrder(employeeIds, reviews, [](const PerformanceReview& review) { return review.employeeId; });
+}
+
+std::future<WriteResult> DatabaseManager::submitWrite(WriteKind kind, const PerformanceReview& review) {
+    if (writeBehind) {
+        return writeBehind->submit(kind, review);
+    }
+    // disabled: a group of one, committed right here
+    std::vector<PendingWrite> group(1);
+    group[0].kind = kind;
+    group[0].review = review;
+    auto future = group[0].done.get_future();
+    commitWriteGroup(group);
+    return future;
+}
+
+void DatabaseManager::enableWriteBehind(const WriteBehindConfig& config) {
+    writeBehind = std::make_unique<WriteBehindQueue>(
+        config, [this](std::vector<PendingWrite>& group) { commitWriteGroup(group); });
+}
+
+void DatabaseManager::flushWriteBehind() {
+    if (writeBehind) {
+        writeBehind->flush();
+    }
+}
+
+std::size_t DatabaseManager::writeBehindBacklog() const {
+    return writeBehind ? writeBehind->backlog() : 0;
+}
+
+void DatabaseManager::commitWriteGroup(std::vector<PendingWrite>& group) {
+    static auto& metrics = dbOperation("commitWriteGroup");
+    OperationTimer timer(metrics);
+    std::vector<WriteResult> results(group.size());
+    std::uint64_t written{0};
+    auto connection = pool.acquireWriter();
+    auto& statements = connection->statements;
+    sqlite3* handle = connection->db.connection().get();
+    try {
+        statements.acquire(BEGIN_SQL).execute();
+        for (std::size_t i = 0; i < group.size(); ++i) {
+            const PerformanceReview& review = group[i].review;
+            results[i].reviewId = review.reviewId;
+            if (group[i].kind != WriteKind::INSERT_REVIEW && review.reviewId <= 0) {
+                continue;
+            }
+            // as in bulkInsert, a failing statement only rolls back itself and the group goes on
+            sqlite::database_binder* stmt{nullptr};
+            try {
+                switch (group[i].kind) {
+                case WriteKind::INSERT_REVIEW:
+                    stmt = &statements.acquire(INSERT_REVIEW_SQL);
+                    group[i].review = asInserted(review);
+                    bindRow(*stmt, review);
+                    break;
+                case WriteKind::UPDATE_REVIEW:
+                    stmt = &statements.acquire(UPDATE_REVIEW_SQL);
+                    bindUpdate(*stmt, review);
+                    break;
+                case WriteKind::DELETE_REVIEW:
+                    stmt = &statements.acquire(DELETE_REVIEW_SQL);
+                    *stmt << review.reviewId;
+                    break;
+                }
+                stmt->execute();
+            } catch (const sqlite::sqlite_exception& e) {
+                if (stmt) {
+                    stmt->reset();
+                }
+                std::cerr << "[commitWriteGroup] : " << e.what() << " (code: " << e.get_code() << ")" << std::endl;
+                continue;
+            }
+            // an update or delete of a missing review
+            if (sqlite3_changes(handle) == 0) {
+                continue;
+            }
+            if (review.reviewId <= 0) {
+                results[i].reviewId = static_cast<int>(sqlite3_last_insert_rowid(handle));
+            }
+            results[i].status = WriteStatus::COMMITTED;
+            ++written;
+        }
+        statements.acquire(COMMIT_SQL).execute();
+    } catch (const sqlite::sqlite_exception& e) {
+        std::cerr << "[commitWriteGroup] : " << "group of " << group.size() << " rolled back: " << e.what()
+                  << " (code: " << e.get_code() << ")" << std::endl;
+        recordFailure(timer, e);
+        try {
+            connection->db << "ROLLBACK;";
+        } catch (const sqlite::sqlite_exception&) {
+            // no transaction was open
+        }
+        for (auto& result : results) {
+            result.status = WriteStatus::FAILED;
+        }
+        written = 0;
+    }
+    Metrics::instance().dbRowsWritten.add(written);
+
+    // caches and indexes first, so a submitter that wakes up reads its own write
+    for (std::size_t i = 0; i < group.size(); ++i) {
+        if (!results[i].ok()) {
+            continue;
+        }
+        if (group[i].kind == WriteKind::DELETE_REVIEW) {
+            reviewDeleted(results[i].reviewId);
+        } else {
+            group[i].review.reviewId = results[i].reviewId;
+            bool inserted = group[i].kind == WriteKind::INSERT_REVIEW;
+            reviewWritten(group[i].review, inserted ? ChangeKind::REVIEW_ADDED : ChangeKind::REVIEW_UPDATED);
+        }
+    }
+    for (std::size_t i = 0; i < group.size(); ++i) {
+        group[i].done.set_value(results[i]);
+    }
+}
+
+void DatabaseManager::reviewWritten(const PerformanceReview& review, ChangeKind kind) {
+    if (reviewCache) {
+        reviewCache->erase(review.reviewId);
+    }
+    if (teamAnalyticsEnabled) {
+        teamRollups.addReview(review);
+    }
+    if (searchEnabled) {
+        reviewComments.upsert(review.reviewId, review.comments.value_or(""));
+    }
+    publishChange(kind, review.employeeId, review.reviewId);
+}
+
+void DatabaseManager::employeeWritten(const Employee& employee, ChangeKind kind) {
+    if (employeeCache) {
+        employeeCache->erase(employee.employeeId);
+    }
+    if (orgChartEnabled) {
+        orgChart.upsert(employee.employeeId, employee.reportsTo, employee.isActive);
+    }
+    if (searchEnabled) {
+        employeeNames.upsert(employee.employeeId, employee.name);
+    }
+    publishChange(kind, employee.employeeId);
+}
+
+void DatabaseManager::reviewDeleted(int reviewId) {
+    if (reviewCache) {
+        reviewCache->erase(reviewId);
+    }
+    if (teamAnalyticsEnabled) {
+        teamRollups.removeReview(reviewId);
+    }
+    if (searchEnabled) {
+        reviewComments.erase(reviewId);
+    }
+    publishChange(ChangeKind::REVIEW_DELETED, 0, reviewId);
+}
+
+void DatabaseManager::publishChange(ChangeKind kind, int employeeId, int reviewId) {
+    if (changeEvents) {
+        changeEvents->publish(kind, employeeId, reviewId);
+    }
+}
+
+void DatabaseManager::enableReadCache(std::size_t employeeCapacity, std::size_t reviewCapacity) {
+    employeeCache = employeeCapacity > 0 ? std::make_unique<LruCache<int, Employee>>(employeeCapacity) : nullptr;
+    reviewCache = reviewCapacity > 0 ? std::make_unique<LruCache<int, PerformanceReview>>(reviewCapacity) : nullptr;
+}
+
+void DatabaseManager::enableChangeFeed(std::size_t capacity) {
+    changeEvents = std::make_unique<ChangeFeed>(capacity);
+}
+
+const ChangeFeed* DatabaseManager::changeFeed() const {
+    return changeEvents.get();
+}
+
+LruCacheStats DatabaseManager::employeeCacheStats() const {
+    return employeeCache ? employeeCache->stats() : LruCacheStats{};
+}
+
+LruCacheStats DatabaseManager::reviewCacheStats() const {
+    return reviewCache ? reviewCache->stats() : LruCacheStats{};
+}
+
+std::size_t DatabaseManager::statementCacheHits() const {
+    return pool.statementCacheHits();
+}
+
+std::size_t DatabaseManager::statementCacheMisses() const {
+    return pool.statementCacheMisses();
 }
 
 } // namespace PerfMgmt
\ No newline at end of file
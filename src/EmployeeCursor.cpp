@@ -0,0 +1,92 @@
+#include "EmployeeCursor.hpp"
+#include <RowMapping.hpp>
+#include <iostream>
+
+namespace PerfMgmt {
+
+EmployeeCursor::iterator::iterator(EmployeeCursor* cursor) : cursor(cursor) {
+}
+
+EmployeeCursor::iterator::reference EmployeeCursor::iterator::operator*() const {
+    return cursor->current();
+}
+
+EmployeeCursor::iterator::pointer EmployeeCursor::iterator::operator->() const {
+    return &cursor->current();
+}
+
+EmployeeCursor::iterator& EmployeeCursor::iterator::operator++() {
+    if (!cursor->next()) {
+        cursor = nullptr;
+    }
+    return *this;
+}
+
+bool EmployeeCursor::iterator::operator==(const iterator& other) const {
+    return cursor == other.cursor;
+}
+
+bool EmployeeCursor::iterator::operator!=(const iterator& other) const {
+    return cursor != other.cursor;
+}
+
+EmployeeCursor::EmployeeCursor(ConnectionPool::Lease connection, const std::string& sql) :
+    connection(std::move(connection)) {
+    sqlite3* handle = this->connection->db.connection().get();
+    if (sqlite3_prepare_v2(handle, sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "[EmployeeCursor] : " << sqlite3_errmsg(handle) << std::endl;
+        stmt = nullptr;
+        isOk = false;
+    }
+}
+
+EmployeeCursor::EmployeeCursor(EmployeeCursor&& other) noexcept :
+    connection(std::move(other.connection)), stmt(other.stmt), row(std::move(other.row)), isOk(other.isOk) {
+    other.stmt = nullptr;
+}
+
+EmployeeCursor::~EmployeeCursor() {
+    sqlite3_finalize(stmt);
+}
+
+bool EmployeeCursor::next() {
+    if (!stmt) {
+        return false;
+    }
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+        readRow();
+        return true;
+    }
+    if (rc != SQLITE_DONE) {
+        std::cerr << "[EmployeeCursor] : " << sqlite3_errmsg(connection->db.connection().get()) << std::endl;
+        isOk = false;
+    }
+    // release the statement early, the connection stays leased until destruction
+    sqlite3_finalize(stmt);
+    stmt = nullptr;
+    return false;
+}
+
+const Employee& EmployeeCursor::current() const {
+    return row;
+}
+
+bool EmployeeCursor::ok() const {
+    return isOk;
+}
+
+EmployeeCursor::iterator EmployeeCursor::begin() {
+    return iterator(next() ? this : nullptr);
+}
+
+EmployeeCursor::iterator EmployeeCursor::end() {
+    return iterator(nullptr);
+}
+
+void EmployeeCursor::readRow() {
+    // the statement selects the mapped columns in order; strings reuse the capacity of the previous row's
+    PerfMgmt::readRow(stmt, row);
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,484 @@
+#include <JsonStreamDecoder.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace PerfMgmt {
+
+namespace {
+const std::uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool isLiteralEnd(char c) {
+    return isWhitespace(c) || c == ',' || c == '}' || c == ']';
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void appendUtf8(std::uint32_t codePoint, std::string& target) {
+    if (codePoint < 0x80) {
+        target.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        target.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        target.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        target.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        target.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        target.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        target.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+// -?int(.digits)?([eE][+-]?digits)?
+bool isJsonNumber(std::string_view text) {
+    std::size_t i = 0;
+    auto digits = [&]() {
+        std::size_t start = i;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+            ++i;
+        }
+        return i > start;
+    };
+    if (i < text.size() && text[i] == '-') {
+        ++i;
+    }
+    if (!digits()) {
+        return false;
+    }
+    if (i < text.size() && text[i] == '.') {
+        ++i;
+        if (!digits()) {
+            return false;
+        }
+    }
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+        ++i;
+        if (i < text.size() && (text[i] == '+' || text[i] == '-')) {
+            ++i;
+        }
+        if (!digits()) {
+            return false;
+        }
+    }
+    return i == text.size();
+}
+
+std::optional<double> parseDouble(std::string_view text) {
+    // strtod needs a terminated copy; numbers are short, so it stays on the stack
+    char buffer[64];
+    if (text.size() >= sizeof(buffer)) {
+        return std::nullopt;
+    }
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    char* parsedEnd = nullptr;
+    double value = std::strtod(buffer, &parsedEnd);
+    if (parsedEnd != buffer + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+} // namespace
+
+// ---- JsonScalar ----
+
+std::optional<std::int64_t> JsonScalar::asInt64() const {
+    if (type != Type::Number) {
+        return std::nullopt;
+    }
+    std::int64_t value{0};
+    auto [parsedEnd, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec == std::errc() && parsedEnd == text.data() + text.size()) {
+        return value;
+    }
+    // 5.0 is accepted for integer fields like the DOM path does
+    auto real = parseDouble(text);
+    if (real && std::trunc(*real) == *real && std::fabs(*real) < 9.2e18) {
+        return static_cast<std::int64_t>(*real);
+    }
+    return std::nullopt;
+}
+
+std::optional<int> JsonScalar::asInt() const {
+    auto value = asInt64();
+    if (!value || *value < INT32_MIN || *value > INT32_MAX) {
+        return std::nullopt;
+    }
+    return static_cast<int>(*value);
+}
+
+std::optional<float> JsonScalar::asFloat() const {
+    if (type != Type::Number) {
+        return std::nullopt;
+    }
+    auto value = parseDouble(text);
+    if (!value) {
+        return std::nullopt;
+    }
+    return static_cast<float>(*value);
+}
+
+std::optional<bool> JsonScalar::asBool() const {
+    if (type != Type::Boolean) {
+        return std::nullopt;
+    }
+    return boolean;
+}
+
+std::optional<std::string_view> JsonScalar::asString() const {
+    if (type != Type::String) {
+        return std::nullopt;
+    }
+    return text;
+}
+
+// ---- JsonArrayStreamParser ----
+
+bool JsonArrayStreamParser::feed(const char* data, std::size_t length) {
+    const char* pos = data;
+    const char* end = data + length;
+    while (pos < end && state != State::Failed) {
+        bool skipsWhitespace = state != State::InKey && state != State::InString && state != State::InLiteral &&
+                               state != State::InNested;
+        if (skipsWhitespace) {
+            while (pos < end && isWhitespace(*pos)) {
+                ++pos;
+            }
+            if (pos == end) {
+                break;
+            }
+        }
+        auto unexpected = [&]() {
+            fail(std::string("unexpected '") + *pos + "' at offset " + std::to_string(offset + (pos - data)));
+        };
+
+        switch (state) {
+        case State::BeforeArray:
+            if (*pos != '[') {
+                unexpected();
+                break;
+            }
+            state = State::BeforeFirstRecord;
+            ++pos;
+            break;
+        case State::BeforeFirstRecord:
+        case State::BeforeRecord:
+            if (*pos == ']' && state == State::BeforeFirstRecord) {
+                state = State::Done;
+            } else if (*pos == '{') {
+                onRecordBegin();
+                state = State::BeforeFirstKey;
+            } else {
+                unexpected();
+                break;
+            }
+            ++pos;
+            break;
+        case State::AfterRecord:
+            if (*pos == ',') {
+                state = State::BeforeRecord;
+            } else if (*pos == ']') {
+                state = State::Done;
+            } else {
+                unexpected();
+                break;
+            }
+            ++pos;
+            break;
+        case State::BeforeFirstKey:
+        case State::BeforeKey:
+            if (*pos == '}' && state == State::BeforeFirstKey) {
+                ++pos;
+                if (!onRecordEnd()) {
+                    fail("record rejected");
+                    break;
+                }
+                state = State::AfterRecord;
+            } else if (*pos == '"') {
+                ++pos;
+                key.clear();
+                state = State::InKey;
+            } else {
+                unexpected();
+            }
+            break;
+        case State::InKey: {
+            bool closed{false};
+            pos = readString(pos, end, key, closed);
+            if (closed) {
+                state = State::AfterKey;
+            }
+            break;
+        }
+        case State::AfterKey:
+            if (*pos != ':') {
+                unexpected();
+                break;
+            }
+            state = State::BeforeValue;
+            ++pos;
+            break;
+        case State::BeforeValue:
+            scratch.clear();
+            if (*pos == '"') {
+                state = State::InString;
+                ++pos;
+            } else if (*pos == '{' || *pos == '[') {
+                nestedDepth = 1;
+                nestedInString = false;
+                nestedEscape = false;
+                state = State::InNested;
+                ++pos;
+            } else {
+                state = State::InLiteral;
+            }
+            break;
+        case State::InString: {
+            bool closed{false};
+            pos = readString(pos, end, scratch, closed);
+            if (closed) {
+                JsonScalar value;
+                value.type = JsonScalar::Type::String;
+                value.text = scratch;
+                if (emitField(value)) {
+                    state = State::AfterValue;
+                }
+            }
+            break;
+        }
+        case State::InLiteral: {
+            const char* run = pos;
+            while (pos < end && !isLiteralEnd(*pos)) {
+                ++pos;
+            }
+            scratch.append(run, pos - run);
+            if (pos < end && emitLiteral()) {
+                state = State::AfterValue;
+            }
+            break;
+        }
+        case State::AfterValue:
+            if (*pos == ',') {
+                state = State::BeforeKey;
+            } else if (*pos == '}') {
+                if (!onRecordEnd()) {
+                    fail("record rejected");
+                    break;
+                }
+                state = State::AfterRecord;
+            } else {
+                unexpected();
+                break;
+            }
+            ++pos;
+            break;
+        case State::InNested:
+            for (; pos < end && nestedDepth > 0; ++pos) {
+                char c = *pos;
+                if (nestedInString) {
+                    if (nestedEscape) {
+                        nestedEscape = false;
+                    } else if (c == '\\') {
+                        nestedEscape = true;
+                    } else if (c == '"') {
+                        nestedInString = false;
+                    }
+                } else if (c == '"') {
+                    nestedInString = true;
+                } else if (c == '{' || c == '[') {
+                    ++nestedDepth;
+                } else if (c == '}' || c == ']') {
+                    --nestedDepth;
+                }
+            }
+            if (nestedDepth == 0) {
+                state = State::AfterValue;
+            }
+            break;
+        case State::Done:
+            fail("trailing characters at offset " + std::to_string(offset + (pos - data)));
+            break;
+        case State::Failed:
+            break;
+        }
+    }
+    offset += length;
+    return state != State::Failed;
+}
+
+bool JsonArrayStreamParser::finish() {
+    if (state == State::Done) {
+        return true;
+    }
+    // a literal is only known to be complete once its delimiter arrives
+    fail("unexpected end of input at offset " + std::to_string(offset));
+    return false;
+}
+
+bool JsonArrayStreamParser::failed() const {
+    return state == State::Failed;
+}
+
+const std::string& JsonArrayStreamParser::error() const {
+    return errorMessage;
+}
+
+void JsonArrayStreamParser::fail(const std::string& message) {
+    // keep the first error, later ones are consequences of it
+    if (state != State::Failed) {
+        errorMessage = message;
+        state = State::Failed;
+    }
+}
+
+const char* JsonArrayStreamParser::readString(const char* pos, const char* end, std::string& target, bool& closed) {
+    // a lone high surrogate is replaced once it is clear no low surrogate follows
+    auto flushSurrogate = [&]() {
+        if (highSurrogate != 0) {
+            appendUtf8(REPLACEMENT_CHARACTER, target);
+            highSurrogate = 0;
+        }
+    };
+    while (pos < end) {
+        if (unicodeDigits >= 0) {
+            int digit = hexValue(*pos++);
+            if (digit < 0) {
+                fail("invalid \\u escape at offset " + std::to_string(offset));
+                return end;
+            }
+            unicodeValue = (unicodeValue << 4) | static_cast<std::uint32_t>(digit);
+            if (++unicodeDigits < 4) {
+                continue;
+            }
+            unicodeDigits = -1;
+            if (unicodeValue >= 0xD800 && unicodeValue <= 0xDBFF) {
+                flushSurrogate();
+                highSurrogate = unicodeValue;
+            } else if (unicodeValue >= 0xDC00 && unicodeValue <= 0xDFFF) {
+                if (highSurrogate != 0) {
+                    appendUtf8(0x10000 + ((highSurrogate - 0xD800) << 10) + (unicodeValue - 0xDC00), target);
+                    highSurrogate = 0;
+                } else {
+                    appendUtf8(REPLACEMENT_CHARACTER, target);
+                }
+            } else {
+                flushSurrogate();
+                appendUtf8(unicodeValue, target);
+            }
+            continue;
+        }
+        if (inEscape) {
+            inEscape = false;
+            if (*pos != 'u') {
+                flushSurrogate();
+            }
+            if (!appendEscape(*pos++, target)) {
+                return end;
+            }
+            continue;
+        }
+        // copy the plain run in one go
+        const char* run = pos;
+        while (pos < end && *pos != '"' && *pos != '\\' && static_cast<unsigned char>(*pos) >= 0x20) {
+            ++pos;
+        }
+        if (pos != run) {
+            flushSurrogate();
+            target.append(run, pos - run);
+        }
+        if (pos == end) {
+            break;
+        }
+        if (*pos == '"') {
+            flushSurrogate();
+            closed = true;
+            return pos + 1;
+        }
+        if (*pos == '\\') {
+            inEscape = true;
+            ++pos;
+            continue;
+        }
+        fail("control character in string at offset " + std::to_string(offset));
+        return end;
+    }
+    return pos;
+}
+
+bool JsonArrayStreamParser::appendEscape(char c, std::string& target) {
+    switch (c) {
+    case '"':
+    case '\\':
+    case '/':
+        target.push_back(c);
+        return true;
+    case 'b':
+        target.push_back('\b');
+        return true;
+    case 'f':
+        target.push_back('\f');
+        return true;
+    case 'n':
+        target.push_back('\n');
+        return true;
+    case 'r':
+        target.push_back('\r');
+        return true;
+    case 't':
+        target.push_back('\t');
+        return true;
+    case 'u':
+        unicodeDigits = 0;
+        unicodeValue = 0;
+        return true;
+    default:
+        fail(std::string("invalid escape '\\") + c + "' at offset " + std::to_string(offset));
+        return false;
+    }
+}
+
+bool JsonArrayStreamParser::emitLiteral() {
+    JsonScalar value;
+    if (scratch == "true" || scratch == "false") {
+        value.type = JsonScalar::Type::Boolean;
+        value.boolean = scratch == "true";
+    } else if (scratch == "null") {
+        value.type = JsonScalar::Type::Null;
+    } else if (isJsonNumber(scratch)) {
+        value.type = JsonScalar::Type::Number;
+        value.text = scratch;
+    } else {
+        fail("invalid literal '" + scratch + "' for \"" + key + "\"");
+        return false;
+    }
+    return emitField(value);
+}
+
+bool JsonArrayStreamParser::emitField(const JsonScalar& value) {
+    if (!onField(key, value)) {
+        fail("field \"" + key + "\" rejected");
+        return false;
+    }
+    return true;
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,345 @@
+#include "KpiColumnStore.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PERFMGMT_KPI_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace PerfMgmt {
+namespace kernels {
+
+namespace {
+// float lanes are flushed into double totals every BLOCK values so the float
+// partial sums stay small and their rounding error stays negligible
+constexpr std::size_t BLOCK = 4096;
+
+std::size_t binOf(float value) {
+    int bin = static_cast<int>(value + 0.5f) - 1;
+    return static_cast<std::size_t>(std::clamp(bin, 0, 9));
+}
+} // namespace
+
+const char* instructionSet() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(PERFMGMT_KPI_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+Moments momentsScalar(const float* values, std::size_t count) {
+    Moments result;
+    result.count = count;
+    result.min = std::numeric_limits<float>::infinity();
+    result.max = -std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < count; ++i) {
+        result.sum += values[i];
+        result.sumOfSquares += static_cast<double>(values[i]) * values[i];
+        result.min = std::min(result.min, values[i]);
+        result.max = std::max(result.max, values[i]);
+    }
+    return result;
+}
+
+void histogramScalar(const float* values, std::size_t count, std::array<std::uint32_t, 10>& bins) {
+    for (std::size_t i = 0; i < count; ++i) {
+        ++bins[binOf(values[i])];
+    }
+}
+
+#if defined(__AVX2__)
+
+Moments moments(const float* values, std::size_t count) {
+    Moments result;
+    result.count = count;
+    __m256 lowest = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256 highest = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    const std::size_t vectorEnd = count - count % 8;
+    std::size_t i = 0;
+    alignas(32) float lanes[8];
+    while (i < vectorEnd) {
+        const std::size_t blockEnd = std::min(vectorEnd, i + BLOCK);
+        __m256 sum = _mm256_setzero_ps();
+        __m256 squares = _mm256_setzero_ps();
+        for (; i < blockEnd; i += 8) {
+            __m256 x = _mm256_loadu_ps(values + i);
+            sum = _mm256_add_ps(sum, x);
+            squares = _mm256_add_ps(squares, _mm256_mul_ps(x, x));
+            lowest = _mm256_min_ps(lowest, x);
+            highest = _mm256_max_ps(highest, x);
+        }
+        _mm256_store_ps(lanes, sum);
+        result.sum += std::accumulate(lanes, lanes + 8, 0.0);
+        _mm256_store_ps(lanes, squares);
+        result.sumOfSquares += std::accumulate(lanes, lanes + 8, 0.0);
+    }
+    _mm256_store_ps(lanes, lowest);
+    result.min = *std::min_element(lanes, lanes + 8);
+    _mm256_store_ps(lanes, highest);
+    result.max = *std::max_element(lanes, lanes + 8);
+
+    Moments tail = momentsScalar(values + vectorEnd, count - vectorEnd);
+    result.sum += tail.sum;
+    result.sumOfSquares += tail.sumOfSquares;
+    result.min = std::min(result.min, tail.min);
+    result.max = std::max(result.max, tail.max);
+    return result;
+}
+
+void histogram(const float* values, std::size_t count, std::array<std::uint32_t, 10>& bins) {
+    // no scatter: every bin keeps 16-bit per-lane counters fed by compare masks (-1 per match),
+    // two rounded vectors are packed into one so each compare covers 16 ratings
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 ten = _mm256_set1_ps(10.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    auto rounded = [&](const float* at) {
+        return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(at), one), ten), half));
+    };
+    const std::size_t vectorEnd = count - count % 16;
+    alignas(32) std::uint16_t lanes[16];
+    std::size_t i = 0;
+    while (i < vectorEnd) {
+        // a 16-bit lane counts at most one match per iteration
+        const std::size_t blockEnd = std::min(vectorEnd, i + 16 * std::size_t{INT16_MAX});
+        __m256i counters[10];
+        for (auto& counter : counters) {
+            counter = _mm256_setzero_si256();
+        }
+        for (; i < blockEnd; i += 16) {
+            __m256i packed = _mm256_packs_epi32(rounded(values + i), rounded(values + i + 8));
+            for (int bin = 0; bin < 10; ++bin) {
+                __m256i match = _mm256_cmpeq_epi16(packed, _mm256_set1_epi16(static_cast<short>(bin + 1)));
+                counters[bin] = _mm256_sub_epi16(counters[bin], match);
+            }
+        }
+        for (std::size_t bin = 0; bin < 10; ++bin) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), counters[bin]);
+            bins[bin] += std::accumulate(lanes, lanes + 16, 0u);
+        }
+    }
+    histogramScalar(values + vectorEnd, count - vectorEnd, bins);
+}
+
+#elif defined(PERFMGMT_KPI_SSE2)
+
+Moments moments(const float* values, std::size_t count) {
+    Moments result;
+    result.count = count;
+    __m128 lowest = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128 highest = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    const std::size_t vectorEnd = count - count % 4;
+    std::size_t i = 0;
+    alignas(16) float lanes[4];
+    while (i < vectorEnd) {
+        const std::size_t blockEnd = std::min(vectorEnd, i + BLOCK);
+        __m128 sum = _mm_setzero_ps();
+        __m128 squares = _mm_setzero_ps();
+        for (; i < blockEnd; i += 4) {
+            __m128 x = _mm_loadu_ps(values + i);
+            sum = _mm_add_ps(sum, x);
+            squares = _mm_add_ps(squares, _mm_mul_ps(x, x));
+            lowest = _mm_min_ps(lowest, x);
+            highest = _mm_max_ps(highest, x);
+        }
+        _mm_store_ps(lanes, sum);
+        result.sum += std::accumulate(lanes, lanes + 4, 0.0);
+        _mm_store_ps(lanes, squares);
+        result.sumOfSquares += std::accumulate(lanes, lanes + 4, 0.0);
+    }
+    _mm_store_ps(lanes, lowest);
+    result.min = *std::min_element(lanes, lanes + 4);
+    _mm_store_ps(lanes, highest);
+    result.max = *std::max_element(lanes, lanes + 4);
+
+    Moments tail = momentsScalar(values + vectorEnd, count - vectorEnd);
+    result.sum += tail.sum;
+    result.sumOfSquares += tail.sumOfSquares;
+    result.min = std::min(result.min, tail.min);
+    result.max = std::max(result.max, tail.max);
+    return result;
+}
+
+void histogram(const float* values, std::size_t count, std::array<std::uint32_t, 10>& bins) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 ten = _mm_set1_ps(10.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    auto rounded = [&](const float* at) {
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(at), one), ten), half));
+    };
+    const std::size_t vectorEnd = count - count % 8;
+    alignas(16) std::uint16_t lanes[8];
+    std::size_t i = 0;
+    while (i < vectorEnd) {
+        const std::size_t blockEnd = std::min(vectorEnd, i + 8 * std::size_t{INT16_MAX});
+        __m128i counters[10];
+        for (auto& counter : counters) {
+            counter = _mm_setzero_si128();
+        }
+        for (; i < blockEnd; i += 8) {
+            __m128i packed = _mm_packs_epi32(rounded(values + i), rounded(values + i + 4));
+            for (int bin = 0; bin < 10; ++bin) {
+                __m128i match = _mm_cmpeq_epi16(packed, _mm_set1_epi16(static_cast<short>(bin + 1)));
+                counters[bin] = _mm_sub_epi16(counters[bin], match);
+            }
+        }
+        for (std::size_t bin = 0; bin < 10; ++bin) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), counters[bin]);
+            bins[bin] += std::accumulate(lanes, lanes + 8, 0u);
+        }
+    }
+    histogramScalar(values + vectorEnd, count - vectorEnd, bins);
+}
+
+#else
+
+Moments moments(const float* values, std::size_t count) {
+    return momentsScalar(values, count);
+}
+
+void histogram(const float* values, std::size_t count, std::array<std::uint32_t, 10>& bins) {
+    histogramScalar(values, count, bins);
+}
+
+#endif
+
+KpiStats toStats(const Moments& moments, const std::array<std::uint32_t, 10>& bins) {
+    KpiStats stats;
+    stats.histogram = bins;
+    stats.count = moments.count;
+    if (moments.count == 0) {
+        return stats;
+    }
+    double mean = moments.sum / moments.count;
+    double variance = std::max(0.0, moments.sumOfSquares / moments.count - mean * mean);
+    stats.mean = static_cast<float>(mean);
+    stats.stddev = static_cast<float>(std::sqrt(variance));
+    stats.min = moments.min;
+    stats.max = moments.max;
+    return stats;
+}
+
+} // namespace kernels
+
+void KpiColumnStore::reserve(std::size_t count) {
+    for (auto& column : columns) {
+        column.reserve(count);
+    }
+    employees.reserve(count);
+    reviewers.reserve(count);
+}
+
+void KpiColumnStore::append(const PerformanceReview& review) {
+    std::array<float, KPI_COUNT> ratings;
+    for (std::size_t kpi = 0; kpi < KPI_COUNT; ++kpi) {
+        ratings[kpi] = kpiValue(review, static_cast<Kpi>(kpi));
+    }
+    append(review.employeeId, review.reviewerId, ratings);
+}
+
+void KpiColumnStore::append(int employeeId, int reviewerId, const std::array<float, KPI_COUNT>& ratings) {
+    for (std::size_t kpi = 0; kpi < KPI_COUNT; ++kpi) {
+        columns[kpi].push_back(ratings[kpi]);
+    }
+    employees.push_back(employeeId);
+    reviewers.push_back(reviewerId);
+    clusters.clear();
+}
+
+void KpiColumnStore::clear() {
+    for (auto& column : columns) {
+        column.clear();
+    }
+    employees.clear();
+    reviewers.clear();
+    clusters.clear();
+}
+
+std::size_t KpiColumnStore::size() const {
+    return employees.size();
+}
+
+const float* KpiColumnStore::column(Kpi kpi) const {
+    return columns[static_cast<std::size_t>(kpi)].data();
+}
+
+const AlignedVector<int>& KpiColumnStore::employeeIds() const {
+    return employees;
+}
+
+const AlignedVector<int>& KpiColumnStore::reviewerIds() const {
+    return reviewers;
+}
+
+KpiStats KpiColumnStore::aggregate(Kpi kpi) const {
+    return aggregate(kpi, 0, size());
+}
+
+KpiStats KpiColumnStore::aggregate(Kpi kpi, std::size_t first, std::size_t last) const {
+    last = std::min(last, size());
+    first = std::min(first, last);
+    const float* values = column(kpi) + first;
+    std::array<std::uint32_t, 10> bins{};
+    kernels::histogram(values, last - first, bins);
+    return kernels::toStats(kernels::moments(values, last - first), bins);
+}
+
+void KpiColumnStore::clusterBy(const std::function<int(int, int)>& keyOf) {
+    const std::size_t count = size();
+    std::vector<int> keys(count);
+    for (std::size_t row = 0; row < count; ++row) {
+        keys[row] = keyOf(employees[row], reviewers[row]);
+    }
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+    auto permute = [&order](auto& column) {
+        std::remove_reference_t<decltype(column)> sorted(column.size());
+        for (std::size_t row = 0; row < order.size(); ++row) {
+            sorted[row] = column[order[row]];
+        }
+        column.swap(sorted);
+    };
+    for (auto& column : columns) {
+        permute(column);
+    }
+    permute(employees);
+    permute(reviewers);
+
+    clusters.clear();
+    for (std::size_t row = 0; row < count; ++row) {
+        int key = keys[order[row]];
+        if (clusters.empty() || clusters.back().key != key) {
+            clusters.push_back({key, row, row});
+        }
+        clusters.back().last = row + 1;
+    }
+}
+
+void KpiColumnStore::clusterByReviewer() {
+    clusterBy([](int, int reviewerId) { return reviewerId; });
+}
+
+const std::vector<KpiColumnStore::Group>& KpiColumnStore::groups() const {
+    return clusters;
+}
+
+std::vector<KpiStats> KpiColumnStore::rollup(Kpi kpi) const {
+    std::vector<KpiStats> result;
+    result.reserve(clusters.size());
+    for (const auto& group : clusters) {
+        result.push_back(aggregate(kpi, group.first, group.last));
+    }
+    return result;
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,245 @@
+#include <Metrics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <vector>
+
+namespace PerfMgmt {
+
+namespace {
+const char* const HTTP_STATUS_CLASSES[] = {"none", "1xx", "2xx", "3xx", "4xx", "5xx"};
+
+bool enabledFromEnvironment() {
+    const char* value = std::getenv("PERFMGMT_METRICS");
+    return value != nullptr && (std::strcmp(value, "1") == 0 || std::strcmp(value, "on") == 0);
+}
+
+// bucket of a duration: number of significant bits of its microseconds
+std::size_t bucketIndex(std::chrono::nanoseconds elapsed) {
+    auto micros = static_cast<std::uint64_t>(std::max<std::int64_t>(0, elapsed.count())) / 1000;
+    std::size_t index = 0;
+    while (micros != 0 && index < LatencyHistogram::BUCKET_COUNT - 1) {
+        micros >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+std::string formatBound(double seconds) {
+    if (std::isinf(seconds)) {
+        return "+Inf";
+    }
+    std::ostringstream out;
+    out << seconds;
+    return out.str();
+}
+} // namespace
+
+std::atomic<bool> Metrics::enabledFlag{enabledFromEnvironment()};
+
+// ---- LatencyHistogram ----
+
+void LatencyHistogram::record(std::chrono::nanoseconds elapsed) {
+    buckets[bucketIndex(elapsed)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sumNanoseconds.fetch_add(static_cast<std::uint64_t>(std::max<std::int64_t>(0, elapsed.count())),
+                             std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    // taken after the buckets so a concurrent record can only make count lag behind them
+    snapshot.count = count.load(std::memory_order_relaxed);
+    snapshot.sumNanoseconds = sumNanoseconds.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sumNanoseconds.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::upperBoundSeconds(std::size_t index) {
+    if (index + 1 >= BUCKET_COUNT) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return static_cast<double>(std::uint64_t{1} << index) * 1e-6;
+}
+
+double LatencyHistogram::Snapshot::quantile(double q) const {
+    std::uint64_t total = 0;
+    for (auto bucket : buckets) {
+        total += bucket;
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+    auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= rank && cumulative > 0) {
+            return upperBoundSeconds(i);
+        }
+    }
+    return upperBoundSeconds(BUCKET_COUNT - 1);
+}
+
+// ---- OperationTimer ----
+
+OperationTimer::OperationTimer(OperationMetrics& operation) :
+    operation(Metrics::enabled() ? &operation : nullptr) {
+    if (this->operation) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+OperationTimer::~OperationTimer() {
+    if (!operation) {
+        return;
+    }
+    operation->latency.record(std::chrono::steady_clock::now() - start);
+    if (failed) {
+        operation->errors.add();
+    }
+}
+
+// ---- Metrics ----
+
+Metrics::Metrics() = default;
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+OperationMetrics& Metrics::operation(const std::string& subsystem, const std::string& name) {
+    std::lock_guard<std::mutex> lock(operationsMutex);
+    auto& slot = operations[{subsystem, name}];
+    if (!slot) {
+        slot = std::make_unique<OperationMetrics>();
+    }
+    return *slot;
+}
+
+void Metrics::recordHttpStatus(int status) {
+    std::size_t index = status >= 100 && status < 600 ? static_cast<std::size_t>(status / 100) : 0;
+    httpResponses[index].add();
+}
+
+std::string Metrics::toPrometheus() const {
+    std::ostringstream out;
+    {
+        std::lock_guard<std::mutex> lock(operationsMutex);
+        out << "# HELP perfmgmt_operation_duration_seconds Latency of database and network operations.\n"
+            << "# TYPE perfmgmt_operation_duration_seconds histogram\n";
+        for (const auto& [key, operation] : operations) {
+            std::string labels = "subsystem=\"" + key.first + "\",operation=\"" + key.second + "\"";
+            auto snapshot = operation->latency.snapshot();
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+                cumulative += snapshot.buckets[i];
+                out << "perfmgmt_operation_duration_seconds_bucket{" << labels << ",le=\""
+                    << formatBound(LatencyHistogram::upperBoundSeconds(i)) << "\"} " << cumulative << '\n';
+            }
+            out << "perfmgmt_operation_duration_seconds_sum{" << labels << "} "
+                << static_cast<double>(snapshot.sumNanoseconds) * 1e-9 << '\n';
+            out << "perfmgmt_operation_duration_seconds_count{" << labels << "} " << cumulative << '\n';
+        }
+        out << "# HELP perfmgmt_operation_errors_total Failed database and network operations.\n"
+            << "# TYPE perfmgmt_operation_errors_total counter\n";
+        for (const auto& [key, operation] : operations) {
+            out << "perfmgmt_operation_errors_total{subsystem=\"" << key.first << "\",operation=\"" << key.second
+                << "\"} " << operation->errors.value() << '\n';
+        }
+    }
+
+    auto counter = [&out](const char* name, const char* help, const Counter& value) {
+        out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << " counter\n"
+            << name << ' ' << value.value() << '\n';
+    };
+    counter("perfmgmt_db_rows_read_total", "Rows returned by database reads.", dbRowsRead);
+    counter("perfmgmt_db_rows_written_total", "Rows inserted, updated or deleted.", dbRowsWritten);
+    counter("perfmgmt_db_busy_errors_total", "Statements failed with SQLITE_BUSY.", dbBusyErrors);
+    counter("perfmgmt_db_busy_retries_total", "Busy handler waits on a locked database.", dbBusyRetries);
+    counter("perfmgmt_http_bytes_sent_total", "Request body bytes sent.", httpBytesSent);
+    counter("perfmgmt_http_bytes_received_total", "Response body bytes received.", httpBytesReceived);
+    counter("perfmgmt_http_retries_total", "Requests repeated after a transient failure.", httpRetries);
+
+    out << "# HELP perfmgmt_http_responses_total HTTP responses by status class, none for transport errors.\n"
+        << "# TYPE perfmgmt_http_responses_total counter\n";
+    for (std::size_t i = 0; i < httpResponses.size(); ++i) {
+        out << "perfmgmt_http_responses_total{class=\"" << HTTP_STATUS_CLASSES[i] << "\"} "
+            << httpResponses[i].value() << '\n';
+    }
+    return out.str();
+}
+
+std::string Metrics::toJson() const {
+    nlohmann::json j;
+    j["enabled"] = enabled();
+    j["operations"] = nlohmann::json::array();
+    {
+        std::lock_guard<std::mutex> lock(operationsMutex);
+        for (const auto& [key, operation] : operations) {
+            auto snapshot = operation->latency.snapshot();
+            std::vector<std::uint64_t> buckets(snapshot.buckets.begin(), snapshot.buckets.end());
+            j["operations"].push_back({{"subsystem", key.first},
+                                       {"operation", key.second},
+                                       {"count", snapshot.count},
+                                       {"errors", operation->errors.value()},
+                                       {"sumSeconds", static_cast<double>(snapshot.sumNanoseconds) * 1e-9},
+                                       {"p50Seconds", snapshot.quantile(0.50)},
+                                       {"p99Seconds", snapshot.quantile(0.99)},
+                                       {"buckets", buckets}});
+        }
+    }
+    j["db"] = {{"rowsRead", dbRowsRead.value()},
+               {"rowsWritten", dbRowsWritten.value()},
+               {"busyErrors", dbBusyErrors.value()},
+               {"busyRetries", dbBusyRetries.value()}};
+    nlohmann::json responses;
+    for (std::size_t i = 0; i < httpResponses.size(); ++i) {
+        responses[HTTP_STATUS_CLASSES[i]] = httpResponses[i].value();
+    }
+    j["http"] = {{"bytesSent", httpBytesSent.value()},
+                 {"bytesReceived", httpBytesReceived.value()},
+                 {"retries", httpRetries.value()},
+                 {"responses", responses}};
+    // +Inf does not exist in JSON, the bounds of the finite buckets are enough to read the array
+    nlohmann::json bounds = nlohmann::json::array();
+    for (std::size_t i = 0; i + 1 < LatencyHistogram::BUCKET_COUNT; ++i) {
+        bounds.push_back(LatencyHistogram::upperBoundSeconds(i));
+    }
+    j["bucketUpperBoundsSeconds"] = bounds;
+    return j.dump();
+}
+
+void Metrics::reset() {
+    {
+        std::lock_guard<std::mutex> lock(operationsMutex);
+        for (auto& [key, operation] : operations) {
+            operation->latency.reset();
+            operation->errors.reset();
+        }
+    }
+    for (Counter* counter : {&dbRowsRead, &dbRowsWritten, &dbBusyErrors, &dbBusyRetries, &httpBytesSent,
+                             &httpBytesReceived, &httpRetries}) {
+        counter->reset();
+    }
+    for (auto& responses : httpResponses) {
+        responses.reset();
+    }
+}
+
+} // namespace PerfMgmt
@@ -1,39 +1,329 @@
+#include <Metrics.hpp>
 #include <NetworkManager.hpp>
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <unordered_map>
 
 using json = nlohmann::json;
 
 namespace PerfMgmt {
-NetworkManager::NetworkManager(const std::string& baseUrl) : httpClient(baseUrl) {
+namespace {
+OperationMetrics& httpOperation(const char* name) {
+    return Metrics::instance().operation("http", name);
 }
+
+// status class and body sizes of a finished request; anything but 2xx counts as a failed call
+void recordExchange(OperationTimer& timer, int status, std::size_t bytesSent, std::size_t bytesReceived) {
+    auto& metrics = Metrics::instance();
+    metrics.recordHttpStatus(status);
+    metrics.httpBytesSent.add(bytesSent);
+    metrics.httpBytesReceived.add(bytesReceived);
+    if (status < 200 || status >= 300) {
+        timer.fail();
+    }
+}
+} // namespace
+
+NetworkManager::NetworkManager(const std::string& baseUrl) : baseUrl(baseUrl), httpClient(baseUrl) {
+    // reuse the TCP connection across calls
+    httpClient.set_keep_alive(true);
+}
+
+bool NetworkManager::isServerReachable() {
+    auto res = makeGetRequest("/health");
+    return res && (*res)->status == 200;
+}
+
 std::optional<std::vector<Employee>> NetworkManager::fetchAllEmployees() {
+    return fetchRows<Employee>("/api/employees", "fetchAllEmployees");
+}
 
-    std::string body;
-    std::vector<Employee> resutlVec;
-    auto res = httpClient.Get("/api/employees", [&](const char* data, size_t data_length) {
-        body.append(data, data_length);
-        return true;
-    });
+std::optional<Employee> NetworkManager::fetchSingleEmployee(int employeeId) {
+    auto res = makeGetRequest("/api/employees/" + std::to_string(employeeId));
+    if (!res || (*res)->status != 200) {
+        return std::nullopt;
+    }
+    try {
+        return parseEmployeeJson(json::parse((*res)->body));
+    } catch (const std::exception& e) {
+        std::cerr << "[fetchSingleEmployee] : " << e.what() << '\n';
+        return std::nullopt;
+    }
+}
 
+std::optional<std::vector<std::optional<Employee>>>
+NetworkManager::fetchEmployees(const std::vector<int>& employeeIds) {
+    return fetchByIds<Employee>("/api/employees?ids=", employeeIds, "fetchEmployees",
+                                [](const Employee& employee) { return employee.employeeId; });
+}
+
+std::optional<int> NetworkManager::sendNewEmployee(const Employee& employee) {
+    auto res = makePostRequest("/api/employees", json(employee).dump(), "application/json");
+    if (!res || (*res)->status != 201) {
+        return std::nullopt;
+    }
     try {
-        json j = json::parse(body);
-        // std::cout << std::setw(4) << j << "\n\n";
-        for (const auto& jsonItem : j) {
-            // resutlVec.emplace_back(Employee(static_cast<int>(jsonItem["id"]), 2025121, std::string(jsonItem["name"]),
-            //                                 std::string(jsonItem["hireDate"]),
-            //                                 stringToRole(std::string(jsonItem["role"])).value(),
-            //                                 jsonItem["isActive"], std::nullopt));
-            Employee empTemp;
-            from_json(jsonItem, empTemp);
-            resutlVec.emplace_back(empTemp);
-        }
+        return json::parse((*res)->body).at("employeeId").get<int>();
+    } catch (const std::exception& e) {
+        std::cerr << "[sendNewEmployee] : " << e.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+bool NetworkManager::sendUpdatedEmployee(int serverEmployeeId, const Employee& employee) {
+    auto res = makePutRequest("/api/employees/" + std::to_string(serverEmployeeId), json(employee).dump(),
+                              "application/json");
+    return res && (*res)->status == 200;
+}
+
+std::optional<ChangeSet<Employee>> NetworkManager::fetchEmployeesSince(std::int64_t since) {
+    ChangeSet<Employee> changes;
+    changes.watermark = since;
+    auto rows = fetchRows<Employee>("/api/employees?since=" + std::to_string(since), "fetchEmployeesSince",
+                                    versionTracker(changes.watermark));
+    if (!rows) {
+        return std::nullopt;
+    }
+    changes.rows = std::move(*rows);
+    return changes;
+}
+
+std::optional<std::vector<PerformanceReview>> NetworkManager::fetchReviewsForEmployee(int serverEmployeeId) {
+    return fetchRows<PerformanceReview>("/api/reviews?employeeId=" + std::to_string(serverEmployeeId),
+                                        "fetchReviewsForEmployee");
+}
+
+std::optional<std::vector<std::optional<PerformanceReview>>>
+NetworkManager::fetchLatestReviewsForEmployees(const std::vector<int>& serverEmployeeIds) {
+    return fetchByIds<PerformanceReview>("/api/reviews?latestFor=", serverEmployeeIds,
+                                         "fetchLatestReviewsForEmployees",
+                                         [](const PerformanceReview& review) { return review.employeeId; });
+}
+
+std::optional<int> NetworkManager::sendNewReview(int serverEmployeeId, const PerformanceReview& review) {
+    json body = review;
+    body["employeeId"] = serverEmployeeId;
+    auto res = makePostRequest("/api/reviews", body.dump(), "application/json");
+    if (!res || (*res)->status != 201) {
+        return std::nullopt;
+    }
+    try {
+        return json::parse((*res)->body).at("reviewId").get<int>();
+    } catch (const std::exception& e) {
+        std::cerr << "[sendNewReview] : " << e.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+bool NetworkManager::updateReview(int serverReviewId, const PerformanceReview& review) {
+    auto res = makePutRequest("/api/reviews/" + std::to_string(serverReviewId), json(review).dump(),
+                              "application/json");
+    return res && (*res)->status == 200;
+}
+
+std::optional<ChangeSet<PerformanceReview>> NetworkManager::fetchReviewsSince(std::int64_t since) {
+    ChangeSet<PerformanceReview> changes;
+    changes.watermark = since;
+    auto rows = fetchRows<PerformanceReview>("/api/reviews?since=" + std::to_string(since), "fetchReviewsSince",
+                                             versionTracker(changes.watermark));
+    if (!rows) {
+        return std::nullopt;
+    }
+    changes.rows = std::move(*rows);
+    return changes;
+}
+
+void NetworkManager::setWireFormat(WireFormat format) {
+    listFormat = format;
+}
+
+WireFormat NetworkManager::wireFormat() const {
+    return listFormat;
+}
+
+bool NetworkManager::setCompression(bool enabled) {
+    compression = enabled && HTTP_COMPRESSION_AVAILABLE;
+    return compression;
+}
+
+int NetworkManager::lastStatusCode() const {
+    return lastStatus;
+}
+
+bool NetworkManager::lastRequestUnsent() const {
+    // Error::Connection is only raised while connecting, before a byte of the request is written
+    return lastStatus == 0 && lastError == httplib::Error::Connection;
+}
+
+std::optional<Employee> NetworkManager::parseEmployeeJson(const json& jEmp) {
+    try {
+        Employee employee;
+        from_json(jEmp, employee);
+        return employee;
     } catch (const std::exception& e) {
-        std::cerr << "[fetchAllEmployees] :" << e.what() << '\n';
+        std::cerr << "[parseEmployeeJson] : " << e.what() << '\n';
         return std::nullopt;
     }
-    for (const auto& item : resutlVec) {
-        std::cout << item << "\n\n";
+}
+
+std::optional<PerformanceReview> NetworkManager::parsePerformanceReview(const json& jPerf) {
+    try {
+        PerformanceReview review;
+        from_json(jPerf, review);
+        return review;
+    } catch (const std::exception& e) {
+        std::cerr << "[parsePerformanceReview] : " << e.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+template <typename Row>
+std::optional<std::vector<Row>>
+NetworkManager::fetchRows(const std::string& path, const char* tag,
+                          std::function<void(std::string_view, const JsonScalar&)> extra) {
+    OperationTimer timer(httpOperation(tag));
+    std::vector<Row> rows;
+    // JSON rows are decoded while the chunks arrive, the body is never buffered
+    JsonRowDecoder<Row> decoder(rows, extra);
+    // set up once the headers show a binary answer
+    std::optional<BinaryRowDecoder<Row>> binaryDecoder;
+    // body bytes after httplib undid any gzip, i.e. what was decoded rather than what was on the wire
+    std::size_t received = 0;
+    auto res = httpClient.Get(
+        path, requestHeaders(true),
+        [&binaryDecoder, &rows, &extra](const httplib::Response& response) {
+            auto format = wireFormatOf(response.get_header_value("Content-Type"));
+            if (format && *format != WireFormat::JSON) {
+                binaryDecoder.emplace(rows, *format, extra);
+            }
+            return true;
+        },
+        [&decoder, &binaryDecoder, &received](const char* data, size_t data_length) {
+            received += data_length;
+            return binaryDecoder ? binaryDecoder->feed(data, data_length) : decoder.feed(data, data_length);
+        });
+    lastStatus = res ? res->status : 0;
+    lastError = res.error();
+    recordExchange(timer, lastStatus, 0, received);
+    auto decoded = [&](auto& activeDecoder) -> std::optional<std::vector<Row>> {
+        if (activeDecoder.failed()) {
+            timer.fail();
+            std::cerr << "[" << tag << "] : " << activeDecoder.error() << '\n';
+            return std::nullopt;
+        }
+        if (!res) {
+            std::cerr << "[" << tag << "] : " << path << " : " << httplib::to_string(res.error()) << '\n';
+            return std::nullopt;
+        }
+        if (res->status != 200) {
+            return std::nullopt;
+        }
+        if (!activeDecoder.finish()) {
+            std::cerr << "[" << tag << "] : " << activeDecoder.error() << '\n';
+            timer.fail();
+            return std::nullopt;
+        }
+        return std::move(rows);
+    };
+    return binaryDecoder ? decoded(*binaryDecoder) : decoded(decoder);
+}
+
+template <typename Row, typename KeyOf>
+std::optional<std::vector<std::optional<Row>>>
+NetworkManager::fetchByIds(const std::string& query, const std::vector<int>& ids, const char* tag, KeyOf keyOf) {
+    // the server only takes positive ids; any other id just stays unanswered
+    std::vector<int> requested;
+    std::copy_if(ids.begin(), ids.end(), std::back_inserter(requested), [](int id) { return id > 0; });
+    std::unordered_map<int, Row> found;
+    for (std::size_t first = 0; first < requested.size(); first += MULTI_FETCH_IDS) {
+        std::string path = query;
+        for (std::size_t i = first; i < std::min(requested.size(), first + MULTI_FETCH_IDS); ++i) {
+            path += (i == first ? "" : ",") + std::to_string(requested[i]);
+        }
+        auto rows = fetchRows<Row>(path, tag);
+        if (!rows) {
+            return std::nullopt;
+        }
+        for (Row& row : *rows) {
+            int key = keyOf(row);
+            found.emplace(key, std::move(row));
+        }
+    }
+    std::vector<std::optional<Row>> result(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto it = found.find(ids[i]);
+        if (it != found.end()) {
+            result[i] = it->second;
+        }
+    }
+    return result;
+}
+
+std::function<void(std::string_view, const JsonScalar&)> NetworkManager::versionTracker(std::int64_t& watermark) {
+    return [&watermark](std::string_view key, const JsonScalar& value) {
+        if (key == "version") {
+            watermark = std::max(watermark, value.asInt64().value_or(watermark));
+        }
+    };
+}
+
+httplib::Headers NetworkManager::requestHeaders(bool rowList) const {
+    // set explicitly, httplib would otherwise pick its own list whenever it was built with zlib
+    httplib::Headers headers{{"Accept-Encoding", compression ? "gzip" : "identity"}};
+    if (rowList && listFormat != WireFormat::JSON) {
+        headers.emplace("Accept", std::string(mediaType(listFormat)) + ", application/json;q=0.5");
+    }
+    return headers;
+}
+
+std::optional<httplib::Result> NetworkManager::makeGetRequest(const std::string& path) {
+    static auto& metrics = httpOperation("GET");
+    OperationTimer timer(metrics);
+    auto res = httpClient.Get(path, requestHeaders(false));
+    lastError = res.error();
+    if (!res) {
+        lastStatus = 0;
+        recordExchange(timer, 0, 0, 0);
+        std::cerr << "[makeGetRequest] : " << path << " : " << httplib::to_string(res.error()) << '\n';
+        return std::nullopt;
+    }
+    lastStatus = res->status;
+    recordExchange(timer, lastStatus, 0, res->body.size());
+    return res;
+}
+
+std::optional<httplib::Result> NetworkManager::makePostRequest(const std::string& path, const std::string& body,
+                                                               const std::string& conentType) {
+    static auto& metrics = httpOperation("POST");
+    OperationTimer timer(metrics);
+    auto res = httpClient.Post(path, body, conentType);
+    lastError = res.error();
+    if (!res) {
+        lastStatus = 0;
+        recordExchange(timer, 0, 0, 0);
+        std::cerr << "[makePostRequest] : " << path << " : " << httplib::to_string(res.error()) << '\n';
+        return std::nullopt;
+    }
+    lastStatus = res->status;
+    recordExchange(timer, lastStatus, body.size(), res->body.size());
+    return res;
+}
+
+std::optional<httplib::Result> NetworkManager::makePutRequest(const std::string& path, const std::string& body,
+                                                              const std::string& contentType) {
+    static auto& metrics = httpOperation("PUT");
+    OperationTimer timer(metrics);
+    auto res = httpClient.Put(path, body, contentType);
+    lastError = res.error();
+    if (!res) {
+        lastStatus = 0;
+        recordExchange(timer, 0, 0, 0);
+        std::cerr << "[makePutRequest] : " << path << " : " << httplib::to_string(res.error()) << '\n';
+        return std::nullopt;
     }
-    return resutlVec;
+    lastStatus = res->status;
+    recordExchange(timer, lastStatus, body.size(), res->body.size());
+    return res;
 }
-} // namespace PerfMgmt
\ No newline at end of file
+} // namespace PerfMgmt
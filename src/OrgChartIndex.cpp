@@ -0,0 +1,293 @@
+#include "OrgChartIndex.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <utility>
+
+namespace PerfMgmt {
+
+namespace {
+// below this many ids std::sort beats the bucket passes
+constexpr std::size_t RADIX_SORT_MIN = 4096;
+constexpr int RADIX_BITS = 11;
+constexpr std::uint32_t RADIX_BUCKETS = 1u << RADIX_BITS;
+
+// LSD radix sort of employee ids in three passes of 11 bits, which keeps the rebuild linear in headcount
+void sortIds(std::vector<int>& ids) {
+    if (ids.size() < RADIX_SORT_MIN) {
+        std::sort(ids.begin(), ids.end());
+        return;
+    }
+    // flipping the sign bit orders negative ids before positive ones as unsigned keys
+    auto key = [](int id) { return static_cast<std::uint32_t>(id) ^ 0x80000000u; };
+    std::vector<int> buffer(ids.size());
+    std::vector<std::size_t> offsets(RADIX_BUCKETS);
+    for (int shift = 0; shift < 32; shift += RADIX_BITS) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (int id : ids) {
+            ++offsets[(key(id) >> shift) & (RADIX_BUCKETS - 1)];
+        }
+        std::size_t total = 0;
+        for (auto& offset : offsets) {
+            std::size_t bucketSize = offset;
+            offset = total;
+            total += bucketSize;
+        }
+        for (int id : ids) {
+            buffer[offsets[(key(id) >> shift) & (RADIX_BUCKETS - 1)]++] = id;
+        }
+        ids.swap(buffer);
+    }
+}
+} // namespace
+
+void OrgChartIndex::upsert(int employeeId, std::optional<int> reportsTo, bool isActive) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto [it, inserted] = nodes.try_emplace(employeeId);
+    if (inserted || it->second.reportsTo != reportsTo) {
+        dirty = true;
+        ++layoutGeneration;
+    }
+    it->second.reportsTo = reportsTo;
+    it->second.isActive = isActive;
+    if (!dirty) {
+        activeFlags[slots.at(employeeId)] = isActive;
+    }
+}
+
+void OrgChartIndex::setActive(int employeeId, bool isActive) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = nodes.find(employeeId);
+    if (it == nodes.end()) {
+        return;
+    }
+    it->second.isActive = isActive;
+    if (!dirty) {
+        activeFlags[slots.at(employeeId)] = isActive;
+    }
+}
+
+void OrgChartIndex::erase(int employeeId) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (nodes.erase(employeeId) != 0) {
+        dirty = true;
+        ++layoutGeneration;
+    }
+}
+
+void OrgChartIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    nodes.clear();
+    dirty = true;
+    ++layoutGeneration;
+}
+
+bool OrgChartIndex::contains(int employeeId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return nodes.count(employeeId) != 0;
+}
+
+std::optional<bool> OrgChartIndex::isActive(int employeeId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = nodes.find(employeeId);
+    if (it == nodes.end()) {
+        return std::nullopt;
+    }
+    return it->second.isActive;
+}
+
+std::vector<int> OrgChartIndex::directReports(int employeeId) const {
+    auto lock = readLock();
+    std::vector<int> result;
+    if (auto slot = slotOf(employeeId)) {
+        result.reserve(childBegin[*slot + 1] - childBegin[*slot]);
+        for (auto i = childBegin[*slot]; i < childBegin[*slot + 1]; ++i) {
+            result.push_back(ids[children[i]]);
+        }
+    }
+    return result;
+}
+
+std::vector<int> OrgChartIndex::subtree(int employeeId, bool activeOnly) const {
+    auto lock = readLock();
+    std::vector<int> result;
+    if (auto slot = slotOf(employeeId)) {
+        auto first = enter[*slot] + 1;
+        auto last = enter[*slot] + sizes[*slot];
+        result.reserve(last - first);
+        for (auto position = first; position < last; ++position) {
+            auto member = preorder[position];
+            if (!activeOnly || activeFlags[member]) {
+                result.push_back(ids[member]);
+            }
+        }
+    }
+    return result;
+}
+
+std::size_t OrgChartIndex::subtreeSize(int employeeId) const {
+    auto lock = readLock();
+    auto slot = slotOf(employeeId);
+    return slot ? sizes[*slot] - 1 : 0;
+}
+
+std::vector<int> OrgChartIndex::chainToRoot(int employeeId) const {
+    auto lock = readLock();
+    std::vector<int> result;
+    if (auto slot = slotOf(employeeId)) {
+        result.reserve(depths[*slot] + 1);
+        for (std::int32_t current = static_cast<std::int32_t>(*slot); current >= 0; current = parents[current]) {
+            result.push_back(ids[current]);
+        }
+    }
+    return result;
+}
+
+std::optional<std::size_t> OrgChartIndex::depth(int employeeId) const {
+    auto lock = readLock();
+    if (auto slot = slotOf(employeeId)) {
+        return depths[*slot];
+    }
+    return std::nullopt;
+}
+
+bool OrgChartIndex::reportsTransitivelyTo(int employeeId, int managerId) const {
+    auto lock = readLock();
+    auto employee = slotOf(employeeId);
+    auto manager = slotOf(managerId);
+    if (!employee || !manager) {
+        return false;
+    }
+    return enter[*manager] < enter[*employee] && enter[*employee] < enter[*manager] + sizes[*manager];
+}
+
+std::size_t OrgChartIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return nodes.size();
+}
+
+std::uint64_t OrgChartIndex::generation() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return layoutGeneration;
+}
+
+std::shared_lock<std::shared_mutex> OrgChartIndex::readLock() const {
+    while (true) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (!dirty) {
+                return lock;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (dirty) {
+            flatten();
+            dirty = false;
+        }
+    }
+}
+
+std::optional<std::uint32_t> OrgChartIndex::slotOf(int employeeId) const {
+    auto it = slots.find(employeeId);
+    if (it == slots.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void OrgChartIndex::flatten() const {
+    const auto count = static_cast<std::uint32_t>(nodes.size());
+
+    // slots in id order, so children end up sorted by id
+    ids.clear();
+    ids.reserve(count);
+    for (const auto& entry : nodes) {
+        ids.push_back(entry.first);
+    }
+    sortIds(ids);
+    slots.clear();
+    slots.reserve(count);
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        slots.emplace(ids[slot], slot);
+    }
+
+    parents.assign(count, -1);
+    activeFlags.assign(count, 1);
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        const Node& node = nodes.at(ids[slot]);
+        activeFlags[slot] = node.isActive;
+        if (node.reportsTo && *node.reportsTo != ids[slot]) {
+            if (auto parent = slotOf(*node.reportsTo)) {
+                parents[slot] = static_cast<std::int32_t>(*parent);
+            }
+        }
+    }
+
+    // CSR adjacency: counting sort of the slots by parent
+    childBegin.assign(count + 1, 0);
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        if (parents[slot] >= 0) {
+            ++childBegin[parents[slot] + 1];
+        }
+    }
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        childBegin[slot + 1] += childBegin[slot];
+    }
+    children.resize(childBegin[count]);
+    std::vector<std::uint32_t> fill(childBegin.begin(), childBegin.end() - 1);
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        if (parents[slot] >= 0) {
+            children[fill[parents[slot]]++] = slot;
+        }
+    }
+
+    // iterative preorder walk from every root
+    enter.assign(count, 0);
+    sizes.assign(count, 0);
+    depths.assign(count, 0);
+    preorder.clear();
+    preorder.reserve(count);
+    std::vector<char> visited(count, 0);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack; // slot, next child offset
+
+    auto walk = [&](std::uint32_t root) {
+        visited[root] = 1;
+        enter[root] = static_cast<std::uint32_t>(preorder.size());
+        preorder.push_back(root);
+        stack.emplace_back(root, childBegin[root]);
+        while (!stack.empty()) {
+            auto& [slot, next] = stack.back();
+            if (next == childBegin[slot + 1]) {
+                sizes[slot] = static_cast<std::uint32_t>(preorder.size()) - enter[slot];
+                stack.pop_back();
+                continue;
+            }
+            auto child = children[next++];
+            if (visited[child]) {
+                continue;
+            }
+            visited[child] = 1;
+            depths[child] = depths[slot] + 1;
+            enter[child] = static_cast<std::uint32_t>(preorder.size());
+            preorder.push_back(child);
+            stack.emplace_back(child, childBegin[child]);
+        }
+    };
+
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        if (parents[slot] < 0) {
+            walk(slot);
+        }
+    }
+    // whatever is left sits on a reporting cycle, cut it open at its lowest id
+    for (std::uint32_t slot = 0; slot < count; ++slot) {
+        if (!visited[slot]) {
+            std::cerr << "[OrgChartIndex] : " << "reporting cycle through employee " << ids[slot] << std::endl;
+            parents[slot] = -1;
+            walk(slot);
+        }
+    }
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,452 @@
+#include <Metrics.hpp>
+#include <RestServer.hpp>
+#include <charconv>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace PerfMgmt {
+
+namespace {
+
+const char* const JSON_TYPE = "application/json";
+// sorts after every ISO date and timestamp, the open upper end of an unbounded review list
+const char* const END_OF_DATES = "9999-99-99";
+// ids one multi-get request may ask for, which keeps its URL well under common request line limits
+constexpr std::size_t MAX_MULTI_GET_IDS = 500;
+
+void sendError(httplib::Response& res, int status, const std::string& message) {
+    res.status = status;
+    res.set_content(json{{"error", message}}.dump(), JSON_TYPE);
+}
+
+void sendJson(httplib::Response& res, int status, const json& body) {
+    res.status = status;
+    res.set_content(body.dump(), JSON_TYPE);
+}
+
+// a positive id spelled with nothing but digits
+std::optional<int> parseId(const std::string& text) {
+    int value{0};
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size() || value <= 0) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// "1,2,3" as ids, nullopt if one of them is not a positive id or there are more than MAX_MULTI_GET_IDS
+std::optional<std::vector<int>> parseIdList(const std::string& text) {
+    std::vector<int> ids;
+    for (std::size_t start = 0; start <= text.size();) {
+        std::size_t end = std::min(text.find(',', start), text.size());
+        auto id = parseId(text.substr(start, end - start));
+        if (!id || ids.size() == MAX_MULTI_GET_IDS) {
+            return std::nullopt;
+        }
+        ids.push_back(*id);
+        start = end + 1;
+    }
+    return ids;
+}
+
+// incremental pulls need a change clock this server does not keep; answered before anything is read, so a
+// sync client fails loudly instead of taking the full list for its changes
+bool rejectSince(const httplib::Request& req, httplib::Response& res) {
+    if (!req.has_param("since")) {
+        return false;
+    }
+    sendError(res, 400, "since is not supported, this server keeps no change versions");
+    return true;
+}
+
+// the rows a multi-get found, in request order; missing ids are left out
+template <typename Row>
+void sendFound(httplib::Response& res, const std::vector<std::optional<Row>>& rows) {
+    json found = json::array();
+    for (const auto& row : rows) {
+        if (row) {
+            found.push_back(*row);
+        }
+    }
+    sendJson(res, 200, found);
+}
+
+std::optional<int> pathId(const httplib::Request& req) {
+    auto it = req.path_params.find("id");
+    return it == req.path_params.end() ? std::nullopt : parseId(it->second);
+}
+
+// the request body as a Model, or nullopt after answering 400. idKey, when given, is set to id first: the id
+// comes from the path, or is assigned by the server, and may be left out of the body
+template <typename Model>
+std::optional<Model> parseBody(const httplib::Request& req, httplib::Response& res, const char* idKey = nullptr,
+                               int id = 0) {
+    json body = json::parse(req.body, nullptr, false);
+    if (body.is_discarded() || !body.is_object()) {
+        sendError(res, 400, "Request must be a JSON object");
+        return std::nullopt;
+    }
+    if (idKey) {
+        body[idKey] = id;
+    }
+    try {
+        return body.get<Model>();
+    } catch (const json::exception& e) {
+        sendError(res, 400, e.what());
+        return std::nullopt;
+    }
+}
+
+// Rows of a Source as one chunked JSON array of up to chunkRows rows per chunk. Rows are only pulled when
+// httplib asks for the next chunk, and the source (with whatever connection it holds) lives until the
+// response is finished or the client went away. A source failing after the status line went out aborts the
+// stream, so the client sees a truncated array instead of a silently short one.
+//
+// Source: bool next(std::string& out) appends one row's JSON and returns false at the end; bool ok() const.
+template <typename Source>
+void streamJsonArray(httplib::Response& res, std::size_t chunkRows, Source source) {
+    struct Stream {
+        Source source;
+        bool opened{false};
+        bool hasRows{false};
+    };
+    auto stream = std::make_shared<Stream>(Stream{std::move(source)});
+    res.set_chunked_content_provider(JSON_TYPE, [stream, chunkRows](std::size_t, httplib::DataSink& sink) {
+        std::string chunk;
+        if (!stream->opened) {
+            chunk.push_back('[');
+            stream->opened = true;
+        }
+        bool finished = false;
+        for (std::size_t rows = 0; rows < chunkRows && !finished; ++rows) {
+            std::size_t mark = chunk.size();
+            if (stream->hasRows) {
+                chunk.push_back(',');
+            }
+            if (stream->source.next(chunk)) {
+                stream->hasRows = true;
+            } else {
+                chunk.resize(mark);
+                finished = true;
+            }
+        }
+        if (finished) {
+            if (!stream->source.ok()) {
+                return false;
+            }
+            chunk.push_back(']');
+        }
+        if (!sink.write(chunk.data(), chunk.size())) {
+            return false;
+        }
+        if (finished) {
+            sink.done();
+        }
+        return true;
+    });
+}
+
+struct EmployeeSource {
+    bool next(std::string& out) {
+        if (!cursor.next()) {
+            return false;
+        }
+        out += json(cursor.current()).dump();
+        return true;
+    }
+    bool ok() const { return cursor.ok(); }
+
+    EmployeeCursor cursor;
+};
+
+// a review list read one keyset page at a time; no connection is held between pages
+struct ReviewSource {
+    using FetchPage = std::function<std::optional<ReviewPage>(const std::optional<ReviewCursor>& after)>;
+
+    bool next(std::string& out) {
+        while (index == page.reviews.size()) {
+            if (exhausted) {
+                return false;
+            }
+            auto nextPage = fetch(after);
+            if (!nextPage) {
+                failed = true;
+                return false;
+            }
+            page = std::move(*nextPage);
+            index = 0;
+            after = page.next;
+            exhausted = !after;
+        }
+        out += json(page.reviews[index++]).dump();
+        return true;
+    }
+    bool ok() const { return !failed; }
+
+    FetchPage fetch;
+    ReviewPage page{};
+    std::size_t index{0};
+    std::optional<ReviewCursor> after{};
+    bool exhausted{false};
+    bool failed{false};
+};
+
+// 201 / 200 with the stored review, or the status a failed write-behind submission maps to
+void sendWriteResult(httplib::Response& res, const WriteResult& result, PerformanceReview review, int status) {
+    switch (result.status) {
+    case WriteStatus::COMMITTED:
+        review.reviewId = result.reviewId;
+        sendJson(res, status, review);
+        break;
+    case WriteStatus::QUEUE_FULL:
+        res.set_header("Retry-After", "1");
+        sendError(res, 503, "Write queue is full, retry later");
+        break;
+    case WriteStatus::FAILED:
+        sendError(res, 400, "Review could not be stored");
+        break;
+    }
+}
+
+} // namespace
+
+RestServer::RestServer(DatabaseManager& db, const RestServerConfig& config) : db(db), config(config) {
+    std::size_t workers = std::max<std::size_t>(1, config.workerCount);
+    server.new_task_queue = [workers] { return new httplib::ThreadPool(workers); };
+    server.set_keep_alive_max_count(config.keepAliveMaxCount);
+    server.set_keep_alive_timeout(config.keepAliveTimeout);
+    this->config.chunkRows = std::max<std::size_t>(1, config.chunkRows);
+    registerRoutes();
+}
+
+bool RestServer::bind() {
+    if (config.port == 0) {
+        boundPort = server.bind_to_any_port(config.host);
+        return boundPort > 0;
+    }
+    if (!server.bind_to_port(config.host, config.port)) {
+        std::cerr << "[RestServer::bind] : " << "cannot bind " << config.host << ":" << config.port << std::endl;
+        return false;
+    }
+    boundPort = config.port;
+    return true;
+}
+
+bool RestServer::listen() {
+    if (boundPort == 0 && !bind()) {
+        return false;
+    }
+    return server.listen_after_bind();
+}
+
+void RestServer::stop() {
+    server.stop();
+}
+
+void RestServer::waitUntilReady() const {
+    server.wait_until_ready();
+}
+
+int RestServer::port() const {
+    return boundPort;
+}
+
+void RestServer::registerRoutes() {
+    server.Get("/health", [](const httplib::Request&, httplib::Response& res) {
+        sendJson(res, 200, json{{"status", "OK"}, {"message", "Server is running"}});
+    });
+    server.Get("/metrics", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(Metrics::instance().toPrometheus(), "text/plain; version=0.0.4");
+    });
+
+    server.Get("/api/employees", [this](const httplib::Request& req, httplib::Response& res) {
+        listEmployees(req, res);
+    });
+    server.Get("/api/employees/:id", [this](const httplib::Request& req, httplib::Response& res) {
+        getEmployee(req, res);
+    });
+    server.Post("/api/employees", [this](const httplib::Request& req, httplib::Response& res) {
+        postEmployee(req, res);
+    });
+    server.Put("/api/employees/:id", [this](const httplib::Request& req, httplib::Response& res) {
+        putEmployee(req, res);
+    });
+
+    server.Get("/api/reviews", [this](const httplib::Request& req, httplib::Response& res) {
+        listReviews(req, res);
+    });
+    server.Get("/api/reviews/:id", [this](const httplib::Request& req, httplib::Response& res) {
+        getReview(req, res);
+    });
+    server.Post("/api/reviews", [this](const httplib::Request& req, httplib::Response& res) {
+        postReview(req, res);
+    });
+    server.Put("/api/reviews/:id", [this](const httplib::Request& req, httplib::Response& res) {
+        putReview(req, res);
+    });
+}
+
+void RestServer::getEmployee(const httplib::Request& req, httplib::Response& res) {
+    auto id = pathId(req);
+    if (!id) {
+        sendError(res, 400, "Invalid employee id");
+        return;
+    }
+    auto employee = db.getEmployee(*id);
+    if (!employee) {
+        sendError(res, 404, "Employee not found");
+        return;
+    }
+    sendJson(res, 200, *employee);
+}
+
+void RestServer::listEmployees(const httplib::Request& req, httplib::Response& res) {
+    if (rejectSince(req, res)) {
+        return;
+    }
+    if (req.has_param("ids")) {
+        auto ids = parseIdList(req.get_param_value("ids"));
+        if (!ids) {
+            sendError(res, 400, "ids must be up to " + std::to_string(MAX_MULTI_GET_IDS) + " comma separated ids");
+            return;
+        }
+        auto employees = db.getEmployees(*ids);
+        if (!employees) {
+            sendError(res, 500, "Employees could not be read");
+            return;
+        }
+        sendFound(res, *employees);
+        return;
+    }
+    streamJsonArray(res, config.chunkRows, EmployeeSource{db.streamAllEmployees()});
+}
+
+void RestServer::postEmployee(const httplib::Request& req, httplib::Response& res) {
+    auto employee = parseBody<Employee>(req, res);
+    if (!employee) {
+        return;
+    }
+    if (employee->employeeId <= 0) {
+        sendError(res, 400, "employeeId must be positive");
+        return;
+    }
+    if (!db.addEmployee(*employee)) {
+        sendError(res, 409, "Employee could not be added");
+        return;
+    }
+    sendJson(res, 201, *employee);
+}
+
+void RestServer::putEmployee(const httplib::Request& req, httplib::Response& res) {
+    auto id = pathId(req);
+    if (!id) {
+        sendError(res, 400, "Invalid employee id");
+        return;
+    }
+    auto employee = parseBody<Employee>(req, res, "employeeId", *id);
+    if (!employee) {
+        return;
+    }
+    if (!db.getEmployee(*id)) {
+        sendError(res, 404, "Employee not found");
+        return;
+    }
+    if (!db.updateEmployee(*employee)) {
+        sendError(res, 400, "Employee could not be stored");
+        return;
+    }
+    sendJson(res, 200, *employee);
+}
+
+void RestServer::getReview(const httplib::Request& req, httplib::Response& res) {
+    auto id = pathId(req);
+    if (!id) {
+        sendError(res, 400, "Invalid review id");
+        return;
+    }
+    auto review = db.getPerformanceReview(*id);
+    if (!review) {
+        sendError(res, 404, "Review not found");
+        return;
+    }
+    sendJson(res, 200, *review);
+}
+
+void RestServer::listReviews(const httplib::Request& req, httplib::Response& res) {
+    if (rejectSince(req, res)) {
+        return;
+    }
+    if (req.has_param("latestFor")) {
+        auto ids = parseIdList(req.get_param_value("latestFor"));
+        if (!ids) {
+            sendError(res, 400,
+                      "latestFor must be up to " + std::to_string(MAX_MULTI_GET_IDS) + " comma separated ids");
+            return;
+        }
+        auto reviews = db.getLatestReviewsForEmployees(*ids);
+        if (!reviews) {
+            sendError(res, 500, "Reviews could not be read");
+            return;
+        }
+        sendFound(res, *reviews);
+        return;
+    }
+    std::size_t pageSize = config.chunkRows;
+    ReviewSource::FetchPage fetch;
+    if (req.has_param("employeeId") || req.has_param("reviewerId")) {
+        bool byEmployee = req.has_param("employeeId");
+        auto id = parseId(req.get_param_value(byEmployee ? "employeeId" : "reviewerId"));
+        if (!id) {
+            sendError(res, 400, byEmployee ? "Invalid employeeId" : "Invalid reviewerId");
+            return;
+        }
+        fetch = [this, byEmployee, id = *id, pageSize](const std::optional<ReviewCursor>& after) {
+            return byEmployee ? db.getReviewsForEmployee(id, after, pageSize)
+                              : db.getReviewsByReviewer(id, after, pageSize);
+        };
+    } else {
+        // no filter: every review, as the date range from the beginning to the end of time
+        std::string from = req.has_param("from") ? req.get_param_value("from") : "";
+        std::string to = req.has_param("to") ? req.get_param_value("to") : END_OF_DATES;
+        fetch = [this, from, to, pageSize](const std::optional<ReviewCursor>& after) {
+            return db.getReviewsInDateRange(from, to, after, pageSize);
+        };
+    }
+    streamJsonArray(res, config.chunkRows, ReviewSource{std::move(fetch)});
+}
+
+void RestServer::postReview(const httplib::Request& req, httplib::Response& res) {
+    // the server assigns review ids, like the mock
+    auto review = parseBody<PerformanceReview>(req, res, "reviewId", 0);
+    if (!review) {
+        return;
+    }
+    if (review->employeeId <= 0 || review->reviewerId <= 0) {
+        sendError(res, 400, "Missing required fields (employeeId, reviewerId)");
+        return;
+    }
+    sendWriteResult(res, db.submitPerformanceReview(*review).get(), *review, 201);
+}
+
+void RestServer::putReview(const httplib::Request& req, httplib::Response& res) {
+    auto id = pathId(req);
+    if (!id) {
+        sendError(res, 400, "Invalid review id");
+        return;
+    }
+    auto review = parseBody<PerformanceReview>(req, res, "reviewId", *id);
+    if (!review) {
+        return;
+    }
+    if (!db.getPerformanceReview(*id)) {
+        sendError(res, 404, "Review not found");
+        return;
+    }
+    sendWriteResult(res, db.submitPerformanceReviewUpdate(*review).get(), *review, 200);
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,114 @@
+#include "RowArena.hpp"
+#include <cstdio>
+#include <cstring>
+#include <date/date.h>
+
+namespace PerfMgmt {
+
+namespace {
+// digits [begin, begin + count) of text as a number, nullopt if any of them is not a digit
+std::optional<unsigned> digitsAt(std::string_view text, std::size_t begin, std::size_t count) {
+    unsigned value = 0;
+    for (std::size_t i = begin; i < begin + count; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return std::nullopt;
+        }
+        value = value * 10 + static_cast<unsigned>(text[i] - '0');
+    }
+    return value;
+}
+} // namespace
+
+std::optional<DayNumber> toDayNumber(std::string_view isoDate) {
+    if (isoDate.size() < 10 || isoDate[4] != '-' || isoDate[7] != '-') {
+        return std::nullopt;
+    }
+    auto year = digitsAt(isoDate, 0, 4);
+    auto month = digitsAt(isoDate, 5, 2);
+    auto day = digitsAt(isoDate, 8, 2);
+    if (!year || !month || !day) {
+        return std::nullopt;
+    }
+    date::year_month_day ymd{date::year{static_cast<int>(*year)}, date::month{*month}, date::day{*day}};
+    if (!ymd.ok()) {
+        return std::nullopt;
+    }
+    return static_cast<DayNumber>(date::sys_days{ymd}.time_since_epoch().count());
+}
+
+std::string toIsoDate(DayNumber day) {
+    if (day == NO_DAY) {
+        return {};
+    }
+    date::year_month_day ymd{date::sys_days{date::days{day}}};
+    char text[16];
+    std::snprintf(text, sizeof(text), "%04d-%02u-%02u", static_cast<int>(ymd.year()),
+                  static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()));
+    return text;
+}
+
+Employee EmployeeRow::toEmployee() const {
+    return Employee(employeeId, personnelCode, std::string(name), toIsoDate(hireDay), role, isActive, reportsTo);
+}
+
+PerformanceReview ReviewRow::toPerformanceReview() const {
+    auto kpi = [this](Kpi k) { return kpis[static_cast<std::size_t>(k)]; };
+    PerformanceReview review(reviewId, employeeId, reviewerId, toIsoDate(reviewDay), overallRating,
+                             kpi(Kpi::PUNCTUALITY), kpi(Kpi::QUALITY_OF_WORK), kpi(Kpi::COMMUNICATION),
+                             kpi(Kpi::TEAMWORK), kpi(Kpi::TECHNICAL_SKILLS), kpi(Kpi::PROBLEM_SOLVING),
+                             kpi(Kpi::CREATIVITY), kpi(Kpi::ADAPTABILITY), kpi(Kpi::LEADERSHIP), kpi(Kpi::INITIATIVE),
+                             std::string(comments.value_or(std::string_view{})));
+    if (!comments) {
+        review.comments.reset();
+    }
+    return review;
+}
+
+BlockCache::~BlockCache() {
+    for (const Block& block : freeBlocks) {
+        std::pmr::new_delete_resource()->deallocate(block.memory, block.bytes, block.alignment);
+    }
+}
+
+void* BlockCache::do_allocate(std::size_t bytes, std::size_t alignment) {
+    for (std::size_t i = 0; i < freeBlocks.size(); ++i) {
+        if (freeBlocks[i].bytes == bytes && freeBlocks[i].alignment == alignment) {
+            void* memory = freeBlocks[i].memory;
+            freeBlocks[i] = freeBlocks.back();
+            freeBlocks.pop_back();
+            return memory;
+        }
+    }
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void BlockCache::do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) {
+    freeBlocks.push_back({memory, bytes, alignment});
+}
+
+bool BlockCache::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+StringInterner::StringInterner(std::pmr::memory_resource* resource) : resource(resource), strings(resource) {
+}
+
+std::string_view StringInterner::intern(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    auto it = strings.find(text);
+    if (it != strings.end()) {
+        return *it;
+    }
+    auto* copy = static_cast<char*>(resource->allocate(text.size() + 1, 1));
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+    return *strings.emplace(copy, text.size()).first;
+}
+
+std::size_t StringInterner::size() const {
+    return strings.size();
+}
+
+} // namespace PerfMgmt
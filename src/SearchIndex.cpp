@@ -0,0 +1,216 @@
+#include "SearchIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace PerfMgmt {
+
+void SearchIndex::upsert(int id, std::string_view text) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    eraseLocked(id);
+    Document document;
+    document.id = id;
+    document.text = normalize(text);
+    if (document.text.empty()) {
+        return;
+    }
+    document.trigrams = trigramsOf(document.text, false);
+
+    std::uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(documents.size());
+        documents.emplace_back();
+    }
+    for (Trigram trigram : document.trigrams) {
+        postings[trigram].push_back(slot);
+    }
+    documents[slot] = std::move(document);
+    slots[id] = slot;
+}
+
+void SearchIndex::erase(int id) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    eraseLocked(id);
+}
+
+void SearchIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    documents.clear();
+    freeSlots.clear();
+    slots.clear();
+    postings.clear();
+}
+
+std::vector<SearchHit> SearchIndex::search(std::string_view query, std::size_t limit, double minCoverage) const {
+    std::vector<SearchHit> hits;
+    std::string normalized = normalize(query);
+    if (normalized.empty() || limit == 0) {
+        return hits;
+    }
+    std::vector<Trigram> queryTrigrams = trigramsOf(normalized, true);
+    auto needed = static_cast<std::uint32_t>(
+        std::max<double>(1.0, std::ceil(minCoverage * static_cast<double>(queryTrigrams.size()))));
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    // shared trigram count per slot, walked through the posting lists of the query trigrams only;
+    // the per-thread scratch is handed back zeroed, so a query costs its postings, not the index size
+    thread_local std::vector<std::uint32_t> counts;
+    thread_local std::vector<std::uint32_t> touched;
+    if (counts.size() < documents.size()) {
+        counts.resize(documents.size(), 0);
+    }
+    touched.clear();
+    for (Trigram trigram : queryTrigrams) {
+        auto it = postings.find(trigram);
+        if (it == postings.end()) {
+            continue;
+        }
+        for (std::uint32_t slot : it->second) {
+            if (counts[slot]++ == 0) {
+                touched.push_back(slot);
+            }
+        }
+    }
+    // candidates grouped by shared trigram count, so they can be scored from the best coverage down
+    std::size_t queryCount = queryTrigrams.size();
+    std::vector<std::vector<std::uint32_t>> byCount(queryCount + 1);
+    for (std::uint32_t slot : touched) {
+        if (counts[slot] >= needed) {
+            byCount[counts[slot]].push_back(slot);
+        }
+        counts[slot] = 0;
+    }
+
+    struct Ranked {
+        double score;
+        std::size_t length;
+        int id;
+    };
+    auto better = [](const Ranked& a, const Ranked& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        return a.length != b.length ? a.length < b.length : a.id < b.id;
+    };
+    // heap of the best limit hits so far, worst on top
+    std::vector<Ranked> best;
+    for (std::size_t count = queryCount; count >= needed && count > 0; --count) {
+        double coverage = static_cast<double>(count) / static_cast<double>(queryCount);
+        // a text containing the query has all of its trigrams except at most the two leading pads of the
+        // first word, below that no substring bonus is possible
+        bool substringPossible = count + 2 >= queryCount;
+        // nothing on this or a lower level can beat a full set of hits any more
+        if (best.size() == limit && coverage + (substringPossible ? 1.0 : 0.0) < best.front().score) {
+            break;
+        }
+        for (std::uint32_t slot : byCount[count]) {
+            const Document& document = documents[slot];
+            double score = coverage;
+            auto position = substringPossible ? document.text.find(normalized) : std::string::npos;
+            if (position != std::string::npos) {
+                // the whole query as typed: starting a word ranks above somewhere inside one
+                score += (position == 0 || document.text[position - 1] == ' ') ? 1.0 : 0.5;
+            }
+            Ranked candidate{score, document.text.size(), document.id};
+            if (best.size() < limit) {
+                best.push_back(candidate);
+                std::push_heap(best.begin(), best.end(), better);
+            } else if (better(candidate, best.front())) {
+                std::pop_heap(best.begin(), best.end(), better);
+                best.back() = candidate;
+                std::push_heap(best.begin(), best.end(), better);
+            }
+        }
+    }
+    std::sort_heap(best.begin(), best.end(), better);
+    hits.reserve(best.size());
+    for (const auto& ranked : best) {
+        hits.push_back({ranked.id, ranked.score});
+    }
+    return hits;
+}
+
+bool SearchIndex::contains(int id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return slots.count(id) != 0;
+}
+
+std::size_t SearchIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return slots.size();
+}
+
+std::string SearchIndex::normalize(std::string_view text) {
+    std::string normalized;
+    normalized.reserve(text.size());
+    bool pendingSpace = false;
+    for (char c : text) {
+        auto byte = static_cast<unsigned char>(c);
+        // bytes of multi-byte UTF-8 sequences are kept as they are
+        bool wordByte = byte >= 0x80 || (byte >= '0' && byte <= '9') || (byte >= 'a' && byte <= 'z') ||
+                        (byte >= 'A' && byte <= 'Z');
+        if (!wordByte) {
+            pendingSpace = !normalized.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            normalized.push_back(' ');
+            pendingSpace = false;
+        }
+        normalized.push_back(byte >= 'A' && byte <= 'Z' ? static_cast<char>(byte - 'A' + 'a') : c);
+    }
+    return normalized;
+}
+
+std::vector<SearchIndex::Trigram> SearchIndex::trigramsOf(const std::string& normalized, bool prefixQuery) {
+    std::vector<Trigram> trigrams;
+    std::string padded;
+    std::size_t begin = 0;
+    while (begin < normalized.size()) {
+        std::size_t end = normalized.find(' ', begin);
+        bool lastWord = end == std::string::npos;
+        if (lastWord) {
+            end = normalized.size();
+        }
+        padded.assign("  ");
+        padded.append(normalized, begin, end - begin);
+        if (!(lastWord && prefixQuery)) {
+            padded.push_back(' ');
+        }
+        for (std::size_t i = 0; i + 3 <= padded.size(); ++i) {
+            trigrams.push_back(static_cast<Trigram>(static_cast<unsigned char>(padded[i])) << 16 |
+                               static_cast<Trigram>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                               static_cast<Trigram>(static_cast<unsigned char>(padded[i + 2])));
+        }
+        begin = end + 1;
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+void SearchIndex::eraseLocked(int id) {
+    auto it = slots.find(id);
+    if (it == slots.end()) {
+        return;
+    }
+    std::uint32_t slot = it->second;
+    for (Trigram trigram : documents[slot].trigrams) {
+        auto posting = postings.find(trigram);
+        auto& entries = posting->second;
+        auto entry = std::find(entries.begin(), entries.end(), slot);
+        *entry = entries.back();
+        entries.pop_back();
+        if (entries.empty()) {
+            postings.erase(posting);
+        }
+    }
+    documents[slot] = Document{};
+    freeSlots.push_back(slot);
+    slots.erase(it);
+}
+
+} // namespace PerfMgmt
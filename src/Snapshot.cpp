@@ -0,0 +1,366 @@
+#include "Snapshot.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace PerfMgmt {
+
+using namespace snapshot;
+
+namespace {
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + 7) & ~std::uint64_t{7};
+}
+
+void setKpis(float (&kpis)[KPI_COUNT], const PerformanceReview& review) {
+    for (std::size_t k = 0; k < KPI_COUNT; ++k) {
+        kpis[k] = kpiValue(review, static_cast<Kpi>(k));
+    }
+}
+} // namespace
+
+// ---- SnapshotWriter ----
+
+void SnapshotWriter::addEmployee(const Employee& employee) {
+    EmployeeRecord record{};
+    record.employeeId = employee.employeeId;
+    record.personnelCode = employee.personnelCode;
+    record.reportsTo = employee.reportsTo.value_or(NO_MANAGER);
+    record.role = static_cast<std::uint8_t>(employee.role);
+    record.isActive = employee.isActive ? 1 : 0;
+    record.name = intern(employee.name);
+    record.hireDate = intern(employee.hireDate);
+    employees.push_back(record);
+}
+
+void SnapshotWriter::addReview(const PerformanceReview& review) {
+    ReviewRecord record{};
+    record.reviewId = review.reviewId;
+    record.employeeId = review.employeeId;
+    record.reviewerId = review.reviewerId;
+    record.hasOverallRating = review.overallRating ? 1 : 0;
+    record.overallRating = review.overallRating.value_or(0.0f);
+    setKpis(record.kpis, review);
+    record.reviewDate = intern(review.reviewDate);
+    if (review.comments) {
+        record.comments = intern(*review.comments);
+    }
+    reviews.push_back(record);
+}
+
+StringRef SnapshotWriter::intern(std::string_view text) {
+    auto it = internedStrings.find(std::string(text));
+    if (it != internedStrings.end()) {
+        return it->second;
+    }
+    StringRef ref{static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(text.size())};
+    strings.append(text);
+    internedStrings.emplace(std::string(text), ref);
+    return ref;
+}
+
+bool SnapshotWriter::write(const std::string& path) {
+    auto textOf = [this](const StringRef& ref) { return std::string_view(strings.data() + ref.offset, ref.length); };
+    std::sort(employees.begin(), employees.end(),
+              [](const EmployeeRecord& a, const EmployeeRecord& b) { return a.employeeId < b.employeeId; });
+    std::sort(reviews.begin(), reviews.end(), [&textOf](const ReviewRecord& a, const ReviewRecord& b) {
+        if (a.employeeId != b.employeeId) {
+            return a.employeeId < b.employeeId;
+        }
+        auto dateA = textOf(a.reviewDate);
+        auto dateB = textOf(b.reviewDate);
+        return dateA != dateB ? dateA < dateB : a.reviewId < b.reviewId;
+    });
+
+    // link every employee to its run of reviews; both sides are sorted by employee id
+    std::size_t review = 0;
+    for (auto& employee : employees) {
+        while (review < reviews.size() && reviews[review].employeeId < employee.employeeId) {
+            ++review;
+        }
+        employee.firstReview = static_cast<std::uint32_t>(review);
+        while (review < reviews.size() && reviews[review].employeeId == employee.employeeId) {
+            ++review;
+        }
+        employee.reviewCount = static_cast<std::uint32_t>(review - employee.firstReview);
+    }
+
+    std::vector<IndexEntry> employeeIndex(employees.size());
+    for (std::size_t i = 0; i < employees.size(); ++i) {
+        employeeIndex[i] = {employees[i].employeeId, static_cast<std::uint32_t>(i)};
+    }
+    std::vector<IndexEntry> reviewIndex(reviews.size());
+    for (std::size_t i = 0; i < reviews.size(); ++i) {
+        reviewIndex[i] = {reviews[i].reviewId, static_cast<std::uint32_t>(i)};
+    }
+    std::sort(reviewIndex.begin(), reviewIndex.end(),
+              [](const IndexEntry& a, const IndexEntry& b) { return a.id < b.id; });
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.endianTag = ENDIAN_TAG;
+    header.employeeCount = employees.size();
+    header.reviewCount = reviews.size();
+    header.employeesOffset = sizeof(Header);
+    header.reviewsOffset = alignUp(header.employeesOffset + employees.size() * sizeof(EmployeeRecord));
+    header.employeeIndexOffset = alignUp(header.reviewsOffset + reviews.size() * sizeof(ReviewRecord));
+    header.reviewIndexOffset = alignUp(header.employeeIndexOffset + employeeIndex.size() * sizeof(IndexEntry));
+    header.stringsOffset = alignUp(header.reviewIndexOffset + reviewIndex.size() * sizeof(IndexEntry));
+    header.stringsSize = strings.size();
+    header.fileSize = header.stringsOffset + strings.size();
+
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[SnapshotWriter] : " << "cannot open " << tmpPath << std::endl;
+            return false;
+        }
+        auto section = [&out](std::uint64_t offset, const void* data, std::size_t bytes) {
+            // zero padding up to the aligned start of the section
+            static const char zeros[8] = {};
+            out.write(zeros, static_cast<std::streamsize>(offset - static_cast<std::uint64_t>(out.tellp())));
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        };
+        section(0, &header, sizeof(header));
+        section(header.employeesOffset, employees.data(), employees.size() * sizeof(EmployeeRecord));
+        section(header.reviewsOffset, reviews.data(), reviews.size() * sizeof(ReviewRecord));
+        section(header.employeeIndexOffset, employeeIndex.data(), employeeIndex.size() * sizeof(IndexEntry));
+        section(header.reviewIndexOffset, reviewIndex.data(), reviewIndex.size() * sizeof(IndexEntry));
+        section(header.stringsOffset, strings.data(), strings.size());
+        if (!out.flush()) {
+            std::cerr << "[SnapshotWriter] : " << "write to " << tmpPath << " failed" << std::endl;
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "[SnapshotWriter] : " << "cannot rename " << tmpPath << " to " << path << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ---- Snapshot ----
+
+std::optional<Snapshot> Snapshot::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "[Snapshot] : " << "cannot open " << path << std::endl;
+        return std::nullopt;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+        std::cerr << "[Snapshot] : " << path << " is not a snapshot" << std::endl;
+        ::close(fd);
+        return std::nullopt;
+    }
+    auto size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[Snapshot] : " << "cannot map " << path << std::endl;
+        return std::nullopt;
+    }
+    Snapshot snapshot(static_cast<const unsigned char*>(mapping), size);
+    if (!snapshot.validate()) {
+        std::cerr << "[Snapshot] : " << path << " is corrupt or of another format version" << std::endl;
+        return std::nullopt;
+    }
+    return snapshot;
+}
+
+Snapshot::Snapshot(const unsigned char* base, std::size_t size) : base(base), size(size) {
+}
+
+Snapshot::Snapshot(Snapshot&& other) noexcept : base(other.base), size(other.size) {
+    other.base = nullptr;
+    other.size = 0;
+}
+
+Snapshot& Snapshot::operator=(Snapshot&& other) noexcept {
+    if (this != &other) {
+        if (base) {
+            ::munmap(const_cast<unsigned char*>(base), size);
+        }
+        base = other.base;
+        size = other.size;
+        other.base = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+Snapshot::~Snapshot() {
+    if (base) {
+        ::munmap(const_cast<unsigned char*>(base), size);
+    }
+}
+
+bool Snapshot::validate() const {
+    const Header& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != FORMAT_VERSION || h.endianTag != ENDIAN_TAG ||
+        h.fileSize != size) {
+        return false;
+    }
+    // counts are bounded by the file size first, so the products below cannot overflow
+    auto fits = [this](std::uint64_t offset, std::uint64_t count, std::uint64_t width) {
+        return offset % 8 == 0 && offset <= size && count <= (size - offset) / width;
+    };
+    if (!fits(h.employeesOffset, h.employeeCount, sizeof(EmployeeRecord)) ||
+        !fits(h.reviewsOffset, h.reviewCount, sizeof(ReviewRecord)) ||
+        !fits(h.employeeIndexOffset, h.employeeCount, sizeof(IndexEntry)) ||
+        !fits(h.reviewIndexOffset, h.reviewCount, sizeof(IndexEntry)) || h.stringsOffset > size ||
+        h.stringsSize > size - h.stringsOffset) {
+        return false;
+    }
+    auto stringFits = [&h](const StringRef& ref, bool optional) {
+        if (ref.offset == NO_STRING) {
+            return optional;
+        }
+        return ref.offset <= h.stringsSize && ref.length <= h.stringsSize - ref.offset;
+    };
+    for (std::size_t i = 0; i < h.employeeCount; ++i) {
+        const auto& record = employeeRecord(i);
+        if (record.role > static_cast<std::uint8_t>(Role::TECHNICIAN) || !stringFits(record.name, false) ||
+            !stringFits(record.hireDate, false) ||
+            record.firstReview > h.reviewCount || record.reviewCount > h.reviewCount - record.firstReview) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < h.reviewCount; ++i) {
+        const auto& record = reviewRecord(i);
+        if (!stringFits(record.reviewDate, false) || !stringFits(record.comments, true)) {
+            return false;
+        }
+    }
+    auto indexFits = [this](std::uint64_t offset, std::uint64_t count) {
+        const auto* entries = reinterpret_cast<const IndexEntry*>(base + offset);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (entries[i].record >= count || (i > 0 && entries[i - 1].id > entries[i].id)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    return indexFits(h.employeeIndexOffset, h.employeeCount) && indexFits(h.reviewIndexOffset, h.reviewCount);
+}
+
+const Header& Snapshot::header() const {
+    return *reinterpret_cast<const Header*>(base);
+}
+
+std::size_t Snapshot::employeeCount() const {
+    return header().employeeCount;
+}
+
+std::size_t Snapshot::reviewCount() const {
+    return header().reviewCount;
+}
+
+const EmployeeRecord& Snapshot::employeeRecord(std::size_t index) const {
+    return reinterpret_cast<const EmployeeRecord*>(base + header().employeesOffset)[index];
+}
+
+const ReviewRecord& Snapshot::reviewRecord(std::size_t index) const {
+    return reinterpret_cast<const ReviewRecord*>(base + header().reviewsOffset)[index];
+}
+
+std::string_view Snapshot::text(const StringRef& ref) const {
+    if (ref.offset == NO_STRING) {
+        return {};
+    }
+    return std::string_view(reinterpret_cast<const char*>(base + header().stringsOffset) + ref.offset, ref.length);
+}
+
+std::optional<std::uint32_t> Snapshot::find(std::uint64_t indexOffset, std::uint64_t count, int id) const {
+    const auto* begin = reinterpret_cast<const IndexEntry*>(base + indexOffset);
+    const auto* end = begin + count;
+    const auto* it = std::lower_bound(begin, end, id, [](const IndexEntry& entry, int key) { return entry.id < key; });
+    if (it == end || it->id != id) {
+        return std::nullopt;
+    }
+    return it->record;
+}
+
+Employee Snapshot::employeeAt(std::size_t index) const {
+    const auto& record = employeeRecord(index);
+    Employee employee;
+    employee.employeeId = record.employeeId;
+    employee.personnelCode = record.personnelCode;
+    employee.name = std::string(text(record.name));
+    employee.hireDate = std::string(text(record.hireDate));
+    employee.role = static_cast<Role>(record.role);
+    employee.isActive = record.isActive != 0;
+    if (record.reportsTo != NO_MANAGER) {
+        employee.reportsTo = record.reportsTo;
+    }
+    return employee;
+}
+
+PerformanceReview Snapshot::reviewAt(std::size_t index) const {
+    const auto& record = reviewRecord(index);
+    PerformanceReview review;
+    review.reviewId = record.reviewId;
+    review.employeeId = record.employeeId;
+    review.reviewerId = record.reviewerId;
+    review.reviewDate = std::string(text(record.reviewDate));
+    if (record.hasOverallRating) {
+        review.overallRating = record.overallRating;
+    }
+    review.punctualityRating = record.kpis[static_cast<std::size_t>(Kpi::PUNCTUALITY)];
+    review.qualityOfWorkRating = record.kpis[static_cast<std::size_t>(Kpi::QUALITY_OF_WORK)];
+    review.communicationRating = record.kpis[static_cast<std::size_t>(Kpi::COMMUNICATION)];
+    review.teamworkRating = record.kpis[static_cast<std::size_t>(Kpi::TEAMWORK)];
+    review.technicalSkillsRating = record.kpis[static_cast<std::size_t>(Kpi::TECHNICAL_SKILLS)];
+    review.problemSolvingRating = record.kpis[static_cast<std::size_t>(Kpi::PROBLEM_SOLVING)];
+    review.creativityRating = record.kpis[static_cast<std::size_t>(Kpi::CREATIVITY)];
+    review.adaptabilityRating = record.kpis[static_cast<std::size_t>(Kpi::ADAPTABILITY)];
+    review.leadershipRating = record.kpis[static_cast<std::size_t>(Kpi::LEADERSHIP)];
+    review.initiativeRating = record.kpis[static_cast<std::size_t>(Kpi::INITIATIVE)];
+    if (record.comments.offset != NO_STRING) {
+        review.comments = std::string(text(record.comments));
+    }
+    return review;
+}
+
+std::optional<Employee> Snapshot::getEmployee(int employeeId) const {
+    auto record = find(header().employeeIndexOffset, header().employeeCount, employeeId);
+    if (!record) {
+        return std::nullopt;
+    }
+    return employeeAt(*record);
+}
+
+std::optional<PerformanceReview> Snapshot::getPerformanceReview(int reviewId) const {
+    auto record = find(header().reviewIndexOffset, header().reviewCount, reviewId);
+    if (!record) {
+        return std::nullopt;
+    }
+    return reviewAt(*record);
+}
+
+std::vector<PerformanceReview> Snapshot::getReviewsForEmployee(int employeeId) const {
+    std::vector<PerformanceReview> result;
+    auto record = find(header().employeeIndexOffset, header().employeeCount, employeeId);
+    if (!record) {
+        return result;
+    }
+    const auto& employee = employeeRecord(*record);
+    result.reserve(employee.reviewCount);
+    for (std::uint32_t i = 0; i < employee.reviewCount; ++i) {
+        result.push_back(reviewAt(employee.firstReview + i));
+    }
+    return result;
+}
+
+} // namespace PerfMgmt
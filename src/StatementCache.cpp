@@ -0,0 +1,63 @@
+#include "StatementCache.hpp"
+
+namespace PerfMgmt {
+
+StatementCache::StatementCache(sqlite::database& db) : db(db) {
+}
+
+StatementCache::~StatementCache() {
+    clear();
+}
+
+sqlite::database_binder& StatementCache::acquire(const std::string& sql) {
+    auto it = statements.find(sql);
+    if (it != statements.end()) {
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        // a previous call may have thrown half way through binding or stepping
+        it->second.reset();
+        return it->second;
+    }
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    return statements.emplace(sql, db << sql).first->second;
+}
+
+sqlite3_stmt* StatementCache::acquireRaw(const std::string& sql) {
+    auto it = rawStatements.find(sql);
+    if (it != rawStatements.end()) {
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        sqlite3_reset(it->second.get());
+        sqlite3_clear_bindings(it->second.get());
+        return it->second.get();
+    }
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    sqlite3_stmt* stmt = nullptr;
+    int rc = sqlite3_prepare_v2(db.connection().get(), sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        sqlite::errors::throw_sqlite_error(rc, sql);
+    }
+    return rawStatements.emplace(sql, std::unique_ptr<sqlite3_stmt, Finalizer>(stmt)).first->second.get();
+}
+
+void StatementCache::clear() {
+    // database_binder executes unused statements on destruction, cached ones must never run that way
+    for (auto& entry : statements) {
+        entry.second.used(true);
+    }
+    statements.clear();
+    rawStatements.clear();
+}
+
+std::size_t StatementCache::size() const {
+    return statements.size() + rawStatements.size();
+}
+
+std::size_t StatementCache::hits() const {
+    return hitCount.load(std::memory_order_relaxed);
+}
+
+std::size_t StatementCache::misses() const {
+    return missCount.load(std::memory_order_relaxed);
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,203 @@
+#include <SyncEngine.hpp>
+#include <future>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace PerfMgmt {
+
+namespace {
+const std::string EMPLOYEES_WATERMARK = "employees_pulled";
+const std::string REVIEWS_WATERMARK = "reviews_pulled";
+} // namespace
+
+SyncEngine::SyncEngine(DatabaseManager& database, const std::string& serverBaseUrl, const AsyncNetworkConfig& config,
+                       std::size_t pageSize)
+    : database(database), client(serverBaseUrl), pipeline(serverBaseUrl, config),
+      pageSize(pageSize > 0 ? pageSize : DEFAULT_SYNC_PAGE_SIZE) {
+    // the pulls are the row lists
+    client.setWireFormat(config.wireFormat);
+}
+
+SyncReport SyncEngine::sync() {
+    // pulling first lets the dirty-row guard keep local edits, the push then overrides the server copy
+    SyncReport report = pull();
+    SyncReport pushed = push();
+    report.employeesPushed = pushed.employeesPushed;
+    report.reviewsPushed = pushed.reviewsPushed;
+    report.failures += pushed.failures;
+    return report;
+}
+
+SyncReport SyncEngine::pull() {
+    SyncReport report;
+    pullEmployees(report);
+    pullReviews(report);
+    return report;
+}
+
+SyncReport SyncEngine::push() {
+    SyncReport report;
+    pushEmployees(report);
+    pushReviews(report);
+    return report;
+}
+
+void SyncEngine::pullEmployees(SyncReport& report) {
+    auto since = database.syncWatermark(EMPLOYEES_WATERMARK);
+    auto changes = client.fetchEmployeesSince(since);
+    if (!changes) {
+        std::cerr << "[pullEmployees] : " << "fetch failed (status " << client.lastStatusCode() << ")" << std::endl;
+        ++report.failures;
+        return;
+    }
+    auto result = database.applyRemoteEmployees(changes->rows);
+    report.employeesPulled += result.inserted;
+    // a rejected row keeps the watermark where it was so the row is fetched again
+    if (!result.errors.empty()) {
+        report.failures += result.errors.size();
+        return;
+    }
+    if (changes->watermark > since && !database.setSyncWatermark(EMPLOYEES_WATERMARK, changes->watermark)) {
+        ++report.failures;
+    }
+}
+
+void SyncEngine::pullReviews(SyncReport& report) {
+    auto since = database.syncWatermark(REVIEWS_WATERMARK);
+    auto changes = client.fetchReviewsSince(since);
+    if (!changes) {
+        std::cerr << "[pullReviews] : " << "fetch failed (status " << client.lastStatusCode() << ")" << std::endl;
+        ++report.failures;
+        return;
+    }
+    auto result = database.applyRemotePerformanceReviews(changes->rows);
+    report.reviewsPulled += result.inserted;
+    if (!result.errors.empty()) {
+        report.failures += result.errors.size();
+        return;
+    }
+    if (changes->watermark > since && !database.setSyncWatermark(REVIEWS_WATERMARK, changes->watermark)) {
+        ++report.failures;
+    }
+}
+
+void SyncEngine::pushEmployees(SyncReport& report) {
+    // a report is held back while its manager is unpushed, so each pass that adopts ids may free more rows:
+    // a chain of managers created offline goes out one level per pass
+    bool adopted{true};
+    while (adopted) {
+        adopted = pushEmployeePass(report);
+    }
+}
+
+bool SyncEngine::pushEmployeePass(SyncReport& report) {
+    bool adopted{false};
+    int afterId{0};
+    for (;;) {
+        auto page = database.getDirtyEmployees(afterId, pageSize);
+        if (!page) {
+            ++report.failures;
+            return false;
+        }
+        if (page->empty()) {
+            return adopted;
+        }
+        // queue the whole page before waiting so the requests overlap; a row the server has never seen is
+        // created with POST and takes the id it is given, PUT on its local id would overwrite another client's row
+        std::vector<std::future<std::optional<int>>> created;
+        std::vector<std::future<bool>> updated;
+        for (const auto& dirty : *page) {
+            if (dirty.isNew) {
+                created.push_back(pipeline.sendNewEmployee(dirty.row));
+            } else {
+                updated.push_back(pipeline.sendUpdatedEmployee(dirty.row.employeeId, dirty.row));
+            }
+        }
+        std::vector<AssignedId> assigned;
+        std::vector<SyncedVersion> synced;
+        auto nextCreated = created.begin();
+        auto nextUpdated = updated.begin();
+        for (const auto& dirty : *page) {
+            if (dirty.isNew) {
+                if (auto serverId = (nextCreated++)->get()) {
+                    assigned.push_back({dirty.row.employeeId, *serverId, dirty.version});
+                } else {
+                    ++report.failures;
+                }
+            } else if ((nextUpdated++)->get()) {
+                synced.push_back({dirty.row.employeeId, dirty.version});
+            } else {
+                ++report.failures;
+            }
+        }
+        if (database.markEmployeesSynced(synced)) {
+            report.employeesPushed += synced.size();
+        } else {
+            report.failures += synced.size();
+        }
+        if (database.adoptServerEmployeeIds(assigned)) {
+            report.employeesPushed += assigned.size();
+            adopted = adopted || !assigned.empty();
+        } else {
+            report.failures += assigned.size();
+        }
+        afterId = page->back().row.employeeId;
+    }
+}
+
+void SyncEngine::pushReviews(SyncReport& report) {
+    int afterId{0};
+    for (;;) {
+        auto page = database.getDirtyPerformanceReviews(afterId, pageSize);
+        if (!page) {
+            ++report.failures;
+            return;
+        }
+        if (page->empty()) {
+            return;
+        }
+        // employees are pushed first and a review naming one that is still unpushed is not listed, so employeeId
+        // and reviewerId are the server's
+        std::vector<std::future<std::optional<int>>> created;
+        std::vector<std::future<bool>> updated;
+        for (const auto& dirty : *page) {
+            if (dirty.isNew) {
+                created.push_back(pipeline.sendNewReview(dirty.row.employeeId, dirty.row));
+            } else {
+                updated.push_back(pipeline.updateReview(dirty.row.reviewId, dirty.row));
+            }
+        }
+        std::vector<AssignedId> assigned;
+        std::vector<SyncedVersion> synced;
+        auto nextCreated = created.begin();
+        auto nextUpdated = updated.begin();
+        for (const auto& dirty : *page) {
+            if (dirty.isNew) {
+                if (auto serverId = (nextCreated++)->get()) {
+                    assigned.push_back({dirty.row.reviewId, *serverId, dirty.version});
+                } else {
+                    ++report.failures;
+                }
+            } else if ((nextUpdated++)->get()) {
+                synced.push_back({dirty.row.reviewId, dirty.version});
+            } else {
+                ++report.failures;
+            }
+        }
+        if (database.markPerformanceReviewsSynced(synced)) {
+            report.reviewsPushed += synced.size();
+        } else {
+            report.failures += synced.size();
+        }
+        if (database.adoptServerReviewIds(assigned)) {
+            report.reviewsPushed += assigned.size();
+        } else {
+            report.failures += assigned.size();
+        }
+        afterId = page->back().row.reviewId;
+    }
+}
+
+} // namespace PerfMgmt
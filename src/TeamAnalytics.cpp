@@ -0,0 +1,243 @@
+#include "TeamAnalytics.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace PerfMgmt {
+
+namespace {
+std::optional<double> meanOf(std::size_t count, double sum) {
+    if (count == 0) {
+        return std::nullopt;
+    }
+    return sum / static_cast<double>(count);
+}
+
+std::optional<double> stddevOf(std::size_t count, double sum, double sumOfSquares) {
+    if (count == 0) {
+        return std::nullopt;
+    }
+    double mean = sum / static_cast<double>(count);
+    // running sums leave a tiny negative variance for identical ratings
+    return std::sqrt(std::max(0.0, sumOfSquares / static_cast<double>(count) - mean * mean));
+}
+} // namespace
+
+// ---- ReviewPeriod ----
+
+std::optional<ReviewPeriod> ReviewPeriod::fromDate(const std::string& reviewDate) {
+    if (reviewDate.size() < 7 || reviewDate[4] != '-') {
+        return std::nullopt;
+    }
+    for (std::size_t i : {0, 1, 2, 3, 5, 6}) {
+        if (!std::isdigit(static_cast<unsigned char>(reviewDate[i]))) {
+            return std::nullopt;
+        }
+    }
+    int year = std::stoi(reviewDate.substr(0, 4));
+    int month = std::stoi(reviewDate.substr(5, 2));
+    if (month < 1 || month > 12) {
+        return std::nullopt;
+    }
+    return ReviewPeriod{year, (month - 1) / 3 + 1};
+}
+
+// ---- KpiRollup ----
+
+void KpiRollup::add(const PerformanceReview& review) {
+    ++count;
+    for (std::size_t k = 0; k < KPI_COUNT; ++k) {
+        double value = kpiValue(review, static_cast<Kpi>(k));
+        sum[k] += value;
+        sumOfSquares[k] += value * value;
+    }
+    if (review.overallRating) {
+        ++overallCount;
+        overallSum += *review.overallRating;
+        overallSumOfSquares += static_cast<double>(*review.overallRating) * *review.overallRating;
+    }
+}
+
+KpiRollup& KpiRollup::operator+=(const KpiRollup& other) {
+    count += other.count;
+    for (std::size_t k = 0; k < KPI_COUNT; ++k) {
+        sum[k] += other.sum[k];
+        sumOfSquares[k] += other.sumOfSquares[k];
+    }
+    overallCount += other.overallCount;
+    overallSum += other.overallSum;
+    overallSumOfSquares += other.overallSumOfSquares;
+    return *this;
+}
+
+KpiRollup& KpiRollup::operator-=(const KpiRollup& other) {
+    count -= other.count;
+    for (std::size_t k = 0; k < KPI_COUNT; ++k) {
+        sum[k] -= other.sum[k];
+        sumOfSquares[k] -= other.sumOfSquares[k];
+    }
+    overallCount -= other.overallCount;
+    overallSum -= other.overallSum;
+    overallSumOfSquares -= other.overallSumOfSquares;
+    return *this;
+}
+
+std::optional<double> KpiRollup::mean(Kpi kpi) const {
+    return meanOf(count, sum[static_cast<std::size_t>(kpi)]);
+}
+
+std::optional<double> KpiRollup::overallMean() const {
+    return meanOf(overallCount, overallSum);
+}
+
+std::optional<double> KpiRollup::stddev(Kpi kpi) const {
+    auto k = static_cast<std::size_t>(kpi);
+    return stddevOf(count, sum[k], sumOfSquares[k]);
+}
+
+std::optional<double> KpiRollup::overallStddev() const {
+    return stddevOf(overallCount, overallSum, overallSumOfSquares);
+}
+
+// ---- TeamAnalytics ----
+
+TeamAnalytics::TeamAnalytics(const OrgChartIndex& orgChart) : orgChart(orgChart) {
+}
+
+void TeamAnalytics::addReview(const PerformanceReview& review) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    Contribution contribution;
+    contribution.employeeId = review.employeeId;
+    contribution.values.add(review);
+    auto period = ReviewPeriod::fromDate(review.reviewDate);
+    contribution.periodKey = period ? periodKey(*period) : NO_PERIOD;
+
+    auto it = reviews.find(review.reviewId);
+    if (it != reviews.end()) {
+        if (review.reviewDate.empty()) {
+            contribution.periodKey = it->second.periodKey;
+        }
+        apply(it->second, -1);
+        it->second = contribution;
+    } else {
+        reviews.emplace(review.reviewId, contribution);
+    }
+    apply(contribution, 1);
+}
+
+void TeamAnalytics::removeReview(int reviewId) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = reviews.find(reviewId);
+    if (it == reviews.end()) {
+        return;
+    }
+    apply(it->second, -1);
+    reviews.erase(it);
+}
+
+void TeamAnalytics::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    reviews.clear();
+    own.clear();
+    subtrees.clear();
+}
+
+KpiRollup TeamAnalytics::team(int managerId, std::optional<ReviewPeriod> period) const {
+    auto lock = readLock();
+    return lookup(subtrees, managerId, period);
+}
+
+KpiRollup TeamAnalytics::employee(int employeeId, std::optional<ReviewPeriod> period) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return lookup(own, employeeId, period);
+}
+
+std::size_t TeamAnalytics::reviewCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return reviews.size();
+}
+
+std::int32_t TeamAnalytics::periodKey(const ReviewPeriod& period) {
+    return period.year * 4 + period.quarter - 1;
+}
+
+std::int64_t TeamAnalytics::rollupKey(int id, std::int32_t periodKey) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)) << 32 |
+                                     static_cast<std::uint32_t>(periodKey));
+}
+
+std::shared_lock<std::shared_mutex> TeamAnalytics::readLock() const {
+    while (true) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (builtGeneration == orgChart.generation()) {
+                return lock;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (builtGeneration != orgChart.generation()) {
+            rebuildSubtrees();
+        }
+    }
+}
+
+void TeamAnalytics::rebuildSubtrees() const {
+    // read first: a reporting line changing during the rebuild leaves builtGeneration stale and forces another one
+    builtGeneration = orgChart.generation();
+    subtrees.clear();
+    std::unordered_map<int, std::vector<int>> chains;
+    for (const auto& [key, rollup] : own) {
+        int employeeId = static_cast<int>(static_cast<std::uint32_t>(static_cast<std::uint64_t>(key) >> 32));
+        auto period = static_cast<std::int32_t>(static_cast<std::uint32_t>(key));
+        auto chain = chains.find(employeeId);
+        if (chain == chains.end()) {
+            chain = chains.emplace(employeeId, orgChart.chainToRoot(employeeId)).first;
+        }
+        // chain[0] is the employee itself
+        for (std::size_t i = 1; i < chain->second.size(); ++i) {
+            subtrees[rollupKey(chain->second[i], period)] += rollup;
+        }
+    }
+}
+
+void TeamAnalytics::apply(const Contribution& contribution, int sign) {
+    std::vector<int> chain;
+    // stale subtrees are rebuilt from own by the next query, no need to maintain them
+    if (builtGeneration == orgChart.generation()) {
+        chain = orgChart.chainToRoot(contribution.employeeId);
+    }
+    for (std::int32_t period : {contribution.periodKey, ALL_PERIODS}) {
+        if (period == NO_PERIOD) {
+            continue;
+        }
+        applyTo(own, rollupKey(contribution.employeeId, period), contribution.values, sign);
+        for (std::size_t i = 1; i < chain.size(); ++i) {
+            applyTo(subtrees, rollupKey(chain[i], period), contribution.values, sign);
+        }
+    }
+}
+
+void TeamAnalytics::applyTo(RollupMap& rollups, std::int64_t key, const KpiRollup& values, int sign) {
+    if (sign > 0) {
+        rollups[key] += values;
+        return;
+    }
+    auto it = rollups.find(key);
+    if (it == rollups.end()) {
+        return;
+    }
+    it->second -= values;
+    // dropping empty entries also drops the rounding residue of the sums
+    if (it->second.count == 0) {
+        rollups.erase(it);
+    }
+}
+
+KpiRollup TeamAnalytics::lookup(const RollupMap& rollups, int id, std::optional<ReviewPeriod> period) const {
+    auto it = rollups.find(rollupKey(id, period ? periodKey(*period) : ALL_PERIODS));
+    return it == rollups.end() ? KpiRollup{} : it->second;
+}
+
+} // namespace PerfMgmt
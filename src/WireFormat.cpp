@@ -0,0 +1,36 @@
+#include <WireFormat.hpp>
+#include <algorithm>
+#include <cctype>
+
+namespace PerfMgmt {
+
+const char* mediaType(WireFormat format) {
+    switch (format) {
+    case WireFormat::MSGPACK:
+        return "application/msgpack";
+    case WireFormat::CBOR:
+        return "application/cbor";
+    case WireFormat::JSON:
+        break;
+    }
+    return "application/json";
+}
+
+std::optional<WireFormat> wireFormatOf(std::string_view contentType) {
+    std::string type(contentType.substr(0, contentType.find(';')));
+    type.erase(std::remove_if(type.begin(), type.end(), [](unsigned char c) { return std::isspace(c); }), type.end());
+    std::transform(type.begin(), type.end(), type.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (type == "application/json") {
+        return WireFormat::JSON;
+    }
+    // MessagePack has gone by all three names
+    if (type == "application/msgpack" || type == "application/x-msgpack" || type == "application/vnd.msgpack") {
+        return WireFormat::MSGPACK;
+    }
+    if (type == "application/cbor") {
+        return WireFormat::CBOR;
+    }
+    return std::nullopt;
+}
+
+} // namespace PerfMgmt
@@ -0,0 +1,151 @@
+#include <WriteBehindQueue.hpp>
+#include <algorithm>
+#include <exception>
+
+namespace PerfMgmt {
+
+WriteBehindQueue::WriteBehindQueue(const WriteBehindConfig& config, CommitGroup commitGroup)
+    : config(config), commitGroup(std::move(commitGroup)) {
+    this->config.maxBatchSize = std::max<std::size_t>(1, config.maxBatchSize);
+    this->config.capacity = std::max<std::size_t>(1, config.capacity);
+    writer = std::thread(&WriteBehindQueue::writerLoop, this);
+}
+
+WriteBehindQueue::~WriteBehindQueue() {
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    writesQueued.notify_all();
+    writesDone.notify_all();
+    writer.join();
+}
+
+std::future<WriteResult> WriteBehindQueue::submit(WriteKind kind, const PerformanceReview& review) {
+    PendingWrite write{kind, review, {}};
+    auto future = write.done.get_future();
+    if (!reserveSlot()) {
+        write.done.set_value({WriteStatus::QUEUE_FULL, review.reviewId});
+        return future;
+    }
+    // counted before it is queued, so flush() never waits on less than it has to
+    submitted.fetch_add(1);
+    queue.push(std::move(write));
+    // the writer flags itself before its last look at the queue, so either it sees this write or we see it asleep
+    if (writerSleeping.load()) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        writesQueued.notify_one();
+    }
+    return future;
+}
+
+void WriteBehindQueue::flush() {
+    std::uint64_t ticket = submitted.load();
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    sleepers.fetch_add(1);
+    writesDone.wait(lock, [&] { return completed.load() >= ticket; });
+    sleepers.fetch_sub(1);
+}
+
+std::size_t WriteBehindQueue::backlog() const {
+    return depth.load(std::memory_order_relaxed);
+}
+
+std::size_t WriteBehindQueue::capacity() const {
+    return config.capacity;
+}
+
+std::uint64_t WriteBehindQueue::groupsCommitted() const {
+    return groups.load(std::memory_order_relaxed);
+}
+
+std::uint64_t WriteBehindQueue::writesCommitted() const {
+    return completed.load(std::memory_order_relaxed);
+}
+
+bool WriteBehindQueue::reserveSlot() {
+    std::size_t current = depth.load();
+    while (true) {
+        if (current < config.capacity) {
+            if (depth.compare_exchange_weak(current, current + 1)) {
+                return true;
+            }
+            continue;
+        }
+        if (!config.blockWhenFull || stopping) {
+            return false;
+        }
+        // backpressure: wait for the writer to retire a group
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        writesDone.wait(lock, [&] {
+            current = depth.load();
+            return current < config.capacity || stopping;
+        });
+        sleepers.fetch_sub(1);
+    }
+}
+
+void WriteBehindQueue::writerLoop() {
+    std::vector<PendingWrite> group;
+    group.reserve(config.maxBatchSize);
+    while (true) {
+        auto write = queue.pop();
+        if (!write) {
+            if (stopping && queue.empty()) {
+                return;
+            }
+            waitForWrites(std::chrono::steady_clock::time_point::max());
+            continue;
+        }
+        group.push_back(std::move(*write));
+
+        // the group closes when it is full or maxBatchDelay after its first write
+        auto deadline = std::chrono::steady_clock::now() + config.maxBatchDelay;
+        while (group.size() < config.maxBatchSize) {
+            if (auto next = queue.pop()) {
+                group.push_back(std::move(*next));
+                continue;
+            }
+            if (stopping || std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            waitForWrites(deadline);
+        }
+
+        try {
+            commitGroup(group);
+        } catch (...) {
+            for (auto& pending : group) {
+                try {
+                    pending.done.set_exception(std::current_exception());
+                } catch (const std::future_error&) {
+                    // resolved before the failure
+                }
+            }
+        }
+        std::size_t count = group.size();
+        group.clear();
+        groups.fetch_add(1, std::memory_order_relaxed);
+        depth.fetch_sub(count);
+        completed.fetch_add(count);
+        if (sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            writesDone.notify_all();
+        }
+    }
+}
+
+void WriteBehindQueue::waitForWrites(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    writerSleeping = true;
+    auto ready = [this] { return !queue.empty() || stopping; };
+    if (deadline == std::chrono::steady_clock::time_point::max()) {
+        writesQueued.wait(lock, ready);
+    } else {
+        writesQueued.wait_until(lock, deadline, ready);
+    }
+    writerSleeping = false;
+}
+
+} // namespace PerfMgmt
@@ -1,11 +1,73 @@
 #include "test.hpp"
 #include <DatabaseManager.hpp>
 #include <Models.hpp>
+#include <RestServer.hpp>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 
-int main() {
+namespace {
+
+// --serve [port] [database] : serve the database over the REST API until killed
+int serve(int argc, char** argv) {
+    PerfMgmt::RestServerConfig config;
+    std::string dbPath = "databaseExample.db";
+    try {
+        if (argc > 2) {
+            config.port = std::stoi(argv[2]);
+        }
+    } catch (const std::exception&) {
+        std::cerr << "[serve] : " << "invalid port " << argv[2] << std::endl;
+        return 1;
+    }
+    if (argc > 3) {
+        dbPath = argv[3];
+    }
+
+    // one reader connection per worker, so concurrent reads never queue for a connection
+    PerfMgmt::PoolConfig poolConfig;
+    poolConfig.readerCount = config.workerCount;
+    poolConfig.walMode = true;
+    PerfMgmt::DatabaseManager db(dbPath, poolConfig);
+    if (!db.InitializeDatabase()) {
+        return 1;
+    }
+    // concurrent review submissions share group commits
+    db.enableWriteBehind();
+
+    PerfMgmt::RestServer server(db, config);
+    if (!server.bind()) {
+        return 1;
+    }
+    std::cout << "Serving " << dbPath << " on http://" << config.host << ":" << server.port() << " with "
+              << config.workerCount << " workers" << std::endl;
+    return server.listen() ? 0 : 1;
+}
+
+// --stress : multi-threaded checks of the lock-free queues, exit code 1 if one of them fails
+int stress() {
+    bool ok = PerfMgmt::test_MpscQueue();
+    ok = PerfMgmt::test_ChangeFeed() && ok;
+    return ok ? 0 : 1;
+}
+
+// --check : behaviour checks of the sync id handling on an in-memory database, exit code 1 if one fails
+int check() {
+    return PerfMgmt::test_SyncIds() ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        return serve(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--stress") {
+        return stress();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--check") {
+        return check();
+    }
     PerfMgmt::test_App();
 
     return 0;
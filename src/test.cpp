@@ -1,7 +1,16 @@
+#include <ChangeFeed.hpp>
 #include <DatabaseManager.hpp>
 #include <Models.hpp>
+#include <MpscQueue.hpp>
 #include <NetworkManager.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace PerfMgmt {
 
@@ -53,4 +62,184 @@ void test_App() {
     networkManager.fetchAllEmployees();
 }
 
-} // namespace PerfMgmt
\ No newline at end of file
+bool test_MpscQueue() {
+    constexpr std::uint32_t PRODUCERS = 8;
+    constexpr std::uint32_t ITEMS_PER_PRODUCER = 250000;
+    // an item is its producer in the high half and its position in that producer's pushes in the low half
+    MpscQueue<std::uint64_t> queue;
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    for (std::uint32_t producer = 0; producer < PRODUCERS; ++producer) {
+        producers.emplace_back([&queue, &start, producer] {
+            while (!start.load(std::memory_order_acquire)) {
+            }
+            for (std::uint32_t i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                queue.push(static_cast<std::uint64_t>(producer) << 32 | i);
+            }
+        });
+    }
+    start.store(true, std::memory_order_release);
+
+    // each producer's items have to come out as 0, 1, 2, ...: a gap is a lost item, a repeat a duplicate and
+    // a step back a reordering
+    std::vector<std::uint32_t> expected(PRODUCERS, 0);
+    std::uint64_t received{0};
+    bool ok{true};
+    while (ok && received < std::uint64_t{PRODUCERS} * ITEMS_PER_PRODUCER) {
+        auto item = queue.pop();
+        if (!item) {
+            std::this_thread::yield();
+            continue;
+        }
+        auto producer = static_cast<std::uint32_t>(*item >> 32);
+        auto position = static_cast<std::uint32_t>(*item);
+        if (producer >= PRODUCERS || position != expected[producer]) {
+            std::cerr << "[test_MpscQueue] : " << "producer " << producer << " item " << position << " arrived, "
+                      << "expected " << (producer < PRODUCERS ? expected[producer] : 0) << std::endl;
+            ok = false;
+            break;
+        }
+        ++expected[producer];
+        ++received;
+    }
+    for (auto& thread : producers) {
+        thread.join();
+    }
+    if (ok && (queue.pop() || !queue.empty())) {
+        std::cerr << "[test_MpscQueue] : " << "items left over after every push arrived" << std::endl;
+        ok = false;
+    }
+    std::cout << "MpscQueue: " << received << " items from " << PRODUCERS << " producers, "
+              << (ok ? "passed" : "FAILED") << std::endl;
+    return ok;
+}
+
+bool test_ChangeFeed() {
+    constexpr std::uint64_t EVENTS = 2000000;
+    constexpr std::size_t READERS = 4;
+    // every field is derived from the sequence, so a copy mixing two events cannot pass for either
+    auto employeeOf = [](std::uint64_t sequence) { return static_cast<int>(sequence); };
+    auto reviewOf = [](std::uint64_t sequence) { return static_cast<int>(sequence * 7 + 3); };
+    auto kindOf = [](std::uint64_t sequence) { return static_cast<ChangeKind>(sequence % 6); };
+    // a tiny ring, and readers that keep pausing, so the writer laps them all the time
+    ChangeFeed feed(16);
+    std::atomic<bool> ok{true};
+    std::atomic<std::uint64_t> missed{0};
+    std::vector<std::thread> readers;
+    for (std::size_t reader = 0; reader < READERS; ++reader) {
+        readers.emplace_back([&] {
+            auto subscription = feed.subscribeFrom(1);
+            std::uint64_t expected{1};
+            std::uint64_t missedBefore{0};
+            std::uint64_t delivered{0};
+            while (subscription.nextSequence() <= EVENTS && ok.load(std::memory_order_relaxed)) {
+                auto event = subscription.next();
+                if (!event) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // events come in order, and a jump has to be exactly the events reported as missed
+                std::uint64_t sequence = event->sequence;
+                bool whole = event->employeeId == employeeOf(sequence) && event->reviewId == reviewOf(sequence) &&
+                             event->kind == kindOf(sequence);
+                if (!whole || sequence != expected + (subscription.missed() - missedBefore)) {
+                    std::cerr << "[test_ChangeFeed] : " << "event " << sequence << (whole ? " out of order" : " torn")
+                              << std::endl;
+                    ok = false;
+                }
+                expected = sequence + 1;
+                missedBefore = subscription.missed();
+                if (++delivered % 256 == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+            if (ok && delivered + subscription.missed() != EVENTS) {
+                std::cerr << "[test_ChangeFeed] : " << delivered << " events read and " << subscription.missed()
+                          << " missed out of " << EVENTS << std::endl;
+                ok = false;
+            }
+            missed += subscription.missed();
+        });
+    }
+    // the writer steps aside now and then, so the readers run while it is still publishing even on one core
+    for (std::uint64_t sequence = 1; sequence <= EVENTS; ++sequence) {
+        feed.publish(kindOf(sequence), employeeOf(sequence), reviewOf(sequence));
+        if (sequence % 1024 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& thread : readers) {
+        thread.join();
+    }
+    if (ok && missed == 0) {
+        std::cerr << "[test_ChangeFeed] : " << "the writer never lapped a reader" << std::endl;
+        ok = false;
+    }
+    std::cout << "ChangeFeed: " << EVENTS << " events to " << READERS << " lapped readers, " << missed
+              << " missed, " << (ok ? "passed" : "FAILED") << std::endl;
+    return ok;
+}
+
+bool test_SyncIds() {
+    DatabaseManager db(":memory:");
+    db.enableOrgChartIndex();
+    bool ok{true};
+    auto check = [&ok](bool passed, const char* what) {
+        if (!passed) {
+            std::cerr << "[test_SyncIds] : " << what << std::endl;
+            ok = false;
+        }
+    };
+    auto employee = [](int id, const char* name, std::optional<int> reportsTo) {
+        return Employee(id, 100 + id, name, "2020-01-01", Role::SPECIALIST, true, reportsTo);
+    };
+    auto nameOf = [&db](int id) {
+        auto found = db.getEmployee(id);
+        return found ? found->name : std::string();
+    };
+    auto dirtyIds = [](const auto& rows) {
+        std::vector<int> ids;
+        for (const auto& dirty : *rows) {
+            ids.push_back(dirty.row.employeeId);
+        }
+        return ids;
+    };
+
+    // the server's org, then two employees and a review created offline on top of it
+    db.applyRemoteEmployees({employee(1, "Alice", std::nullopt), employee(2, "Bob", 1), employee(3, "Carl", 2)});
+    db.addEmployee(employee(4, "Dora", 1));
+    db.addEmployee(employee(5, "Eve", 4));
+    db.addPerformanceReview(PerformanceReview(0, 5, 4, "2025-02-01", 4.0f, 1, 2, 3, 4, 5, 1, 2, 3, 4, 5, "solid"));
+    // Eve reports to unpushed Dora and the review names both, so only Dora can be pushed yet
+    check(dirtyIds(db.getDirtyEmployees(0, 16)) == std::vector<int>{4}, "rows naming an unpushed employee listed");
+    check(db.getDirtyPerformanceReviews(0, 16)->empty(), "review naming unpushed employees listed");
+
+    // another client's employee 4 arrives: the pulled row takes id 4, Dora moves above every id, Eve follows her
+    db.applyRemoteEmployees({employee(4, "Frank", 1)});
+    check(nameOf(4) == "Frank", "pulled row did not take its id");
+    check(nameOf(6) == "Dora", "local row not moved off the pulled id");
+    check(db.getEmployee(5)->reportsTo == 6, "reference to the moved row not rewritten");
+    check(db.getPerformanceReview(1)->reviewerId == 6, "review of the moved row not rewritten");
+
+    // the server hands Dora Eve's local id and Eve Dora's: the two rows trade places
+    check(db.adoptServerEmployeeIds({{6, 5, 1}, {5, 6, 1}}), "swapping adoption failed");
+    check(nameOf(5) == "Dora" && nameOf(6) == "Eve", "swapped ids not adopted");
+    check(db.getEmployee(6)->reportsTo == 5, "reference not carried through the swap");
+    auto review = db.getPerformanceReview(1);
+    check(review->employeeId == 6 && review->reviewerId == 5, "review not carried through the swap");
+    check(db.orgChartIndex().reportsTransitivelyTo(6, 1), "org chart not carried through the swap");
+    // the rewritten reference turned Eve dirty again, and the review is free to go now
+    auto employees = db.getDirtyEmployees(0, 16);
+    check(dirtyIds(employees) == std::vector<int>{6} && !employees->front().isNew, "rewritten reference not dirty");
+    auto reviews = db.getDirtyPerformanceReviews(0, 16);
+    check(reviews->size() == 1 && reviews->front().isNew, "review still held back after adoption");
+
+    // an id a pushed row holds cannot be adopted, and the failed transaction leaves everything in place
+    check(!db.adoptServerEmployeeIds({{6, 2, 2}}), "adoption onto a pushed row's id succeeded");
+    check(nameOf(2) == "Bob" && nameOf(6) == "Eve", "failed adoption not rolled back");
+
+    std::cout << "SyncIds: " << (ok ? "passed" : "FAILED") << std::endl;
+    return ok;
+}
+
+} // namespace PerfMgmt